@@ -0,0 +1,307 @@
+/***********************************************************************
+ * Header:
+ *    PRIORITY QUEUE
+ * Summary:
+ *    Our custom implementation of std::priority_queue: a binary heap
+ *    laid out in a container, the largest element (by Compare) on top.
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    Sifting moves a hole instead of swapping: the element being placed
+ *    is moved out once, each parent or child it passes is moved into
+ *    the hole, and it is moved into the final hole at the end.  That is
+ *    one move per level instead of the three a swap costs, and no
+ *    copies at all.
+ *
+ *    This will contain the class definition of:
+ *        priority_queue         : A class that represents a Priority Queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <utility>     // for std::move
+#include "vector.h"    // for the default container
+
+class TestPQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * P QUEUE
+ * Create a priority queue.  Container needs
+ * operator[], back, push_back, emplace_back,
+ * pop_back, size and swap.
+ *************************************************/
+template<class T, class Container = custom::vector <T>, class Compare = std::less <T> >
+class priority_queue
+{
+   friend class ::TestPQueue; // give the unit test class access to the privates
+public:
+
+   typedef Container container_type;
+
+   //
+   // Construct
+   //
+
+   priority_queue(const Compare & compare = Compare()) : compare(compare) {}
+   priority_queue(const Compare & compare, const Container &  rhs);
+   priority_queue(const Compare & compare,       Container && rhs);
+   template <class Iterator>
+   priority_queue(Iterator first, Iterator last, const Compare & compare = Compare());
+
+   //
+   // Assign
+   //
+
+   void swap(priority_queue & rhs)
+   {
+      container.swap(rhs.container);
+      std::swap(compare, rhs.compare);
+   }
+
+   //
+   // Access
+   //
+
+   const T & top() const;
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { emplace(t);            }
+   void push(      T && t) { emplace(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args);
+   template <class Iterator>
+   void push_range(Iterator first, Iterator last);
+
+   //
+   // Remove
+   //
+
+   void pop();
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return container.size();  }
+   bool   empty() const { return container.empty(); }
+
+private:
+
+   void heapify();
+   void siftUp(size_t iHole);
+   void siftDown(size_t iHole, T & value);
+
+   Container container;  // the heap: the children of i are 2i+1 and 2i+2
+   Compare   compare;    // true if the first belongs below the second
+};
+
+/************************************************
+ * P QUEUE :: CONSTRUCT FROM A CONTAINER
+ * Take the elements as they are and build a heap
+ * out of them in place
+ *   INPUT  : compare - how to order the elements
+ *            rhs     - the elements, in any order
+ *   COST   : O(n)
+ ************************************************/
+template <class T, class Container, class Compare>
+priority_queue <T, Container, Compare> :: priority_queue(const Compare & compare, const Container & rhs) :
+   container(rhs), compare(compare)
+{
+   heapify();
+}
+
+template <class T, class Container, class Compare>
+priority_queue <T, Container, Compare> :: priority_queue(const Compare & compare, Container && rhs) :
+   container(std::move(rhs)), compare(compare)
+{
+   heapify();
+}
+
+template <class T, class Container, class Compare>
+template <class Iterator>
+priority_queue <T, Container, Compare> :: priority_queue(Iterator first, Iterator last, const Compare & compare) :
+   compare(compare)
+{
+   for (; first != last; ++first)
+      container.push_back(*first);
+   heapify();
+}
+
+/************************************************
+ * P QUEUE :: TOP
+ * Get the maximum item from the heap: the top item.
+ ************************************************/
+template <class T, class Container, class Compare>
+const T & priority_queue <T, Container, Compare> :: top() const
+{
+   assert(!container.empty());
+   return container[0];
+}
+
+/************************************************
+ * P QUEUE :: EMPLACE
+ * Build a new element at the bottom of the heap
+ * and sift it up to where it belongs.  push is an
+ * emplace of a T.
+ *   INPUT  : args - for the constructor of T
+ *   COST   : O(log n)
+ ************************************************/
+template <class T, class Container, class Compare>
+template <class ... Args>
+void priority_queue <T, Container, Compare> :: emplace(Args && ... args)
+{
+   container.emplace_back(std::forward<Args>(args)...);
+   siftUp(container.size() - 1);
+}
+
+/************************************************
+ * P QUEUE :: PUSH RANGE
+ * Add every element in [first, last).  Sifting each
+ * one up costs up to log n apiece; rebuilding the
+ * whole heap costs about 2n.  Whichever is cheaper
+ * for this many new elements is done.
+ *   INPUT  : first, last - the elements to add
+ *   COST   : O(min(k log n, n)) for k new elements
+ ************************************************/
+template <class T, class Container, class Compare>
+template <class Iterator>
+void priority_queue <T, Container, Compare> :: push_range(Iterator first, Iterator last)
+{
+   size_t numOld = container.size();
+   for (; first != last; ++first)
+      container.push_back(*first);
+   size_t numNew = container.size() - numOld;
+
+   size_t log2 = 0;
+   for (size_t n = container.size(); n > 1; n /= 2)
+      log2++;
+
+   if (numNew * log2 > 2 * container.size())
+      heapify();
+   else
+      for (size_t i = numOld; i < container.size(); i++)
+         siftUp(i);
+}
+
+/************************************************
+ * P QUEUE :: POP
+ * Delete the top item from the heap.  The last
+ * element is moved out, and the hole left at the
+ * top is sifted down until it fits.
+ *   COST   : O(log n)
+ ************************************************/
+template <class T, class Container, class Compare>
+void priority_queue <T, Container, Compare> :: pop()
+{
+   if (container.empty())
+      return;
+
+   T value(std::move(container.back()));
+   container.pop_back();
+   if (!container.empty())
+      siftDown(0, value);
+}
+
+/************************************************
+ * P QUEUE :: HEAPIFY
+ * Bottom-up construction: sift down every parent,
+ * last one first.  Most of the nodes are near the
+ * bottom and have little distance to go.
+ *   COST   : O(n)
+ ************************************************/
+template <class T, class Container, class Compare>
+void priority_queue <T, Container, Compare> :: heapify()
+{
+   for (size_t i = container.size() / 2; i-- > 0; )
+   {
+      // a parent already at least as big as its children stays put
+      size_t iChild = 2 * i + 1;
+      if (iChild + 1 < container.size() && compare(container[iChild], container[iChild + 1]))
+         iChild++;
+      if (!compare(container[i], container[iChild]))
+         continue;
+
+      T value(std::move(container[i]));
+      siftDown(i, value);
+   }
+}
+
+/************************************************
+ * P QUEUE :: SIFT UP
+ * The element at iHole may be bigger than its
+ * parent.  Move it out, pull each smaller parent
+ * down into the hole, and move it into the hole
+ * where it stops.
+ *   INPUT  : iHole - the element to sift up
+ ************************************************/
+template <class T, class Container, class Compare>
+void priority_queue <T, Container, Compare> :: siftUp(size_t iHole)
+{
+   if (iHole == 0 || !compare(container[(iHole - 1) / 2], container[iHole]))
+      return;
+
+   T value(std::move(container[iHole]));
+   while (iHole > 0)
+   {
+      size_t iParent = (iHole - 1) / 2;
+      if (!compare(container[iParent], value))
+         break;
+      container[iHole] = std::move(container[iParent]);
+      iHole = iParent;
+   }
+   container[iHole] = std::move(value);
+}
+
+/************************************************
+ * P QUEUE :: SIFT DOWN
+ * Place value in the heap starting from the hole
+ * at iHole: while the bigger child is bigger than
+ * value, move the child up into the hole.
+ *   INPUT  : iHole - an element with nothing in it
+ *            value - what goes in it, not in the
+ *                    container; moved from
+ ************************************************/
+template <class T, class Container, class Compare>
+void priority_queue <T, Container, Compare> :: siftDown(size_t iHole, T & value)
+{
+   size_t num = container.size();
+   for (size_t iChild = 2 * iHole + 1; iChild < num; iChild = 2 * iHole + 1)
+   {
+      if (iChild + 1 < num && compare(container[iChild], container[iChild + 1]))
+         iChild++;
+      if (!compare(value, container[iChild]))
+         break;
+      container[iHole] = std::move(container[iChild]);
+      iHole = iChild;
+   }
+   container[iHole] = std::move(value);
+}
+
+/************************************************
+ * SWAP
+ * Swap the contents of two priority queues
+ ************************************************/
+template <class T, class Container, class Compare>
+inline void swap(priority_queue <T, Container, Compare> & lhs,
+                 priority_queue <T, Container, Compare> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
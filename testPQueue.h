@@ -0,0 +1,298 @@
+/***********************************************************************
+ * Header:
+ *    TEST PQUEUE
+ * Summary:
+ *    Unit tests for priority queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "pqueue.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <functional>
+
+class TestPQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_fromVector();
+      test_construct_linear();
+      test_construct_range();
+
+      // Insert
+      test_push_siftMoves();
+      test_emplace_noCopy();
+      test_pushRange_few();
+      test_pushRange_many();
+
+      // Remove
+      test_pop_empty();
+      test_pop_siftMoves();
+      test_pop_order();
+
+      // Compare
+      test_compare_greater();
+
+      report("PQueue");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing in the heap, nothing allocated
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::priority_queue <Spy> pq;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(pq.empty());
+      assertUnit(pq.size() == 0);
+      assertUnit(pq.container.capacity() == 0);
+   }  // teardown
+
+   // a vector in any order becomes a heap
+   void test_construct_fromVector()
+   {  // setup
+      custom::vector <int> v;
+      int rg[] = { 26, 49, 3, 67, 89, 11, 31, 5 };
+      for (int value : rg)
+         v.push_back(value);
+      // exercise
+      custom::priority_queue <int> pq(std::less <int>(), std::move(v));
+      // verify
+      assertUnit(pq.size() == 8);
+      assertUnit(pq.top() == 89);
+      assertUnit(isHeap(pq));
+      assertUnit(v.empty());
+   }  // teardown
+
+   // building bottom-up takes a linear number of compares and no copies
+   void test_construct_linear()
+   {  // setup
+      const int NUM = 1023;
+      custom::vector <Spy> v;
+      v.reserve(NUM);
+      for (int i = 0; i < NUM; i++)
+         v.push_back(Spy(i));    // ascending: every parent has to move
+      Spy::reset();
+      // exercise
+      custom::priority_queue <Spy> pq(std::less <Spy>(), std::move(v));
+      // verify
+      assertUnit(Spy::numLessthan() <= 4 * NUM);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pq.top() == Spy(NUM - 1));
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   // the elements of a range become a heap
+   void test_construct_range()
+   {  // setup
+      int rg[] = { 26, 49, 3, 67, 89, 11, 31, 5 };
+      // exercise
+      custom::priority_queue <int> pq(rg, rg + 8);
+      // verify
+      assertUnit(pq.size() == 8);
+      assertUnit(pq.top() == 89);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // a new maximum rises to the top by moves, one per level
+   void test_push_siftMoves()
+   {  // setup
+      //                7
+      //          4           6
+      //       1     3     2     5
+      custom::priority_queue <Spy> pq;
+      for (int i = 1; i <= 7; i++)
+         pq.push(Spy(i));
+      assertUnit(pq.container.capacity() == 8);
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      pq.push(std::move(s));
+      // verify
+      //                99
+      //          7           6
+      //       4     3     2     5
+      //     1
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numCopyMove() == 2);    // into the container, out to sift
+      assertUnit(Spy::numAssignMove() == 4);  // three parents down, 99 into the top
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pq.top() == Spy(99));
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   // emplace builds the element in the heap
+   void test_emplace_noCopy()
+   {  // setup
+      custom::priority_queue <Spy> pq;
+      pq.container.reserve(4);
+      Spy::reset();
+      // exercise
+      pq.emplace(26);
+      pq.emplace(49);
+      // verify
+      assertUnit(Spy::numNondefault() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(pq.top() == Spy(49));
+   }  // teardown
+
+   // a few new elements are sifted up one at a time
+   void test_pushRange_few()
+   {  // setup
+      custom::priority_queue <int> pq;
+      for (int i = 0; i < 100; i++)
+         pq.push(i * 7 % 100);
+      int rg[] = { 150, -5, 42 };
+      // exercise
+      pq.push_range(rg, rg + 3);
+      // verify
+      assertUnit(pq.size() == 103);
+      assertUnit(pq.top() == 150);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   // many new elements are added with one rebuild
+   void test_pushRange_many()
+   {  // setup
+      custom::priority_queue <int> pq;
+      pq.push(26);
+      pq.push(49);
+      int rg[100];
+      for (int i = 0; i < 100; i++)
+         rg[i] = i * 37 % 100;
+      // exercise
+      pq.push_range(rg, rg + 100);
+      // verify
+      assertUnit(pq.size() == 102);
+      assertUnit(pq.top() == 99);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping an empty heap does nothing
+   void test_pop_empty()
+   {  // setup
+      custom::priority_queue <Spy> pq;
+      Spy::reset();
+      // exercise
+      pq.pop();
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(Spy::numDestructor() == 0);
+   }  // teardown
+
+   // the hole at the top sinks by moves, not copies or swaps
+   void test_pop_siftMoves()
+   {  // setup
+      //                7
+      //          4           6
+      //       1     3     2     5
+      custom::priority_queue <Spy> pq;
+      for (int i = 1; i <= 7; i++)
+         pq.push(Spy(i));
+      Spy::reset();
+      // exercise
+      pq.pop();
+      // verify
+      //                6
+      //          4           5
+      //       1     3     2
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numCopyMove() == 1);    // the last one out
+      assertUnit(Spy::numAssignMove() == 2);  // 6 up, 5 into its hole
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pq.size() == 6);
+      assertUnit(pq.top() == Spy(6));
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   // everything comes off largest first
+   void test_pop_order()
+   {  // setup
+      custom::priority_queue <int> pq;
+      unsigned int seed = 4321;
+      for (int i = 0; i < 500; i++)
+      {
+         seed = seed * 1103515245u + 12345u;
+         pq.push((int)((seed >> 8) % 1000));
+      }
+      int numWrong = 0;
+      int previous = pq.top();
+      // exercise
+      while (!pq.empty())
+      {
+         if (pq.top() > previous)
+            numWrong++;
+         previous = pq.top();
+         pq.pop();
+      }
+      // verify
+      assertUnit(numWrong == 0);
+      assertUnit(pq.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * COMPARE
+    ***************************************/
+
+   // std::greater turns it into a min-heap
+   void test_compare_greater()
+   {  // setup
+      custom::priority_queue <int, custom::vector <int>, std::greater <int> > pq;
+      // exercise
+      pq.push(26);
+      pq.push(3);
+      pq.push(49);
+      // verify
+      assertUnit(pq.top() == 3);
+      pq.pop();
+      assertUnit(pq.top() == 26);
+   }  // teardown
+
+   /*************************************************************
+    * IS HEAP
+    * No element is below its parent
+    *************************************************************/
+   template <class T, class Container, class Compare>
+   static bool isHeap(const custom::priority_queue <T, Container, Compare> & pq)
+   {
+      for (size_t i = 1; i < pq.container.size(); i++)
+         if (pq.compare(pq.container[(i - 1) / 2], pq.container[i]))
+            return false;
+      return true;
+   }
+};
+
+#endif // DEBUG
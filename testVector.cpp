@@ -13,6 +13,7 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testVector.h"     // for the vector unit tests
+#include "testPQueue.h"     // for the priority queue unit tests
 #include "testSpy.h"        // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -27,6 +28,7 @@ int main()
    // unit tests
    TestSpy().run();
    TestVector().run();
+   TestPQueue().run();
 #endif // DEBUG
    
    return 0;
@@ -11,6 +11,9 @@
  *     _| |_  |  `--'  | |  `--'  |  / / (_)
  *    |_____|  '.____.'   '.____.'  /_/
  *
+ *    The buffer is raw storage and only the first numElements
+ *    slots hold live objects, so growing never default-constructs
+ *    anything and elements are moved, not copied, into a bigger buffer.
  *
  *    This will contain the class definition of:
  *        vector                 : A class that represents a Vector
@@ -21,9 +24,13 @@
 
 #pragma once
 
-#include <cassert>  // because I am paranoid
-#include <new>      // std::bad_alloc
-#include <memory>   // for std::allocator
+#include <cassert>           // because I am paranoid
+#include <cstddef>           // for size_t
+#include <initializer_list>  // for std::initializer_list
+#include <iterator>          // for std::bidirectional_iterator_tag
+#include <new>               // std::bad_alloc
+#include <memory>            // for std::allocator
+#include <utility>           // for std::move
 
 class TestVector; // forward declaration for unit tests
 class TestStack;
@@ -45,13 +52,13 @@ class vector
    friend class ::TestPQueue;
    friend class ::TestHash;
 public:
-   
-   // 
+
+   //
    // Construct
    //
 
-    vector();
-    vector(size_t numElements);
+   vector();
+   vector(size_t numElements                );
    vector(size_t numElements, const T & t   );
    vector(const std::initializer_list<T>& l );
    vector(const vector &  rhs);
@@ -64,28 +71,20 @@ public:
 
    void swap(vector& rhs)
    {
-       T* tempData = rhs.data;
-       rhs.data = data;
-       data = tempData;
-
-       unsigned int tempElements = rhs.numElements;
-       rhs.numElements = numElements;
-       numElements = tempElements;
-
-       unsigned int tempCapacity = rhs.numCapacity;
-       rhs.numCapacity = numCapacity;
-       numCapacity = tempCapacity;
+      std::swap(data,        rhs.data);
+      std::swap(numCapacity, rhs.numCapacity);
+      std::swap(numElements, rhs.numElements);
    }
    vector & operator = (const vector & rhs);
-   vector& operator = (vector&& rhs);
+   vector & operator = (vector&& rhs);
 
    //
    // Iterator
    //
 
    class iterator;
-   iterator       begin() { return data; }
-   iterator       end() { return &data[numElements]; }
+   iterator       begin() { return iterator(data);               }
+   iterator       end()   { return iterator(data + numElements); }
 
    //
    // Access
@@ -102,8 +101,10 @@ public:
    // Insert
    //
 
-   void push_back(const T& t);
-   void push_back(T&& t);
+   void push_back(const T& t) { emplace_back(t);            }
+   void push_back(T&& t)      { emplace_back(std::move(t)); }
+   template <class ... Args>
+   void emplace_back(Args && ... args);
    void reserve(size_t newCapacity);
    void resize(size_t newElements);
    void resize(size_t newElements, const T& t);
@@ -114,14 +115,13 @@ public:
 
    void clear()
    {
-       delete[] data;
-       numElements = 0;
-       
+      destroy(0, numElements);
+      numElements = 0;
    }
    void pop_back()
    {
-       if (numElements!=0)
-       numElements -= 1;
+      if (numElements > 0)
+         data[--numElements].~T();
    }
    void shrink_to_fit();
 
@@ -129,16 +129,22 @@ public:
    // Status
    //
 
-   size_t  size()          const { return numElements;}
-   size_t  capacity()      const { return numCapacity;}
-   bool empty()            const { return (numElements == 0); }
-   
-   // adjust the size of the buffer
-   
-   // vector-specific interfaces
-   
+   size_t  size()          const { return numElements;       }
+   size_t  capacity()      const { return numCapacity;       }
+   bool empty()            const { return numElements == 0;  }
+
 private:
-   
+
+   // raw storage from operator new[], so a buffer made by new T[]
+   // for a trivial T can be handed to us and freed here
+   static T *  allocate(size_t num)          { return num == 0 ? nullptr : static_cast<T *>(::operator new[](num * sizeof(T))); }
+   static void deallocate(T * p, size_t)     { ::operator delete[](static_cast<void *>(p));                                  }
+   void        destroy(size_t iBegin, size_t iEnd)
+   {
+      for (size_t i = iBegin; i < iEnd; i++)
+         data[i].~T();
+   }
+
    T *  data;                 // user data, a dynamically-allocated array
    size_t  numCapacity;       // the capacity of the array
    size_t  numElements;       // the number of items currently used
@@ -163,14 +169,20 @@ class vector <T> ::iterator
    friend class ::TestPQueue;
    friend class ::TestHash;
 public:
+   typedef std::bidirectional_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef T *                             pointer;
+   typedef T &                             reference;
+
    // constructors, destructors, and assignment operator
-   iterator()                           { this->p = nullptr; }
-   iterator(T* p)                       { this->p = p; }
-   iterator(const iterator& rhs)        { this->p = rhs.p; }
-   iterator(size_t index, vector<T>& v) { this->p = (v.data+index); } //assignment operator taking the location of the element to be refrenced's index? double check this
+   iterator()                           : p(nullptr)        {}
+   iterator(T* p)                       : p(p)              {}
+   iterator(const iterator& rhs)        : p(rhs.p)          {}
+   iterator(size_t index, vector<T>& v) : p(v.data + index) {}
    iterator& operator = (const iterator& rhs)
    {
-      this->p = rhs.p;          //assign the value of the itterator to be the given itterator
+      this->p = rhs.p;
       return *this;
    }
 
@@ -181,40 +193,37 @@ public:
    // dereference operator
    T& operator * ()
    {
-       
       return *p;
    }
 
    // prefix increment
    iterator& operator ++ ()
    {
-       p++;
+      p++;
       return *this;
    }
 
    // postfix increment
    iterator operator ++ (int postfix)
    {
-       iterator returnCopy(this); //create a copy of the iterator
-       p++; //increment the current pointer (but not the copied one)
-        return returnCopy; //return the copy made before iterating
-        //idk if this is the most elegant solution, if you find a better one feel free to use it.
+      iterator itReturn(*this);
+      p++;
+      return itReturn;
    }
 
    // prefix decrement
    iterator& operator -- ()
    {
-       p--;
+      p--;
       return *this;
    }
 
    // postfix decrement
    iterator operator -- (int postfix)
    {
-       iterator returnCopy(this); //create a copy of the iterator
-       p--; //increment the current pointer (but not the copied one)
-       return returnCopy; //return the copy made before iterating
-       //idk if this is the most elegant solution, if you find a better one feel free to use it.
+      iterator itReturn(*this);
+      p--;
+      return itReturn;
    }
 
 private:
@@ -223,15 +232,11 @@ private:
 
 /*****************************************
  * VECTOR :: DEFAULT constructors
- * Default constructor: set the number of elements,
- * construct each element, and copy the values over
+ * Default constructor: allocates no memory
  ****************************************/
 template <typename T>
-vector <T> :: vector() //deafult constructor allocates no memory unless given parameters
+vector <T> :: vector() : data(nullptr), numCapacity(0), numElements(0)
 {
-   data = nullptr;
-   numCapacity = 0;
-   numElements = 0;
 }
 
 /*****************************************
@@ -240,12 +245,11 @@ vector <T> :: vector() //deafult constructor allocates no memory unless given pa
  * construct each element, and copy the values over
  ****************************************/
 template <typename T>
-vector <T> :: vector(size_t num, const T & t) 
+vector <T> :: vector(size_t num, const T & t) :
+   data(allocate(num)), numCapacity(num), numElements(0)
 {
-   data = new T[num];
-   std::fill(data, data + num, t); //copy the element given into the arrays new locations
-   numCapacity = num;
-   numElements = num;
+   for (; numElements < num; numElements++)
+      new ((void *)(data + numElements)) T(t);
 }
 
 /*****************************************
@@ -253,37 +257,24 @@ vector <T> :: vector(size_t num, const T & t)
  * Create a vector with an initialization list.
  ****************************************/
 template <typename T>
-vector <T> :: vector(const std::initializer_list<T> & l) 
+vector <T> :: vector(const std::initializer_list<T> & l) :
+   data(allocate(l.size())), numCapacity(l.size()), numElements(0)
 {
-    data = new T[l.size()]; //initialize an array the size of the elements given
-    data[1] = 2;
-    numCapacity = l.size();
-    numElements = l.size();
-    for (int i = 0; i < l.size(); i++) {   //fill the array with the given elements
-        data[i] = *(l.begin()+i);
-   }
- 
+   for (const T * p = l.begin(); p != l.end(); p++)
+      new ((void *)(data + numElements++)) T(*p);
 }
 
 /*****************************************
  * VECTOR :: NON-DEFAULT constructors
  * non-default constructor: set the number of elements,
- * construct each element, and copy the values over
+ * construct each element with its default constructor
  ****************************************/
 template <typename T>
-vector <T> :: vector(size_t num) 
+vector <T> :: vector(size_t num) :
+   data(allocate(num)), numCapacity(num), numElements(0)
 {
-    if (num != 0) {
-        data = new T[num];
-        for (int i = 0; i < num; i++) { //constructing each element
-            data[i] = T();
-        }
-    }
-    else {
-        data = nullptr;
-    }
-   numCapacity = num;
-   numElements = num;
+   for (; numElements < num; numElements++)
+      new ((void *)(data + numElements)) T();
 }
 
 /*****************************************
@@ -292,13 +283,11 @@ vector <T> :: vector(size_t num)
  * call the copy constructor on each element
  ****************************************/
 template <typename T>
-vector <T> :: vector (const vector & rhs) 
+vector <T> :: vector (const vector & rhs) :
+   data(allocate(rhs.numElements)), numCapacity(rhs.numElements), numElements(0)
 {
-    data = nullptr;
-    numElements = 0;
-    numCapacity = 0;
-    *this = rhs;
-     //simply copy all values into this structure, including capacity and elements
+   for (; numElements < rhs.numElements; numElements++)
+      new ((void *)(data + numElements)) T(rhs.data[numElements]);
 }
 
 /*****************************************
@@ -306,17 +295,12 @@ vector <T> :: vector (const vector & rhs)
  * Steal the values from the RHS and set it to zero.
  ****************************************/
 template <typename T>
-vector <T> :: vector (vector && rhs)
+vector <T> :: vector (vector && rhs) :
+   data(rhs.data), numCapacity(rhs.numCapacity), numElements(rhs.numElements)
 {
-    data = rhs.data;
-    rhs.data = nullptr;
-
-    numElements = rhs.numElements;
-    rhs.numElements = 0;
-
-    numCapacity = rhs.numCapacity;
-    rhs.numCapacity = 0;
-
+   rhs.data = nullptr;
+   rhs.numCapacity = 0;
+   rhs.numElements = 0;
 }
 
 /*****************************************
@@ -327,9 +311,8 @@ vector <T> :: vector (vector && rhs)
 template <typename T>
 vector <T> :: ~vector()
 {
-
-    delete[] data;
-    data = nullptr;
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
 }
 
 /***************************************
@@ -342,41 +325,35 @@ vector <T> :: ~vector()
 template <typename T>
 void vector <T> :: resize(size_t newElements)
 {
-    if (newElements > numElements) { //if were adding elements
-        reserve(newElements);
-        for (int i = numElements; i < newElements; i++) {
-            data[i] = T();
-            
-       }
-  }
-    else if (newElements < numElements) {
-        
-    }
-
-    numElements=newElements;
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         new ((void *)(data + i)) T();
+   }
+   numElements = newElements;
 }
 
 template <typename T>
 void vector <T> :: resize(size_t newElements, const T & t)
 {
-    if (newElements > numElements) { //if were adding elements
-        reserve(newElements);
-        for (int i = numElements; i < newElements; i++) {
-            data[i] = T(t);
-
-        }
-    }
-    else if (newElements < numElements) {
-
-    }
-
-    numElements = newElements;
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         new ((void *)(data + i)) T(t);
+   }
+   numElements = newElements;
 }
 
 /***************************************
  * VECTOR :: RESERVE
  * This method will grow the current buffer
- * to newCapacity.  It will also copy all
+ * to newCapacity.  It will also move all
  * the data from the old buffer into the new
  *     INPUT  : newCapacity the size of the new buffer
  *     OUTPUT :
@@ -384,18 +361,17 @@ void vector <T> :: resize(size_t newElements, const T & t)
 template <typename T>
 void vector <T> :: reserve(size_t newCapacity)
 {
-    //only reserve space if were reserving more space.
-    if (newCapacity > numCapacity) {
-        
-        T* oldBuffer = data;
-        T* newBuffer = new T[newCapacity];
-        for (int i = 0; i < numElements; i++) {
-            newBuffer[i] = data[i];
-        }
-        data = newBuffer;
-
-        numCapacity = newCapacity;
-    }
+   if (newCapacity <= numCapacity)
+      return;
+
+   T * dataNew = allocate(newCapacity);
+   for (size_t i = 0; i < numElements; i++)
+      new ((void *)(dataNew + i)) T(std::move(data[i]));
+
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = newCapacity;
 }
 
 /***************************************
@@ -407,14 +383,18 @@ void vector <T> :: reserve(size_t newCapacity)
 template <typename T>
 void vector <T> :: shrink_to_fit()
 {
-    if (numElements == 0) {
-        data = nullptr;
-    }
-    numCapacity = numElements;
-   
-}
+   if (numElements == numCapacity)
+      return;
 
+   T * dataNew = allocate(numElements);
+   for (size_t i = 0; i < numElements; i++)
+      new ((void *)(dataNew + i)) T(std::move(data[i]));
 
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = numElements;
+}
 
 /*****************************************
  * VECTOR :: SUBSCRIPT
@@ -423,8 +403,8 @@ void vector <T> :: shrink_to_fit()
 template <typename T>
 T & vector <T> :: operator [] (size_t index)
 {
+   assert(index < numElements);
    return data[index];
-   
 }
 
 /******************************************
@@ -434,13 +414,8 @@ T & vector <T> :: operator [] (size_t index)
 template <typename T>
 const T & vector <T> :: operator [] (size_t index) const
 {
-    if (index < numCapacity) {
-
-
-        return data[index];
-    }
-   
-   
+   assert(index < numElements);
+   return data[index];
 }
 
 /*****************************************
@@ -450,8 +425,8 @@ const T & vector <T> :: operator [] (size_t index) const
 template <typename T>
 T & vector <T> :: front ()
 {
-   
-   return *data;
+   assert(numElements > 0);
+   return data[0];
 }
 
 /******************************************
@@ -461,109 +436,137 @@ T & vector <T> :: front ()
 template <typename T>
 const T & vector <T> :: front () const
 {
-    return *data;
+   assert(numElements > 0);
+   return data[0];
 }
 
 /*****************************************
- * VECTOR :: FRONT
+ * VECTOR :: BACK
  * Read-Write access
  ****************************************/
 template <typename T>
 T & vector <T> :: back()
 {
-   return *(&data[numElements-1]);
+   assert(numElements > 0);
+   return data[numElements - 1];
 }
 
 /******************************************
- * VECTOR :: FRONT
+ * VECTOR :: BACK
  * Read-Write access
  *****************************************/
 template <typename T>
 const T & vector <T> :: back() const
 {
-    return data[numElements-1];
+   assert(numElements > 0);
+   return data[numElements - 1];
 }
 
 /***************************************
- * VECTOR :: PUSH BACK
- * This method will add the element 't' to the
- * end of the current buffer.  It will also grow
- * the buffer as needed to accomodate the new element
- *     INPUT  : 't' the new element to be added
+ * VECTOR :: EMPLACE BACK
+ * This method will construct a new element at the
+ * end of the current buffer from args.  It will also
+ * double the buffer as needed to accomodate it.
+ * push_back is an emplace_back of a T.
+ *     INPUT  : args for the constructor of T
  *     OUTPUT : *this
  **************************************/
 template <typename T>
-void vector <T> :: push_back (const T & t)
+template <class ... Args>
+void vector <T> :: emplace_back(Args && ... args)
 {
-    if (numCapacity < numElements + 1) { //add more capacity if needed
-        if (numCapacity == 0) {
-            reserve(1);
-        }
-        else
-            reserve(numElements * 2);
-    }
-    numElements++;
-    
-    data[numElements-1] = t;
-
-   
-}
+   if (numElements < numCapacity)
+   {
+      new ((void *)(data + numElements)) T(std::forward<Args>(args)...);
+      numElements++;
+      return;
+   }
 
-template <typename T>
-void vector <T> ::push_back(T && t)
-{
-    if (numCapacity < numElements + 1) { //add more capacity if needed
-        if (numCapacity == 0) {
-            reserve(1);
-        }
-        else
-        reserve(numElements*2);
-    }
-    numElements++;
-    data[numElements-1] = t;
-   
+   // build the new element before moving the old ones:
+   // args may refer to something in the old buffer
+   size_t newCapacity = (numCapacity == 0 ? 1 : numCapacity * 2);
+   T * dataNew = allocate(newCapacity);
+   try
+   {
+      new ((void *)(dataNew + numElements)) T(std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      deallocate(dataNew, newCapacity);
+      throw;
+   }
+
+   for (size_t i = 0; i < numElements; i++)
+      new ((void *)(dataNew + i)) T(std::move(data[i]));
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = newCapacity;
+   numElements++;
 }
 
 /***************************************
  * VECTOR :: ASSIGNMENT
  * This operator will copy the contents of the
- * rhs onto *this, growing the buffer as needed
+ * rhs onto *this, growing the buffer as needed.
+ * Elements we already have are assigned over.
  *     INPUT  : rhs the vector to copy from
  *     OUTPUT : *this
  **************************************/
 template <typename T>
 vector <T> & vector <T> :: operator = (const vector & rhs)
 {
-    if(rhs.numElements>numElements)
-        resize(rhs.numElements);
-    for (int i = 0; i < rhs.numElements; i++)
-    {
-        this->data[i] = rhs.data[i];
-    }
-    //cpacity does not change in the typical assignment operator, only elements.
-    numElements = rhs.numElements;
+   if (this == &rhs)
+      return *this;
+
+   // not enough room: start over with a buffer of exactly the right size
+   if (rhs.numElements > numCapacity)
+   {
+      T * dataNew = allocate(rhs.numElements);
+      for (size_t i = 0; i < rhs.numElements; i++)
+         new ((void *)(dataNew + i)) T(rhs.data[i]);
+
+      destroy(0, numElements);
+      deallocate(data, numCapacity);
+      data = dataNew;
+      numCapacity = rhs.numElements;
+      numElements = rhs.numElements;
+      return *this;
+   }
+
+   // enough room: assign over what we have, construct or destroy the rest
+   size_t numCommon = rhs.numElements < numElements ? rhs.numElements : numElements;
+   for (size_t i = 0; i < numCommon; i++)
+      data[i] = rhs.data[i];
+   for (size_t i = numCommon; i < rhs.numElements; i++)
+      new ((void *)(data + i)) T(rhs.data[i]);
+   destroy(rhs.numElements, numElements);
+   numElements = rhs.numElements;
    return *this;
 }
+
+/***************************************
+ * VECTOR :: MOVE ASSIGNMENT
+ * Free what we have and take rhs's buffer, leaving
+ * rhs empty with no buffer at all
+ *     INPUT  : rhs the vector to move from
+ *     OUTPUT : *this
+ **************************************/
 template <typename T>
 vector <T>& vector <T> :: operator = (vector&& rhs)
 {
-    for (int i = 0; i < rhs.numElements; i++)
-    {
-        data[i] = rhs.data[i];
-    }
-    numCapacity = rhs.numCapacity;
-    numElements = rhs.numElements;
-
-
-    //since were taking this from a move operator, we destroy the previous information
-    rhs.data = nullptr;
-    rhs.numCapacity = 0;
-    rhs.numElements = 0;
-    return *this;
-}
-
-
+   if (this == &rhs)
+      return *this;
 
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data        = rhs.data;
+   numCapacity = rhs.numCapacity;
+   numElements = rhs.numElements;
+   rhs.data        = nullptr;
+   rhs.numCapacity = 0;
+   rhs.numElements = 0;
+   return *this;
+}
 
 } // namespace custom
-
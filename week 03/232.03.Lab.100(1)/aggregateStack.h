@@ -0,0 +1,247 @@
+/***********************************************************************
+ * Module:
+ *    Aggregate Stack
+ * Summary:
+ *    A stack that can report Op over everything in it (the minimum, the
+ *    maximum, the sum, ...) in O(1).  Next to each value it keeps the
+ *    aggregate of that value and everything beneath it, so the top entry
+ *    always holds the answer and popping just exposes the old one.  Op
+ *    only has to be associative.
+ *
+ *    Two of these make a queue with the same O(1) query, amortized: new
+ *    values go on a back stack, and when the front stack runs dry the
+ *    back one is poured into it.  That is the usual sliding window.
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       aggregate_stack   : a stack that knows Op of its contents
+ *       aggregate_queue   : a queue that knows Op of its contents
+ *       aggregate_min, aggregate_max, aggregate_gcd : common choices of Op
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
+#include <numeric>  // for std::gcd
+#include <utility>  // for std::move
+#include "vector.h" // for the entries
+
+class TestAggregateStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * AGGREGATE OPS
+ * Any associative function object works; these are
+ * the ones without a ready-made std:: version.  For
+ * a sum use std::plus <T>.
+ *************************************************/
+template <class T>
+struct aggregate_min
+{
+   T operator () (const T & lhs, const T & rhs) const { return rhs < lhs ? rhs : lhs; }
+};
+
+template <class T>
+struct aggregate_max
+{
+   T operator () (const T & lhs, const T & rhs) const { return lhs < rhs ? rhs : lhs; }
+};
+
+template <class T>
+struct aggregate_gcd
+{
+   T operator () (const T & lhs, const T & rhs) const { return std::gcd(lhs, rhs); }
+};
+
+/**************************************************
+ * AGGREGATE STACK
+ * First-in-Last-out, plus top_aggregate() which is
+ * Op over every value from the bottom up
+ *************************************************/
+template <class T, class Op>
+class aggregate_queue;
+
+template <class T, class Op = aggregate_min <T> >
+class aggregate_stack
+{
+   friend class ::TestAggregateStack; // give unit tests access to the privates
+   template <class, class> friend class aggregate_queue;
+public:
+
+   //
+   // Construct
+   //
+
+   aggregate_stack(const Op & op = Op()) : op(op) {}
+
+   //
+   // Access
+   //
+
+   // no write access: changing a value would leave the aggregates above it stale
+   const T & top()           const { return entries.back().value;     }
+   const T & top_aggregate() const { return entries.back().aggregate; }
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { entries.emplace_back(t, combine(t)); }
+   void push(      T && t)
+   {
+      T aggregate = combine(t);
+      entries.emplace_back(std::move(t), std::move(aggregate));
+   }
+
+   //
+   // Remove
+   //
+
+   void pop()   { entries.pop_back(); }
+   void clear() { entries.clear();    }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return entries.size();  }
+   bool   empty() const { return entries.empty(); }
+
+private:
+
+   /*************************************************
+    * ENTRY
+    * A value and Op over it and everything under it,
+    * side by side so a push touches one cache line
+    *************************************************/
+   struct Entry
+   {
+      template <class V, class A>
+      Entry(V && value, A && aggregate) :
+         value(std::forward <V>(value)), aggregate(std::forward <A>(aggregate)) {}
+
+      T value;
+      T aggregate;
+   };
+
+   // Op over t and everything already on the stack
+   T combine(const T & t) const
+   {
+      return entries.empty() ? t : op(entries.back().aggregate, t);
+   }
+
+   custom::vector <Entry> entries;  // bottom first
+   Op                     op;       // how to combine two values
+};
+
+/**************************************************
+ * AGGREGATE QUEUE
+ * First-in-First-out, plus aggregate() which is Op
+ * over every value from the front to the back
+ *************************************************/
+template <class T, class Op = aggregate_min <T> >
+class aggregate_queue
+{
+   friend class ::TestAggregateStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   aggregate_queue(const Op & op = Op()) : op(op), inFront(Flip(op)), inBack(op) {}
+
+   //
+   // Access
+   //
+
+   const T & front()
+   {
+      refill();
+      return inFront.top();
+   }
+   T aggregate() const
+   {
+      assert(!empty());
+      if (inFront.empty())
+         return inBack.top_aggregate();
+      if (inBack.empty())
+         return inFront.top_aggregate();
+      return op(inFront.top_aggregate(), inBack.top_aggregate());
+   }
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { inBack.push(t);            }
+   void push(      T && t) { inBack.push(std::move(t)); }
+
+   //
+   // Remove
+   //
+
+   void pop()
+   {
+      refill();
+      if (!inFront.empty())
+         inFront.pop();
+   }
+   void clear()
+   {
+      inFront.clear();
+      inBack.clear();
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return inFront.size() + inBack.size(); }
+   bool   empty() const { return inFront.empty() && inBack.empty(); }
+
+private:
+
+   /*************************************************
+    * FLIP
+    * The front stack holds the oldest value on top,
+    * so it has to combine from the top down to keep
+    * the values in queue order
+    *************************************************/
+   struct Flip
+   {
+      Flip(const Op & op) : op(op) {}
+      T operator () (const T & below, const T & t) const { return op(t, below); }
+      Op op;
+   };
+
+   // pour the back into the front once the front runs dry
+   void refill()
+   {
+      if (!inFront.empty())
+         return;
+      while (!inBack.empty())
+      {
+         inFront.push(std::move(inBack.entries.back().value));
+         inBack.pop();
+      }
+   }
+
+   Op                        op;        // how to combine two values
+   aggregate_stack <T, Flip> inFront;   // the oldest values, oldest on top
+   aggregate_stack <T, Op>   inBack;    // the newest values, newest on top
+};
+
+} // custom namespace
@@ -0,0 +1,310 @@
+/***********************************************************************
+ * Module:
+ *    Arena Stack
+ * Summary:
+ *    A stack whose buffer comes from a std::pmr::memory_resource instead
+ *    of the heap.  Give it a monotonic_buffer_resource over a buffer of
+ *    your own, with null_memory_resource() upstream, and it never calls
+ *    malloc at all.
+ *
+ *    reset() drops every element but keeps the buffer, so a stack that
+ *    lives across requests only allocates until it reaches the largest
+ *    size it has been.  When T is trivially destructible reset() is
+ *    O(1).
+ *
+ *    A monotonic resource never gets back what is deallocated, so the
+ *    buffer starts at a useful size rather than growing 1, 2, 4, ...
+ *    through the arena.
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       arena_stack       : a stack allocating from a memory resource
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>          // because I am paranoid
+#include <cstddef>          // for size_t
+#include <memory_resource>  // for std::pmr::memory_resource
+#include <new>              // for placement new
+#include <type_traits>      // for std::is_trivially_destructible
+#include <utility>          // for std::move, std::move_if_noexcept
+
+class TestArenaStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * ARENA STACK
+ * First-in-Last-out data structure, allocating from
+ * a memory resource that must outlive it
+ *************************************************/
+template <class T>
+class arena_stack
+{
+   friend class ::TestArenaStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   explicit arena_stack(std::pmr::memory_resource * pResource = std::pmr::get_default_resource()) :
+      pResource(pResource), data(nullptr), numCapacity(0), numElements(0) {}
+   arena_stack(const arena_stack & rhs) : arena_stack(rhs, rhs.pResource) {}
+   arena_stack(const arena_stack & rhs, std::pmr::memory_resource * pResource);
+   arena_stack(arena_stack && rhs) :
+      pResource(rhs.pResource), data(rhs.data), numCapacity(rhs.numCapacity), numElements(rhs.numElements)
+   {
+      rhs.data = nullptr;
+      rhs.numCapacity = 0;
+      rhs.numElements = 0;
+   }
+   ~arena_stack()
+   {
+      reset();
+      deallocate(data, numCapacity);
+   }
+
+   //
+   // Assign
+   // A copy stays in our resource; a move or a swap
+   // takes the resource along with the buffer
+   //
+
+   arena_stack & operator = (const arena_stack & rhs)
+   {
+      if (this != &rhs)
+      {
+         arena_stack tmp(rhs, pResource);
+         swap(tmp);
+      }
+      return *this;
+   }
+   arena_stack & operator = (arena_stack && rhs)
+   {
+      arena_stack tmp(std::move(rhs));
+      swap(tmp);
+      return *this;
+   }
+   void swap(arena_stack & rhs)
+   {
+      std::swap(pResource,   rhs.pResource);
+      std::swap(data,        rhs.data);
+      std::swap(numCapacity, rhs.numCapacity);
+      std::swap(numElements, rhs.numElements);
+   }
+
+   //
+   // Access
+   //
+
+         T & top()       { assert(numElements > 0); return data[numElements - 1]; }
+   const T & top() const { assert(numElements > 0); return data[numElements - 1]; }
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { emplace(t);            }
+   void push(      T && t) { emplace(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args);
+   template <class Iterator>
+   void push_range(Iterator first, Iterator last)
+   {
+      for (; first != last; ++first)
+         emplace(*first);
+   }
+   void reserve(size_t newCapacity);
+
+   //
+   // Remove
+   //
+
+   void pop()
+   {
+      if (numElements > 0)
+         data[--numElements].~T();
+   }
+   void pop_n(size_t n)
+   {
+      size_t newElements = (n < numElements ? numElements - n : 0);
+      destroy(newElements, numElements);
+      numElements = newElements;
+   }
+   void reset()
+   {
+      destroy(0, numElements);
+      numElements = 0;
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()     const { return numElements;      }
+   bool   empty()    const { return numElements == 0; }
+   size_t capacity() const { return numCapacity;      }
+   std::pmr::memory_resource * resource() const { return pResource; }
+
+private:
+
+   // the first buffer, about 256 bytes
+   static const size_t MIN_CAPACITY = (sizeof(T) >= 256 ? 1 : 256 / sizeof(T));
+
+   T * allocate(size_t num)
+   {
+      return static_cast <T *>(pResource->allocate(num * sizeof(T), alignof(T)));
+   }
+   void deallocate(T * p, size_t num)
+   {
+      if (p)
+         pResource->deallocate(p, num * sizeof(T), alignof(T));
+   }
+
+   // compiles to nothing when T has nothing to destroy
+   void destroy(size_t iBegin, size_t iEnd)
+   {
+      if (!std::is_trivially_destructible <T>::value)
+         for (size_t i = iBegin; i < iEnd; i++)
+            data[i].~T();
+   }
+
+   void relocate(T * dataNew, size_t newCapacity);
+
+   std::pmr::memory_resource * pResource;    // where the buffer comes from
+   T *                         data;         // the buffer, bottom first
+   size_t                      numCapacity;  // the size of the buffer
+   size_t                      numElements;  // how many slots hold an element
+};
+
+/*****************************************
+ * ARENA STACK :: COPY CONSTRUCTOR
+ * Copy rhs into a buffer from the given resource,
+ * just big enough to hold it
+ ****************************************/
+template <class T>
+arena_stack <T> :: arena_stack(const arena_stack & rhs, std::pmr::memory_resource * pResource) :
+   pResource(pResource), data(nullptr), numCapacity(0), numElements(0)
+{
+   if (rhs.numElements == 0)
+      return;
+
+   data = allocate(rhs.numElements);
+   numCapacity = rhs.numElements;
+   try
+   {
+      for (; numElements < rhs.numElements; numElements++)
+         new ((void *)(data + numElements)) T(rhs.data[numElements]);
+   }
+   catch (...)
+   {
+      reset();
+      deallocate(data, numCapacity);
+      throw;
+   }
+}
+
+/*****************************************
+ * ARENA STACK :: EMPLACE
+ * Build a value on top, doubling the buffer if it is
+ * full.  push is an emplace of a T.
+ *   INPUT  : args - for the constructor of T
+ *   COST   : O(1) amortized
+ ****************************************/
+template <class T>
+template <class ... Args>
+void arena_stack <T> :: emplace(Args && ... args)
+{
+   if (numElements < numCapacity)
+   {
+      new ((void *)(data + numElements)) T(std::forward<Args>(args)...);
+      numElements++;
+      return;
+   }
+
+   // build the new element before moving the old ones:
+   // args may refer to something in the old buffer
+   size_t newCapacity = (numCapacity == 0 ? MIN_CAPACITY : numCapacity * 2);
+   T * dataNew = allocate(newCapacity);
+   bool built = false;
+   try
+   {
+      new ((void *)(dataNew + numElements)) T(std::forward<Args>(args)...);
+      built = true;
+      relocate(dataNew, newCapacity);
+   }
+   catch (...)
+   {
+      if (built)
+         dataNew[numElements].~T();
+      deallocate(dataNew, newCapacity);
+      throw;
+   }
+   numElements++;
+}
+
+/*****************************************
+ * ARENA STACK :: RESERVE
+ * Make room for newCapacity elements up front, so a
+ * request of known size takes one allocation
+ *   INPUT  : newCapacity - how many to hold
+ ****************************************/
+template <class T>
+void arena_stack <T> :: reserve(size_t newCapacity)
+{
+   if (newCapacity <= numCapacity)
+      return;
+   T * dataNew = allocate(newCapacity);
+   try
+   {
+      relocate(dataNew, newCapacity);
+   }
+   catch (...)
+   {
+      deallocate(dataNew, newCapacity);
+      throw;
+   }
+}
+
+/*****************************************
+ * ARENA STACK :: RELOCATE
+ * Move the elements to a new buffer and give the old
+ * one back to the resource.  A move that might throw
+ * is a copy instead, so if building one throws, the
+ * ones already built are destroyed and the stack is
+ * as it was.  dataNew is still the caller's to free.
+ ****************************************/
+template <class T>
+void arena_stack <T> :: relocate(T * dataNew, size_t newCapacity)
+{
+   size_t i = 0;
+   try
+   {
+      for (; i < numElements; i++)
+         new ((void *)(dataNew + i)) T(std::move_if_noexcept(data[i]));
+   }
+   catch (...)
+   {
+      while (i > 0)
+         dataNew[--i].~T();
+      throw;
+   }
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = newCapacity;
+}
+
+} // custom namespace
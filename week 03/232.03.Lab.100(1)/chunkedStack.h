@@ -0,0 +1,308 @@
+/***********************************************************************
+ * Module:
+ *    Chunked Stack
+ * Summary:
+ *    A stack that grows by linking fixed-size blocks instead of
+ *    doubling one buffer.  Nothing is ever relocated, so push and pop
+ *    are O(1) in the worst case, not just amortized.  The most recently
+ *    emptied block is kept as a spare so pushing and popping back and
+ *    forth across a block boundary does not go to the allocator.
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       chunked_stack     : a stack of fixed-size blocks
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
+#include <new>      // for placement new
+#include <utility>  // for std::move
+
+class TestChunkedStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * CHUNKED STACK
+ * First-in-Last-out data structure.  N is the number
+ * of elements in each block; by default a block is
+ * about 4K.
+ *************************************************/
+template <class T, size_t N = (sizeof(T) * 16 > 4096 ? 16 : 4096 / sizeof(T))>
+class chunked_stack
+{
+   friend class ::TestChunkedStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   chunked_stack() : pTop(nullptr), pSpare(nullptr), numInTop(0), numElements(0) {}
+   chunked_stack(const chunked_stack &  rhs);
+   chunked_stack(      chunked_stack && rhs) :
+      pTop(rhs.pTop), pSpare(rhs.pSpare), numInTop(rhs.numInTop), numElements(rhs.numElements)
+   {
+      rhs.pTop = nullptr;
+      rhs.pSpare = nullptr;
+      rhs.numInTop = 0;
+      rhs.numElements = 0;
+   }
+   ~chunked_stack()
+   {
+      clear();
+      delete pSpare;
+   }
+
+   //
+   // Assign
+   //
+
+   chunked_stack & operator = (const chunked_stack & rhs)
+   {
+      if (this != &rhs)
+      {
+         chunked_stack tmp(rhs);
+         swap(tmp);
+      }
+      return *this;
+   }
+   chunked_stack & operator = (chunked_stack && rhs)
+   {
+      chunked_stack tmp(std::move(rhs));
+      swap(tmp);
+      return *this;
+   }
+   void swap(chunked_stack & rhs)
+   {
+      std::swap(pTop,        rhs.pTop);
+      std::swap(pSpare,      rhs.pSpare);
+      std::swap(numInTop,    rhs.numInTop);
+      std::swap(numElements, rhs.numElements);
+   }
+
+   //
+   // Access
+   //
+
+         T & top()
+   {
+      assert(numElements > 0);
+      return pTop->slot(numInTop - 1);
+   }
+   const T & top() const
+   {
+      assert(numElements > 0);
+      return pTop->slot(numInTop - 1);
+   }
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { emplace(t);            }
+   void push(      T && t) { emplace(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args);
+
+   //
+   // Remove
+   //
+
+   void pop();
+   void clear();
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+   //
+   // Container
+   // The names stack<T, Container> expects, so this can
+   // also be the backing store of a custom::stack
+   //
+
+         T & back()                 { return top();            }
+   const T & back() const           { return top();            }
+   void push_back(const T &  t)     { push(t);                 }
+   void push_back(      T && t)     { push(std::move(t));      }
+   void pop_back()                  { pop();                   }
+   template <class ... Args>
+   void emplace_back(Args && ... args) { emplace(std::forward<Args>(args)...); }
+
+private:
+
+   /**************************************************
+    * BLOCK
+    * N slots of raw storage and a link to the block
+    * underneath.  Only the top block can be partly full.
+    *************************************************/
+   struct Block
+   {
+      Block() : pBelow(nullptr) {}
+      T & slot(size_t i) { return reinterpret_cast <T *>(storage)[i]; }
+
+      Block * pBelow;
+      alignas(T) unsigned char storage[N * sizeof(T)];
+   };
+
+   Block * pTop;          // the block holding the top of the stack
+   Block * pSpare;        // the last block emptied, kept for the next push
+   size_t  numInTop;      // how many slots of pTop are filled
+   size_t  numElements;   // the number of elements in all the blocks
+};
+
+/*****************************************
+ * CHUNKED STACK :: COPY CONSTRUCTOR
+ * Copy rhs block for block, top down, so every element
+ * lands in the same slot it had in rhs
+ ****************************************/
+template <class T, size_t N>
+chunked_stack <T, N> :: chunked_stack(const chunked_stack & rhs) :
+   pTop(nullptr), pSpare(nullptr), numInTop(0), numElements(0)
+{
+   Block ** ppLink = &pTop;
+   try
+   {
+      size_t num = rhs.numInTop;
+      for (Block * p = rhs.pTop; p; p = p->pBelow, num = N)
+      {
+         Block * pNew = new Block;
+         *ppLink = pNew;
+         ppLink = &pNew->pBelow;
+         for (size_t i = 0; i < num; i++, numElements++)
+            new ((void *)&pNew->slot(i)) T(p->slot(i));
+      }
+      numInTop = rhs.numInTop;
+   }
+   catch (...)
+   {
+      // the elements were built in order from the top, so
+      // numElements says exactly which slots hold one
+      size_t num = rhs.numInTop;
+      for (Block * p = pTop; p; num = N)
+      {
+         size_t numBuilt = (num < numElements ? num : numElements);
+         for (size_t i = 0; i < numBuilt; i++)
+            p->slot(i).~T();
+         numElements -= numBuilt;
+
+         Block * pDelete = p;
+         p = p->pBelow;
+         delete pDelete;
+      }
+      throw;
+   }
+}
+
+/*****************************************
+ * CHUNKED STACK :: EMPLACE
+ * Build a value on top, adding a block if the top one
+ * is full.  The spare is used before asking for a new
+ * block, and a new block is only linked in once the
+ * value is safely in it.  push is an emplace of a T.
+ *   INPUT  : args - for the constructor of T
+ *   COST   : O(1)
+ ****************************************/
+template <class T, size_t N>
+template <class ... Args>
+void chunked_stack <T, N> :: emplace(Args && ... args)
+{
+   if (pTop != nullptr && numInTop < N)
+   {
+      new ((void *)&pTop->slot(numInTop)) T(std::forward<Args>(args)...);
+      numInTop++;
+      numElements++;
+      return;
+   }
+
+   Block * pNew = pSpare;
+   pSpare = nullptr;
+   if (pNew == nullptr)
+      pNew = new Block;
+
+   try
+   {
+      new ((void *)&pNew->slot(0)) T(std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      pSpare = pNew;
+      throw;
+   }
+
+   pNew->pBelow = pTop;
+   pTop = pNew;
+   numInTop = 1;
+   numElements++;
+}
+
+/*****************************************
+ * CHUNKED STACK :: POP
+ * Remove the top element, if there is one.  When the
+ * top block empties it becomes the spare and any
+ * older spare is freed, so at most one empty block
+ * is ever held.
+ *   COST   : O(1)
+ ****************************************/
+template <class T, size_t N>
+void chunked_stack <T, N> :: pop()
+{
+   if (numElements == 0)
+      return;
+
+   pTop->slot(--numInTop).~T();
+   numElements--;
+
+   if (numInTop == 0)
+   {
+      Block * pEmpty = pTop;
+      pTop = pTop->pBelow;
+      numInTop = (pTop ? N : 0);
+      delete pSpare;
+      pSpare = pEmpty;
+   }
+}
+
+/*****************************************
+ * CHUNKED STACK :: CLEAR
+ * Destroy every element and free every block but
+ * the spare
+ *   COST   : O(n)
+ ****************************************/
+template <class T, size_t N>
+void chunked_stack <T, N> :: clear()
+{
+   while (pTop)
+   {
+      for (size_t i = 0; i < numInTop; i++)
+         pTop->slot(i).~T();
+
+      Block * pDelete = pTop;
+      pTop = pTop->pBelow;
+      numInTop = N;
+      if (pSpare == nullptr)
+         pSpare = pDelete;
+      else
+         delete pDelete;
+   }
+   numInTop = 0;
+   numElements = 0;
+}
+
+} // custom namespace
@@ -0,0 +1,233 @@
+/***********************************************************************
+ * Module:
+ *    Flat Combining
+ * Summary:
+ *    Makes any sequential container safe to share between threads.  A
+ *    thread that wants an operation done publishes it in a record and
+ *    then tries to become the combiner.  One thread wins and runs every
+ *    published operation in a single pass while it holds the container.
+ *    The rest spin on their own record until the combiner marks it done.
+ *
+ *    The container is only ever touched by one thread at a time, so it
+ *    stays in that thread's cache across a whole batch.  Under
+ *    contention, each thread waits on its own record rather than on a
+ *    shared lock or CAS target.
+ *
+ *    The publication list is a fixed array of cache-line records.  A
+ *    thread claims one for each operation, starting from a slot picked
+ *    by its thread id, so threads usually land on the same record every
+ *    time and need no registration.
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       flat_combining    : a container shared through a combiner
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>      // for std::atomic
+#include <cstddef>     // for size_t
+#include <exception>   // for std::exception_ptr
+#include <functional>  // for std::hash
+#include <thread>      // for std::this_thread
+#include <type_traits> // for std::remove_reference
+#include <utility>     // for std::forward
+
+class TestFlatCombining; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * FLAT COMBINING
+ * Container behind a combiner.  Any operation goes
+ * through apply(); push and try_pop are there for
+ * stack-like containers.
+ *************************************************/
+template <class Container, size_t NUM_RECORDS = 64>
+class flat_combining
+{
+   friend class ::TestFlatCombining; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   template <class ... Args>
+   explicit flat_combining(Args && ... args) :
+      container(std::forward<Args>(args)...), combining(false) {}
+   flat_combining(const flat_combining & rhs) = delete;
+   flat_combining & operator = (const flat_combining & rhs) = delete;
+
+   //
+   // Apply
+   //
+
+   template <class F>
+   void apply(F && f);
+
+   //
+   // Stack
+   //
+
+   template <class U>
+   void push(U && u)
+   {
+      apply([&u](Container & c) { c.push(std::forward<U>(u)); });
+   }
+   template <class U>
+   bool try_pop(U & u)
+   {
+      bool popped = false;
+      apply([&u, &popped](Container & c)
+      {
+         if (!c.empty())
+         {
+            u = std::move(c.top());
+            c.pop();
+            popped = true;
+         }
+      });
+      return popped;
+   }
+
+   //
+   // Status
+   // Already stale when it returns if others are busy
+   //
+
+   size_t size()
+   {
+      size_t num = 0;
+      apply([&num](const Container & c) { num = c.size(); });
+      return num;
+   }
+   bool empty() { return size() == 0; }
+
+private:
+
+   /*************************************************
+    * RECORD
+    * One published operation.  f and pArg are written
+    * by the owner before pending is set, and read by
+    * the combiner after it sees pending.
+    *************************************************/
+   struct alignas(64) Record
+   {
+      Record() : inUse(false), pending(false), f(nullptr), pArg(nullptr) {}
+
+      std::atomic <bool> inUse;                 // claimed by a thread
+      std::atomic <bool> pending;               // published and not yet run
+      void (*f)(Container &, void *);           // runs the operation
+      void *             pArg;                  // the operation itself
+      std::exception_ptr error;                 // what it threw, if anything
+   };
+
+   template <class F>
+   static void invoke(Container & c, void * pArg) { (*static_cast <F *>(pArg))(c); }
+
+   Record & claim();
+   void     combine();
+
+   static const int NUM_SPINS = 64;   // how long to spin before yielding
+
+   Container          container;      // only touched by the combiner
+   std::atomic <bool> combining;      // some thread is the combiner
+   Record             records[NUM_RECORDS];
+};
+
+/*****************************************
+ * FLAT COMBINING :: APPLY
+ * Run f(container) as if nothing else were using it.
+ * Publish it, then either become the combiner and run
+ * it along with everyone else's, or wait for whoever
+ * is combining to run it for us.  Whatever f throws
+ * comes back out here, on our own thread.
+ *   INPUT  : f - callable with a Container &
+ *   COST   : one pass over the records for the combiner
+ ****************************************/
+template <class Container, size_t NUM_RECORDS>
+template <class F>
+void flat_combining <Container, NUM_RECORDS> :: apply(F && f)
+{
+   typedef typename std::remove_reference <F>::type Op;
+   Record & record = claim();
+   record.f = &invoke <Op>;
+   record.pArg = (void *)&f;
+   record.pending.store(true, std::memory_order_release);
+
+   for (int spins = 0; record.pending.load(std::memory_order_acquire); spins++)
+   {
+      if (!combining.load(std::memory_order_relaxed) &&
+          !combining.exchange(true, std::memory_order_acquire))
+      {
+         combine();
+         combining.store(false, std::memory_order_release);
+      }
+      else if (spins % NUM_SPINS == NUM_SPINS - 1)
+         std::this_thread::yield();
+   }
+
+   std::exception_ptr error;
+   std::swap(error, record.error);
+   record.inUse.store(false, std::memory_order_release);
+   if (error)
+      std::rethrow_exception(error);
+}
+
+/*****************************************
+ * FLAT COMBINING :: CLAIM
+ * Find a free record, starting where this thread's id
+ * says so each thread tends to get the same one
+ ****************************************/
+template <class Container, size_t NUM_RECORDS>
+typename flat_combining <Container, NUM_RECORDS>::Record &
+flat_combining <Container, NUM_RECORDS> :: claim()
+{
+   size_t i = std::hash <std::thread::id>()(std::this_thread::get_id());
+   for (int spins = 0; ; i++, spins++)
+   {
+      Record & record = records[i % NUM_RECORDS];
+      if (!record.inUse.load(std::memory_order_relaxed) &&
+          !record.inUse.exchange(true, std::memory_order_acquire))
+         return record;
+      if (spins % NUM_SPINS == NUM_SPINS - 1)
+         std::this_thread::yield();
+   }
+}
+
+/*****************************************
+ * FLAT COMBINING :: COMBINE
+ * Run every published operation.  Only the thread that
+ * set combining calls this.
+ ****************************************/
+template <class Container, size_t NUM_RECORDS>
+void flat_combining <Container, NUM_RECORDS> :: combine()
+{
+   for (Record & record : records)
+   {
+      if (!record.pending.load(std::memory_order_acquire))
+         continue;
+      try
+      {
+         record.f(container, record.pArg);
+      }
+      catch (...)
+      {
+         record.error = std::current_exception();
+      }
+      record.pending.store(false, std::memory_order_release);
+   }
+}
+
+} // custom namespace
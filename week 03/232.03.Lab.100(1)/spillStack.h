@@ -0,0 +1,431 @@
+/***********************************************************************
+ * Module:
+ *    Spill Stack
+ * Summary:
+ *    A stack that can grow past the memory available.  Values live in
+ *    fixed-size blocks, and only the top K blocks are kept in memory.
+ *    Once all K are full, the bottom one is written to a temporary file
+ *    to make room.  Blocks are only ever written to the end of the file
+ *    and read back from the end, so all disk access is sequential.
+ *
+ *    Popping down to the last block in memory reads the next K/2 blocks
+ *    back in one pass, so the next fetch is K/2 blocks away and the next
+ *    spill almost as far.  Going back and forth across a block boundary
+ *    never touches the disk.
+ *
+ *    Blocks are copied to and from the disk byte for byte, so T has to
+ *    be trivially copyable.
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       spill_stack       : a stack whose bottom lives in a file
+ *       spill_stats       : how much of it went to disk
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstddef>      // for size_t
+#include <cstdio>       // for std::FILE
+#include <cstring>      // for std::memcpy
+#include <new>          // for placement new
+#include <stdexcept>    // for std::runtime_error
+#include <type_traits>  // for std::is_trivially_copyable
+#include <utility>      // for std::swap
+
+class TestSpillStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SPILL STATS
+ * Block counts: how many went to disk and came back
+ * over the life of the stack, and where they are now
+ *************************************************/
+struct spill_stats
+{
+   size_t numSpilled;   // blocks written to the file
+   size_t numFetched;   // blocks read back from the file
+   size_t numOnDisk;    // blocks in the file now
+   size_t numInMemory;  // blocks holding values in memory now
+};
+
+/**************************************************
+ * SPILL STACK
+ * First-in-Last-out data structure.  N is the number
+ * of elements in a block, about 4K by default, and K
+ * is the number of blocks kept in memory.
+ *************************************************/
+template <class T,
+          size_t N = (sizeof(T) * 16 > 4096 ? 16 : 4096 / sizeof(T)),
+          size_t K = 64>
+class spill_stack
+{
+   static_assert(std::is_trivially_copyable <T>::value,
+                 "spill_stack copies values to disk byte for byte");
+   static_assert(K >= 2, "spill_stack needs at least two blocks in memory");
+
+   friend class ::TestSpillStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   spill_stack() : iBottom(0), numHot(0), numInTop(0), numOnDisk(0),
+                   numElements(0), numSpilled(0), numFetched(0), pFile(nullptr)
+   {
+      for (size_t i = 0; i < K; i++)
+         ring[i] = nullptr;
+   }
+   spill_stack(const spill_stack &  rhs);
+   spill_stack(      spill_stack && rhs) : spill_stack() { swap(rhs); }
+   ~spill_stack()
+   {
+      for (size_t i = 0; i < K; i++)
+         delete ring[i];
+      if (pFile)
+         std::fclose(pFile);
+   }
+
+   //
+   // Assign
+   //
+
+   spill_stack & operator = (const spill_stack & rhs)
+   {
+      if (this != &rhs)
+      {
+         spill_stack tmp(rhs);
+         swap(tmp);
+      }
+      return *this;
+   }
+   spill_stack & operator = (spill_stack && rhs)
+   {
+      spill_stack tmp(std::move(rhs));
+      swap(tmp);
+      return *this;
+   }
+   void swap(spill_stack & rhs)
+   {
+      for (size_t i = 0; i < K; i++)
+         std::swap(ring[i], rhs.ring[i]);
+      std::swap(iBottom,     rhs.iBottom);
+      std::swap(numHot,      rhs.numHot);
+      std::swap(numInTop,    rhs.numInTop);
+      std::swap(numOnDisk,   rhs.numOnDisk);
+      std::swap(numElements, rhs.numElements);
+      std::swap(numSpilled,  rhs.numSpilled);
+      std::swap(numFetched,  rhs.numFetched);
+      std::swap(pFile,       rhs.pFile);
+   }
+
+   //
+   // Access
+   // The top block is always in memory
+   //
+
+         T & top()
+   {
+      assert(numElements > 0);
+      return hot(numHot - 1).slot(numInTop - 1);
+   }
+   const T & top() const
+   {
+      assert(numElements > 0);
+      return hot(numHot - 1).slot(numInTop - 1);
+   }
+
+   //
+   // Insert
+   //
+
+   void push(const T & t) { emplace(t); }
+   template <class ... Args>
+   void emplace(Args && ... args);
+   template <class Iterator>
+   void push_range(Iterator first, Iterator last)
+   {
+      for (; first != last; ++first)
+         emplace(*first);
+   }
+
+   //
+   // Remove
+   //
+
+   void pop();
+   void pop_n(size_t n)
+   {
+      for (; n > 0 && numElements > 0; n--)
+         pop();
+   }
+   void clear()
+   {
+      iBottom = numHot = numInTop = numOnDisk = numElements = 0;
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+   spill_stats stats() const
+   {
+      return spill_stats { numSpilled, numFetched, numOnDisk, numHot };
+   }
+
+   //
+   // Container
+   // The names stack<T, Container> expects, so this can
+   // also be the backing store of a custom::stack
+   //
+
+         T & back()                 { return top(); }
+   const T & back() const           { return top(); }
+   void push_back(const T & t)      { push(t);      }
+   void pop_back()                  { pop();        }
+   template <class ... Args>
+   void emplace_back(Args && ... args) { emplace(std::forward<Args>(args)...); }
+
+private:
+
+   /**************************************************
+    * BLOCK
+    * N values, written to and read from the file as
+    * one record
+    *************************************************/
+   struct Block
+   {
+      T & slot(size_t i) { return reinterpret_cast <T *>(storage)[i]; }
+
+      alignas(T) unsigned char storage[N * sizeof(T)];
+   };
+
+   // the i'th block in memory, counting up from the lowest
+   Block & hot(size_t i) const { return *ring[(iBottom + i) % K]; }
+
+   void spill();
+   void fetch();
+   void seek(size_t iBlock) const;
+   std::FILE * file();
+
+   Block *     ring[K];      // the blocks in memory, a ring starting at iBottom
+   size_t      iBottom;      // where in ring the lowest block in memory is
+   size_t      numHot;       // how many blocks in ring hold values
+   size_t      numInTop;     // how many slots of the top block are filled
+   size_t      numOnDisk;    // how many blocks are in the file, under the ring
+   size_t      numElements;  // the number of elements everywhere
+   size_t      numSpilled;   // blocks written so far
+   size_t      numFetched;   // blocks read back so far
+   std::FILE * pFile;        // where spilled blocks go; opened on the first spill
+};
+
+/*****************************************
+ * SPILL STACK :: COPY CONSTRUCTOR
+ * Copy the blocks in the file to a file of our own,
+ * then the blocks in memory.  The statistics start
+ * over.
+ ****************************************/
+template <class T, size_t N, size_t K>
+spill_stack <T, N, K> :: spill_stack(const spill_stack & rhs) : spill_stack()
+{
+   if (rhs.numOnDisk)
+   {
+      Block * pBuffer = new Block;
+      try
+      {
+         std::FILE * pDest = file();
+         for (size_t i = 0; i < rhs.numOnDisk; i++)
+         {
+            rhs.seek(i);
+            if (std::fread(pBuffer, sizeof(Block), 1, rhs.pFile) != 1)
+               throw std::runtime_error("Unable to read the spill file");
+            seek(i);
+            if (std::fwrite(pBuffer, sizeof(Block), 1, pDest) != 1)
+               throw std::runtime_error("Unable to write the spill file");
+         }
+      }
+      catch (...)
+      {
+         delete pBuffer;
+         throw;
+      }
+      delete pBuffer;
+   }
+
+   // the destructor cleans up after a bad_alloc here
+   for (size_t i = 0; i < rhs.numHot; i++)
+   {
+      ring[i] = new Block;
+      std::memcpy(ring[i], &rhs.hot(i), sizeof(Block));
+   }
+   numHot      = rhs.numHot;
+   numInTop    = rhs.numInTop;
+   numOnDisk   = rhs.numOnDisk;
+   numElements = rhs.numElements;
+}
+
+/*****************************************
+ * SPILL STACK :: EMPLACE
+ * Build a value on top, starting a new block if the
+ * top one is full.  When every block in memory is
+ * full the lowest one is spilled to make room.  push
+ * is an emplace of a T.
+ *   INPUT  : args - for the constructor of T
+ *   COST   : O(1), plus one block write every N
+ *            pushes once K blocks are full
+ ****************************************/
+template <class T, size_t N, size_t K>
+template <class ... Args>
+void spill_stack <T, N, K> :: emplace(Args && ... args)
+{
+   // build it first so a throw leaves the stack alone
+   T t(std::forward<Args>(args)...);
+
+   if (numHot == 0 || numInTop == N)
+   {
+      if (numHot == K)
+         spill();
+      Block * & pNew = ring[(iBottom + numHot) % K];
+      if (pNew == nullptr)
+         pNew = new Block;
+      numHot++;
+      numInTop = 0;
+   }
+
+   new ((void *)&hot(numHot - 1).slot(numInTop++)) T(t);
+   numElements++;
+}
+
+/*****************************************
+ * SPILL STACK :: POP
+ * Remove the top element, if there is one.  An empty
+ * top block stays allocated for the next push.  When
+ * this pop would leave only one block in memory, fetch
+ * more from the file first: a failed read then throws
+ * with nothing changed.
+ *   COST   : O(1), plus K/2 block reads every K/2
+ *            blocks of pops once the file is in use
+ ****************************************/
+template <class T, size_t N, size_t K>
+void spill_stack <T, N, K> :: pop()
+{
+   if (numElements == 0)
+      return;
+
+   if (numOnDisk > 0 && numHot - (numInTop == 1 ? 1 : 0) <= 1)
+      fetch();
+
+   numElements--;
+   if (--numInTop == 0 && numElements > 0)
+   {
+      numHot--;
+      numInTop = N;
+   }
+   else if (numElements == 0)
+      numHot = 0;
+}
+
+/*****************************************
+ * SPILL STACK :: SPILL
+ * Append the lowest block in memory to the file.  Its
+ * buffer is the next one the ring hands out.
+ ****************************************/
+template <class T, size_t N, size_t K>
+void spill_stack <T, N, K> :: spill()
+{
+   assert(numHot == K);
+   std::FILE * pDest = file();
+   seek(numOnDisk);
+   if (std::fwrite(&hot(0), sizeof(Block), 1, pDest) != 1)
+      throw std::runtime_error("Unable to write the spill file");
+
+   iBottom = (iBottom + 1) % K;
+   numHot--;
+   numOnDisk++;
+   numSpilled++;
+}
+
+/*****************************************
+ * SPILL STACK :: FETCH
+ * Read back up to K/2 of the top blocks in the file,
+ * lowest first so the file is read front to back,
+ * into the free buffers under the lowest block in
+ * memory.  Only free buffers are written and nothing
+ * is counted until every read succeeds.
+ ****************************************/
+template <class T, size_t N, size_t K>
+void spill_stack <T, N, K> :: fetch()
+{
+   assert(numHot > 0);
+   size_t num = (numOnDisk < K / 2 ? numOnDisk : K / 2);
+   if (num > K - numHot)
+      num = K - numHot;
+   if (num == 0)
+      return;
+   size_t iNewBottom = (iBottom + K - num) % K;
+
+   seek(numOnDisk - num);
+   for (size_t i = 0; i < num; i++)
+   {
+      Block * & pBlock = ring[(iNewBottom + i) % K];
+      if (pBlock == nullptr)
+         pBlock = new Block;
+      if (std::fread(pBlock, sizeof(Block), 1, pFile) != 1)
+         throw std::runtime_error("Unable to read the spill file");
+   }
+
+   iBottom = iNewBottom;
+   numHot += num;
+   numOnDisk -= num;
+   numFetched += num;
+}
+
+/*****************************************
+ * SPILL STACK :: SEEK
+ * Put the file position at the start of a block
+ ****************************************/
+template <class T, size_t N, size_t K>
+void spill_stack <T, N, K> :: seek(size_t iBlock) const
+{
+   long long offset = (long long)iBlock * (long long)sizeof(Block);
+#ifdef _WIN32
+   int result = _fseeki64(pFile, offset, SEEK_SET);
+#else
+   int result = fseeko(pFile, (off_t)offset, SEEK_SET);
+#endif
+   if (result != 0)
+      throw std::runtime_error("Unable to seek in the spill file");
+}
+
+/*****************************************
+ * SPILL STACK :: FILE
+ * The spill file, created the first time it is needed.
+ * It is removed when it is closed.
+ ****************************************/
+template <class T, size_t N, size_t K>
+std::FILE * spill_stack <T, N, K> :: file()
+{
+   if (pFile == nullptr)
+   {
+      pFile = std::tmpfile();
+      if (pFile == nullptr)
+         throw std::runtime_error("Unable to create the spill file");
+   }
+   return pFile;
+}
+
+} // custom namespace
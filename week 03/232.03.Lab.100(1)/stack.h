@@ -12,6 +12,10 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *
+ *    The stack sits on top of any container with back, push_back,
+ *    pop_back, size, empty, and swap, so the backing store can be chosen
+ *    where the stack is declared.  custom::vector is the default.
+ *
  *    This will contain the class definition of:
  *       stack             : similar to std::stack
  * Author
@@ -20,9 +24,12 @@
 
 #pragma once
 
-#include <cassert>  // because I am paranoid
-//#include "vector.h"
-#include <vector>
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for size_t
+#include <iterator>    // for std::iterator_traits
+#include <type_traits> // for std::is_base_of
+#include <utility>     // for std::move
+#include "vector.h"    // for the default container
 
 class TestStack; // forward declaration for unit tests
 
@@ -33,46 +40,43 @@ namespace custom
  * STACK
  * First-in-Last-out data structure
  *************************************************/
-template<class T>
+template<class T, class Container = custom::vector <T> >
 class stack
 {
    friend class ::TestStack; // give unit tests access to the privates
 public:
+
+   typedef Container container_type;
   
    // 
    // Construct
    // 
 
-   stack()                            { container.resize(0); }
-   stack(const stack <T> &  rhs)      { this->container = rhs.container; }
-
-   stack(      stack <T> && rhs)   
-   {
-       this->container = std::move(rhs.container);
-
-   }
-
-   stack(const std::vector<T>& rhs)   { this->container = rhs; }
-   stack(      std::vector<T> && rhs) { this->container = std::move(rhs); }
+   stack()                            {                      }
+   stack(const stack &  rhs)          : container(rhs.container)            {}
+   stack(      stack && rhs)          : container(std::move(rhs.container)) {}
+   stack(const Container &  rhs)      : container(rhs)                      {}
+   stack(      Container && rhs)      : container(std::move(rhs))           {}
    ~stack()                           {                      }
 
    //
    // Assign
    //
 
-   stack <T> & operator = (const stack <T> & rhs)
+   stack & operator = (const stack & rhs)
    {
       this->container = rhs.container;
       return *this;
    }
-   stack <T>& operator = (stack <T> && rhs)
+   stack & operator = (stack && rhs)
    {
-       
-       this->container = std::move(rhs.container);
+       // take the buffer of rhs; the old one leaves with tmp
+       Container tmp(std::move(rhs.container));
+       this->container.swap(tmp);
        return *this;
    }
 
-   void swap(stack <T>& rhs)
+   void swap(stack & rhs)
    {
        this->container.swap(rhs.container);
    }
@@ -90,6 +94,11 @@ public:
 
    void push(const T& t) { container.push_back(t); }
    void push(      T&& t) { container.push_back(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args) { container.emplace_back(std::forward<Args>(args)...); }
+   template <class Iterator>
+   void push_range(Iterator first, Iterator last);
+   void reserve(size_t n) { container.reserve(n); }
 
    //
    // Remove
@@ -100,18 +109,57 @@ public:
        if( container.size() > 0)
            container.pop_back();
    }
+   void pop_n(size_t n)
+   {
+      for (size_t i = container.size(); n > 0 && i > 0; n--, i--)
+         container.pop_back();
+   }
 
    //
    // Status
    //
    size_t  size () const { return container.size(); }
    bool empty   () const { return container.empty(); }
+   size_t capacity() const { return container.capacity(); }
    
 private:
+
+   // reserve room for n more if the container can, do nothing if not.
+   // At least double so many short ranges still cost O(n) overall.
+   template <class C>
+   static auto reserveMore(C & c, size_t n, int) -> decltype(c.reserve(n), c.capacity(), void())
+   {
+      size_t num = c.size() + n;
+      if (num > c.capacity())
+         c.reserve(num > 2 * c.capacity() ? num : 2 * c.capacity());
+   }
+   template <class C>
+   static void reserveMore(C &, size_t, long) {}
    
-  std::vector<T> container;  // underlying container
+  Container container;  // underlying container
 };
 
+/*****************************************
+ * STACK :: PUSH RANGE
+ * Push every value in [first, last) so the last one
+ * ends up on top.  When the range can be measured ahead
+ * of time the container grows at most once, and then to
+ * at least double its capacity.
+ *   INPUT  : first, last - the values to push
+ *   COST   : O(n)
+ ****************************************/
+template <class T, class Container>
+template <class Iterator>
+void stack <T, Container> :: push_range(Iterator first, Iterator last)
+{
+   typedef typename std::iterator_traits<Iterator>::iterator_category Category;
+   if (std::is_base_of<std::forward_iterator_tag, Category>::value)
+      reserveMore(container, (size_t)std::distance(first, last), 0);
+
+   for (; first != last; ++first)
+      container.push_back(*first);
+}
+
 
 
 } // custom namespace
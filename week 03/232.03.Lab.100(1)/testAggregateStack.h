@@ -0,0 +1,234 @@
+/***********************************************************************
+ * Header:
+ *    TEST AGGREGATE STACK
+ * Summary:
+ *    Unit tests for aggregate stack and aggregate queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "aggregateStack.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <functional>
+#include <string>
+
+class TestAggregateStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Stack
+      test_stack_default();
+      test_stack_pushMin();
+      test_stack_popMin();
+      test_stack_max();
+      test_stack_sum();
+      test_stack_gcd();
+
+      // Queue
+      test_queue_default();
+      test_queue_fifo();
+      test_queue_order();
+      test_queue_window();
+
+      report("AggregateStack");
+   }
+
+   /***************************************
+    * STACK
+    ***************************************/
+
+   // nothing on the stack, nothing allocated
+   void test_stack_default()
+   {  // exercise
+      custom::aggregate_stack <int> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.entries.capacity() == 0);
+   }  // teardown
+
+   // each entry holds the minimum from the bottom up to it
+   void test_stack_pushMin()
+   {  // setup
+      custom::aggregate_stack <int> s;
+      // exercise
+      s.push(26);
+      s.push(11);
+      s.push(31);
+      // verify
+      //      0    1    2
+      //    +----+----+----+
+      //    | 26 | 11 | 31 |  value
+      //    | 26 | 11 | 11 |  aggregate
+      //    +----+----+----+
+      assertUnit(s.size() == 3);
+      assertUnit(s.top() == 31);
+      assertUnit(s.top_aggregate() == 11);
+      if (s.entries.size() == 3)
+      {
+         assertUnit(s.entries[0].aggregate == 26);
+         assertUnit(s.entries[1].aggregate == 11);
+         assertUnit(s.entries[2].aggregate == 11);
+      }
+   }  // teardown
+
+   // popping the minimum brings back the old one
+   void test_stack_popMin()
+   {  // setup
+      custom::aggregate_stack <int> s;
+      s.push(26);
+      s.push(11);
+      s.push(31);
+      // exercise
+      s.pop();
+      int afterOne = s.top_aggregate();
+      s.pop();
+      int afterTwo = s.top_aggregate();
+      // verify
+      assertUnit(afterOne == 11);
+      assertUnit(afterTwo == 26);
+      assertUnit(s.size() == 1);
+   }  // teardown
+
+   // the maximum
+   void test_stack_max()
+   {  // setup
+      custom::aggregate_stack <int, custom::aggregate_max <int> > s;
+      // exercise
+      s.push(26);
+      s.push(49);
+      s.push(11);
+      // verify
+      assertUnit(s.top_aggregate() == 49);
+      s.pop();
+      s.pop();
+      assertUnit(s.top_aggregate() == 26);
+   }  // teardown
+
+   // the sum, with an op from the standard library
+   void test_stack_sum()
+   {  // setup
+      custom::aggregate_stack <int, std::plus <int> > s;
+      // exercise
+      s.push(26);
+      s.push(49);
+      s.push(11);
+      // verify
+      assertUnit(s.top_aggregate() == 86);
+      s.pop();
+      assertUnit(s.top_aggregate() == 75);
+   }  // teardown
+
+   // the greatest common divisor
+   void test_stack_gcd()
+   {  // setup
+      custom::aggregate_stack <int, custom::aggregate_gcd <int> > s;
+      // exercise
+      s.push(84);
+      s.push(36);
+      s.push(10);
+      // verify
+      assertUnit(s.top_aggregate() == 2);
+      s.pop();
+      assertUnit(s.top_aggregate() == 12);
+   }  // teardown
+
+   /***************************************
+    * QUEUE
+    ***************************************/
+
+   // nothing in the queue
+   void test_queue_default()
+   {  // exercise
+      custom::aggregate_queue <int> q;
+      // verify
+      assertUnit(q.empty());
+      assertUnit(q.size() == 0);
+      assertUnit(q.inFront.empty());
+      assertUnit(q.inBack.empty());
+   }  // teardown
+
+   // first in, first out, the back poured in only when needed
+   void test_queue_fifo()
+   {  // setup
+      custom::aggregate_queue <int> q;
+      q.push(26);
+      q.push(11);
+      q.push(31);
+      // exercise
+      int first = q.front();
+      q.pop();
+      // verify
+      assertUnit(first == 26);
+      assertUnit(q.front() == 11);
+      assertUnit(q.inFront.size() == 2);
+      assertUnit(q.inBack.size() == 0);
+      assertUnit(q.aggregate() == 11);
+      q.push(5);
+      assertUnit(q.aggregate() == 5);
+      q.pop();
+      assertUnit(q.aggregate() == 5);
+      assertUnit(q.size() == 2);
+   }  // teardown
+
+   // an op that cares about order sees the values front to back
+   void test_queue_order()
+   {  // setup
+      custom::aggregate_queue <std::string, std::plus <std::string> > q;
+      q.push("a");
+      q.push("b");
+      q.push("c");
+      // exercise
+      std::string all = q.aggregate();
+      q.pop();
+      std::string afterPop = q.aggregate();
+      q.push("d");
+      std::string afterPush = q.aggregate();
+      // verify
+      assertUnit(all == "abc");
+      assertUnit(afterPop == "bc");
+      assertUnit(afterPush == "bcd");
+   }  // teardown
+
+   // a sliding-window minimum matches a rescan of the window
+   void test_queue_window()
+   {  // setup
+      const int WINDOW = 5;
+      int rg[200];
+      unsigned int seed = 4321;
+      for (int & value : rg)
+      {
+         seed = seed * 1103515245u + 12345u;
+         value = (int)((seed >> 8) % 1000);
+      }
+      custom::aggregate_queue <int> q;
+      int numWrong = 0;
+      // exercise
+      for (int i = 0; i < 200; i++)
+      {
+         q.push(rg[i]);
+         if (q.size() > WINDOW)
+            q.pop();
+
+         int expected = rg[i];
+         for (int j = (i < WINDOW ? 0 : i - WINDOW + 1); j <= i; j++)
+            if (rg[j] < expected)
+               expected = rg[j];
+         if (q.aggregate() != expected)
+            numWrong++;
+      }
+      // verify
+      assertUnit(numWrong == 0);
+      assertUnit(q.size() == WINDOW);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,332 @@
+/***********************************************************************
+ * Header:
+ *    TEST ARENA STACK
+ * Summary:
+ *    Unit tests for arena stack
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "arenaStack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <memory_resource>
+#include <new>
+
+class TestArenaStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_otherResource();
+      test_constructMove_standard();
+
+      // Assign
+      test_assignCopy_keepsResource();
+
+      // Insert
+      test_push_fromBuffer();
+      test_push_bufferFull();
+      test_push_throwWhileGrowing();
+      test_reserve_once();
+
+      // Remove
+      test_popN_standard();
+      test_reset_keepsBuffer();
+      test_reset_destroys();
+
+      report("ArenaStack");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // no resource given, so the default one, and nothing allocated yet
+   void test_construct_default()
+   {  // exercise
+      custom::arena_stack <int> s;
+      // verify
+      assertUnit(s.resource() == std::pmr::get_default_resource());
+      assertUnit(s.data == nullptr);
+      assertUnit(s.capacity() == 0);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // a copy can be put in a different resource
+   void test_constructCopy_otherResource()
+   {  // setup
+      Counting arenaSrc;
+      Counting arenaDest;
+      custom::arena_stack <int> sSrc(&arenaSrc);
+      sSrc.push(26);
+      sSrc.push(49);
+      sSrc.push(67);
+      // exercise
+      custom::arena_stack <int> sDest(sSrc, &arenaDest);
+      // verify
+      assertUnit(sDest.resource() == &arenaDest);
+      assertUnit(arenaDest.numAllocate == 1);
+      assertUnit(sDest.capacity() == 3);
+      assertUnit(sDest.size() == 3);
+      assertUnit(sDest.top() == 67);
+      assertUnit(sDest.data != sSrc.data);
+      assertUnit(sSrc.size() == 3);
+   }  // teardown
+
+   // a move takes the buffer and the resource
+   void test_constructMove_standard()
+   {  // setup
+      Counting arena;
+      custom::arena_stack <int> sSrc(&arena);
+      sSrc.push(26);
+      int * data = sSrc.data;
+      // exercise
+      custom::arena_stack <int> sDest(std::move(sSrc));
+      // verify
+      assertUnit(sDest.data == data);
+      assertUnit(sDest.resource() == &arena);
+      assertUnit(sSrc.data == nullptr);
+      assertUnit(sSrc.empty());
+      assertUnit(arena.numAllocate == 1);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // copy assignment leaves each stack in its own resource
+   void test_assignCopy_keepsResource()
+   {  // setup
+      Counting arenaSrc;
+      Counting arenaDest;
+      custom::arena_stack <int> sSrc(&arenaSrc);
+      custom::arena_stack <int> sDest(&arenaDest);
+      sSrc.push(26);
+      sSrc.push(49);
+      // exercise
+      sDest = sSrc;
+      // verify
+      assertUnit(sDest.resource() == &arenaDest);
+      assertUnit(sDest.size() == 2);
+      assertUnit(sDest.top() == 49);
+      assertUnit(arenaDest.numAllocate == 1);
+      assertUnit(arenaSrc.numAllocate == 1);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // a few hundred pushes come out of a buffer on the stack
+   void test_push_fromBuffer()
+   {  // setup
+      alignas(int) unsigned char buffer[8192];
+      std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                                std::pmr::null_memory_resource());
+      custom::arena_stack <int> s(&arena);
+      // exercise
+      for (int i = 0; i < 300; i++)
+         s.push(i);
+      // verify
+      assertUnit(s.size() == 300);
+      assertUnit(s.top() == 299);
+      assertUnit((unsigned char *)s.data >= buffer);
+      assertUnit((unsigned char *)(s.data + s.capacity()) <= buffer + sizeof(buffer));
+   }  // teardown
+
+   // running out of arena throws and leaves the stack alone
+   void test_push_bufferFull()
+   {  // setup
+      alignas(int) unsigned char buffer[1024];
+      std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                                std::pmr::null_memory_resource());
+      custom::arena_stack <int> s(&arena);
+      bool thrown = false;
+      int i = 0;
+      // exercise
+      try
+      {
+         for (; i < 1000; i++)
+            s.push(i);
+      }
+      catch (const std::bad_alloc &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(s.size() == (size_t)i);
+      assertUnit(s.top() == i - 1);
+   }  // teardown
+
+   // a copy that throws while the buffer grows leaves the stack
+   // alone and gives the new buffer back
+   void test_push_throwWhileGrowing()
+   {  // setup
+      Counting arena;
+      {
+         custom::arena_stack <Fragile> s(&arena);
+         s.reserve(4);
+         for (int i = 0; i < 4; i++)
+            s.push(Fragile(i));
+         Fragile value(4);
+         Fragile::numLeft = 3;             // the new one and two old ones
+         bool thrown = false;
+         // exercise
+         try
+         {
+            s.push(value);
+         }
+         catch (int)
+         {
+            thrown = true;
+         }
+         // verify
+         assertUnit(thrown);
+         assertUnit(Fragile::numLive == 5); // four in the stack and value
+         assertUnit(s.size() == 4);
+         assertUnit(s.capacity() == 4);
+         assertUnit(s.top().value == 3);
+         assertUnit(arena.numAllocate == arena.numDeallocate + 1);
+         Fragile::numLeft = -1;
+      }
+      assertUnit(Fragile::numLive == 0);
+      assertUnit(arena.numAllocate == arena.numDeallocate);
+   }  // teardown
+
+   // reserve takes one allocation for the whole request
+   void test_reserve_once()
+   {  // setup
+      Counting arena;
+      custom::arena_stack <int> s(&arena);
+      // exercise
+      s.reserve(500);
+      for (int i = 0; i < 500; i++)
+         s.push(i);
+      // verify
+      assertUnit(arena.numAllocate == 1);
+      assertUnit(s.capacity() == 500);
+      assertUnit(s.top() == 499);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop several at once, never past the bottom
+   void test_popN_standard()
+   {  // setup
+      custom::arena_stack <int> s;
+      for (int i = 0; i < 10; i++)
+         s.push(i);
+      // exercise
+      s.pop_n(4);
+      size_t sizeAfterFour = s.size();
+      int topAfterFour = s.top();
+      s.pop_n(100);
+      // verify
+      assertUnit(sizeAfterFour == 6);
+      assertUnit(topAfterFour == 5);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // the next request reuses the buffer without allocating
+   void test_reset_keepsBuffer()
+   {  // setup
+      Counting arena;
+      custom::arena_stack <int> s(&arena);
+      for (int i = 0; i < 300; i++)
+         s.push(i);
+      int * data = s.data;
+      size_t numAllocate = arena.numAllocate;
+      // exercise
+      s.reset();
+      for (int i = 0; i < 300; i++)
+         s.push(i);
+      // verify
+      assertUnit(s.data == data);
+      assertUnit(arena.numAllocate == numAllocate);
+      assertUnit(s.size() == 300);
+   }  // teardown
+
+   // reset still runs the destructors when there are any
+   void test_reset_destroys()
+   {  // setup
+      custom::arena_stack <Spy> s;
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+      Spy::reset();
+      // exercise
+      s.reset();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(s.empty());
+      assertUnit(s.capacity() > 0);
+   }  // teardown
+
+   /*************************************************************
+    * COUNTING
+    * A resource that hands out heap memory and counts how many
+    * times it was asked
+    *************************************************************/
+   struct Counting : public std::pmr::memory_resource
+   {
+      Counting() : numAllocate(0), numDeallocate(0) {}
+      size_t numAllocate;
+      size_t numDeallocate;
+
+   private:
+      void * do_allocate(size_t num, size_t alignment) override
+      {
+         numAllocate++;
+         return std::pmr::new_delete_resource()->allocate(num, alignment);
+      }
+      void do_deallocate(void * p, size_t num, size_t alignment) override
+      {
+         numDeallocate++;
+         std::pmr::new_delete_resource()->deallocate(p, num, alignment);
+      }
+      bool do_is_equal(const std::pmr::memory_resource & rhs) const noexcept override
+      {
+         return this == &rhs;
+      }
+   };
+
+   /*************************************************************
+    * FRAGILE
+    * A value whose copy and move throw once numLeft of them have
+    * been made, and which counts how many are alive.  Its move is
+    * not noexcept, so growing the stack copies it.
+    *************************************************************/
+   struct Fragile
+   {
+      Fragile(int value) : value(value) { numLive++; }
+      Fragile(const Fragile & rhs) : value(rhs.value) { spend(); numLive++; }
+      Fragile(Fragile && rhs)      : value(rhs.value) { spend(); numLive++; }
+      ~Fragile() { numLive--; }
+      int value;
+
+      static void spend()
+      {
+         if (numLeft == 0)
+            throw 0;
+         if (numLeft > 0)
+            numLeft--;
+      }
+      static inline int numLeft = -1;   // -1 for no limit
+      static inline int numLive = 0;
+   };
+};
+
+#endif // DEBUG
@@ -0,0 +1,383 @@
+/***********************************************************************
+ * Header:
+ *    TEST CHUNKED STACK
+ * Summary:
+ *    Unit tests for chunked stack
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "chunkedStack.h"
+#include "stack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+
+class TestChunkedStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+
+      // Assign
+      test_assignCopy_fullToFull();
+      test_swap_emptyToFull();
+
+      // Insert
+      test_push_empty();
+      test_push_acrossBlock();
+      test_emplace_acrossBlock();
+
+      // Remove
+      test_pop_empty();
+      test_pop_acrossBlock();
+      test_pushPop_oscillate();
+      test_clear_standard();
+
+      // Container
+      test_stack_onChunks();
+
+      report("ChunkedStack");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no blocks
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::chunked_stack<Spy, 2> s;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertEmptyFixture(s);
+   }  // teardown
+
+   // copy keeps every element in the same slot
+   void test_constructCopy_standard()
+   {  // setup
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> sSrc;
+      setupStandardFixture(sSrc);
+      Spy::reset();
+      // exercise
+      custom::chunked_stack<Spy, 2> sDest(sSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [26,49,67]
+      assertUnit(Spy::numAlloc() == 3);     // allocate [26,49,67]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(sDest.pTop != sSrc.pTop);
+      assertUnit(sDest.pSpare == nullptr);
+      assertStandardFixture(sSrc);
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   // move takes the blocks
+   void test_constructMove_standard()
+   {  // setup
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> sSrc;
+      setupStandardFixture(sSrc);
+      void * pTop = sSrc.pTop;
+      Spy::reset();
+      // exercise
+      custom::chunked_stack<Spy, 2> sDest(std::move(sSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(sDest.pTop == pTop);
+      assertEmptyFixture(sSrc);
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // copy a full stack onto one that is not empty
+   void test_assignCopy_fullToFull()
+   {  // setup
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> sSrc;
+      setupStandardFixture(sSrc);
+      //    +----+----+
+      //    | 11 |    |
+      //    +----+----+
+      custom::chunked_stack<Spy, 2> sDes;
+      sDes.push(Spy(11));
+      Spy::reset();
+      // exercise
+      sDes = sSrc;
+      // verify
+      assertUnit(Spy::numCopy() == 3);       // copy [26,49,67]
+      assertUnit(Spy::numDestructor() == 1); // [11]
+      assertUnit(Spy::numDelete() == 1);     // [11]
+      assertStandardFixture(sSrc);
+      assertStandardFixture(sDes);
+   }  // teardown
+
+   // swap an empty stack with a full one
+   void test_swap_emptyToFull()
+   {  // setup
+      custom::chunked_stack<Spy, 2> s1;
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> s2;
+      setupStandardFixture(s2);
+      Spy::reset();
+      // exercise
+      s1.swap(s2);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertStandardFixture(s1);
+      assertEmptyFixture(s2);
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push onto an empty stack, adding the first block
+   void test_push_empty()
+   {  // setup
+      custom::chunked_stack<Spy, 2> s;
+      Spy::reset();
+      // exercise
+      s.push(Spy(26));
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create [26]
+      assertUnit(Spy::numCopyMove() == 1);   // move [26]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(s.size() == 1);
+      assertUnit(s.pTop != nullptr);
+      if (s.pTop)
+         assertUnit(s.pTop->pBelow == nullptr);
+      assertUnit(s.numInTop == 1);
+      assertUnit(s.top() == Spy(26));
+   }  // teardown
+
+   // pushing past a full block adds a block and moves nothing
+   void test_push_acrossBlock()
+   {  // setup
+      //    +----+----+
+      //    | 26 | 49 |
+      //    +----+----+
+      custom::chunked_stack<Spy, 2> s;
+      s.push(Spy(26));
+      s.push(Spy(49));
+      Spy * p49 = &s.top();
+      auto * pBottom = s.pTop;
+      Spy value(67);
+      Spy::reset();
+      // exercise
+      s.push(value);
+      // verify
+      assertUnit(Spy::numCopy() == 1);       // copy [67]
+      assertUnit(Spy::numAlloc() == 1);      // allocate [67]
+      assertUnit(Spy::numCopyMove() == 0);   // [26,49] stay where they are
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s.pTop != pBottom);
+      if (s.pTop)
+         assertUnit(s.pTop->pBelow == pBottom);
+      if (pBottom)
+         assertUnit(&pBottom->slot(1) == p49);
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      assertStandardFixture(s);
+   }  // teardown
+
+   // build a value in a new block without moving anything
+   void test_emplace_acrossBlock()
+   {  // setup
+      //    +----+----+
+      //    | 26 | 49 |
+      //    +----+----+
+      custom::chunked_stack<Spy, 2> s;
+      s.push(Spy(26));
+      s.push(Spy(49));
+      Spy::reset();
+      // exercise
+      s.emplace(67);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create [67] in place
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      assertStandardFixture(s);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop from an empty stack does nothing
+   void test_pop_empty()
+   {  // setup
+      custom::chunked_stack<Spy, 2> s;
+      Spy::reset();
+      // exercise
+      s.pop();
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertEmptyFixture(s);
+   }  // teardown
+
+   // popping the last element of a block keeps it as the spare
+   void test_pop_acrossBlock()
+   {  // setup
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> s;
+      setupStandardFixture(s);
+      auto * pTop = s.pTop;
+      Spy::reset();
+      // exercise
+      s.pop();
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // [67]
+      assertUnit(Spy::numDelete() == 1);     // [67]
+      assertUnit(s.pSpare == pTop);
+      assertUnit(s.pTop != pTop);
+      assertUnit(s.numInTop == 2);
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == Spy(49));
+   }  // teardown
+
+   // going back and forth over a boundary reuses the spare
+   void test_pushPop_oscillate()
+   {  // setup
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> s;
+      setupStandardFixture(s);
+      auto * pTop = s.pTop;
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         s.pop();
+         s.push(Spy(67));
+      }
+      // verify
+      assertUnit(s.pTop == pTop);            // the same block every time
+      assertUnit(s.pSpare == nullptr);
+      assertStandardFixture(s);
+   }  // teardown
+
+   // clear keeps one block to start over with
+   void test_clear_standard()
+   {  // setup
+      //    +----+----+   +----+----+
+      //    | 26 | 49 | - | 67 |    |
+      //    +----+----+   +----+----+
+      custom::chunked_stack<Spy, 2> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3); // [26,49,67]
+      assertUnit(Spy::numDelete() == 3);     // [26,49,67]
+      assertUnit(s.pSpare != nullptr);
+      assertEmptyFixture(s);
+   }  // teardown
+
+   /***************************************
+    * CONTAINER
+    ***************************************/
+
+   // a custom::stack can sit on top of the chunks
+   void test_stack_onChunks()
+   {  // setup
+      custom::stack<Spy, custom::chunked_stack<Spy, 2> > s;
+      // exercise
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+      s.pop();
+      // verify
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == Spy(49));
+      assertUnit(!s.empty());
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+----+   +----+----+
+    *    | 26 | 49 | - | 67 |    |
+    *    +----+----+   +----+----+
+    *************************************************************/
+   void setupStandardFixture(custom::chunked_stack<Spy, 2> & s)
+   {
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+   }
+
+   /*************************************************************
+    * VERIFY EMPTY FIXTURE
+    *************************************************************/
+   void assertEmptyFixtureParameters(const custom::chunked_stack<Spy, 2> & s, int line, const char* function)
+   {
+      assertIndirect(s.empty());
+      assertIndirect(s.size() == 0);
+      assertIndirect(s.pTop == nullptr);
+      assertIndirect(s.numInTop == 0);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    +----+----+   +----+----+
+    *    | 26 | 49 | - | 67 |    |
+    *    +----+----+   +----+----+
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::chunked_stack<Spy, 2> & s, int line, const char* function)
+   {
+      assertIndirect(s.size() == 3);
+      assertIndirect(s.numInTop == 1);
+      assertIndirect(s.pTop != nullptr);
+      if (s.pTop)
+      {
+         assertIndirect(s.pTop->slot(0) == Spy(67));
+         assertIndirect(s.pTop->pBelow != nullptr);
+         if (s.pTop->pBelow)
+         {
+            assertIndirect(s.pTop->pBelow->slot(0) == Spy(26));
+            assertIndirect(s.pTop->pBelow->slot(1) == Spy(49));
+            assertIndirect(s.pTop->pBelow->pBelow == nullptr);
+         }
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,220 @@
+/***********************************************************************
+ * Header:
+ *    TEST FLAT COMBINING
+ * Summary:
+ *    Unit tests for flat combining
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "flatCombining.h"
+#include "stack.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class TestFlatCombining : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // One thread
+      test_apply_direct();
+      test_pushPop_lifo();
+      test_tryPop_empty();
+      test_apply_throws();
+
+      // Threads
+      test_threads_pushThenPop();
+      test_threads_mixed();
+
+      report("FlatCombining");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // an empty stack and no records claimed
+   void test_construct_default()
+   {  // exercise
+      custom::flat_combining <custom::stack <int> > s;
+      // verify
+      assertUnit(s.container.empty());
+      assertUnit(!s.combining.load());
+      assertUnit(numClaimed(s) == 0);
+   }  // teardown
+
+   /***************************************
+    * ONE THREAD
+    ***************************************/
+
+   // with nobody else around the caller combines its own operation
+   void test_apply_direct()
+   {  // setup
+      custom::flat_combining <custom::stack <int> > s;
+      // exercise
+      s.apply([](custom::stack <int> & c) { c.push(26); c.push(49); });
+      // verify
+      assertUnit(s.container.size() == 2);
+      assertUnit(s.container.top() == 49);
+      assertUnit(!s.combining.load());
+      assertUnit(numClaimed(s) == 0);
+   }  // teardown
+
+   // push and try_pop on the wrapped stack
+   void test_pushPop_lifo()
+   {  // setup
+      custom::flat_combining <custom::stack <int> > s;
+      int v1 = 0, v2 = 0;
+      // exercise
+      s.push(26);
+      s.push(49);
+      bool p1 = s.try_pop(v1);
+      bool p2 = s.try_pop(v2);
+      // verify
+      assertUnit(p1 && p2);
+      assertUnit(v1 == 49);
+      assertUnit(v2 == 26);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // nothing to pop leaves the value alone
+   void test_tryPop_empty()
+   {  // setup
+      custom::flat_combining <custom::stack <int> > s;
+      int value = 99;
+      // exercise
+      bool popped = s.try_pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(value == 99);
+   }  // teardown
+
+   // an exception comes back to the caller and the combiner is released
+   void test_apply_throws()
+   {  // setup
+      custom::flat_combining <custom::stack <int> > s;
+      bool caught = false;
+      // exercise
+      try
+      {
+         s.apply([](custom::stack <int> &) { throw std::runtime_error("apply"); });
+      }
+      catch (const std::runtime_error &)
+      {
+         caught = true;
+      }
+      s.push(26);
+      // verify
+      assertUnit(caught);
+      assertUnit(!s.combining.load());
+      assertUnit(numClaimed(s) == 0);
+      assertUnit(s.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // every value pushed by any thread is popped exactly once
+   void test_threads_pushThenPop()
+   {  // setup
+      const int NUM_THREADS = 8;
+      const int NUM_EACH = 5000;
+      custom::flat_combining <custom::stack <int> > s;
+      std::vector <std::atomic <int> > seen(NUM_THREADS * NUM_EACH);
+      for (auto & count : seen)
+         count.store(0);
+      std::vector <std::thread> threads;
+      // exercise
+      for (int t = 0; t < NUM_THREADS; t++)
+         threads.push_back(std::thread([&s, t, NUM_EACH]()
+         {
+            for (int i = 0; i < NUM_EACH; i++)
+               s.push(t * NUM_EACH + i);
+         }));
+      for (auto & thread : threads)
+         thread.join();
+      size_t sizeFull = s.size();
+      threads.clear();
+      for (int t = 0; t < NUM_THREADS; t++)
+         threads.push_back(std::thread([&s, &seen]()
+         {
+            int value;
+            while (s.try_pop(value))
+               seen[value]++;
+         }));
+      for (auto & thread : threads)
+         thread.join();
+      // verify
+      int numWrong = 0;
+      for (auto & count : seen)
+         if (count.load() != 1)
+            numWrong++;
+      assertUnit(sizeFull == (size_t)(NUM_THREADS * NUM_EACH));
+      assertUnit(numWrong == 0);
+      assertUnit(s.empty());
+      assertUnit(numClaimed(s) == 0);
+   }  // teardown
+
+   // pushes and pops from many threads at once balance out
+   void test_threads_mixed()
+   {  // setup
+      const int NUM_THREADS = 16;
+      const int NUM_EACH = 2000;
+      custom::flat_combining <custom::stack <int> > s;
+      std::atomic <long long> sumPushed(0);
+      std::atomic <long long> sumPopped(0);
+      std::vector <std::thread> threads;
+      // exercise
+      for (int t = 0; t < NUM_THREADS; t++)
+         threads.push_back(std::thread([&s, &sumPushed, &sumPopped, t, NUM_EACH]()
+         {
+            int value;
+            for (int i = 0; i < NUM_EACH; i++)
+            {
+               s.push(i + t);
+               sumPushed += i + t;
+               if (i % 2 && s.try_pop(value))
+                  sumPopped += value;
+            }
+         }));
+      for (auto & thread : threads)
+         thread.join();
+      int value;
+      while (s.try_pop(value))
+         sumPopped += value;
+      // verify
+      assertUnit(sumPopped.load() == sumPushed.load());
+      assertUnit(s.container.empty());
+   }  // teardown
+
+   /*************************************************************
+    * NUM CLAIMED
+    * How many records are still held by a thread
+    *************************************************************/
+   template <class Container, size_t NUM_RECORDS>
+   static int numClaimed(custom::flat_combining <Container, NUM_RECORDS> & s)
+   {
+      int num = 0;
+      for (auto & record : s.records)
+         if (record.inUse.load())
+            num++;
+      return num;
+   }
+};
+
+#endif // DEBUG
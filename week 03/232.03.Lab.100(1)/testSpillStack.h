@@ -0,0 +1,331 @@
+/***********************************************************************
+ * Header:
+ *    TEST SPILL STACK
+ * Summary:
+ *    Unit tests for spill stack
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "spillStack.h"
+#include "stack.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+class TestSpillStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_spilled();
+      test_constructMove_spilled();
+
+      // Insert
+      test_push_inMemory();
+      test_push_spill();
+
+      // Remove
+      test_pop_fetchAll();
+      test_pop_readAhead();
+      test_pop_fetchFails();
+      test_pushPop_oscillate();
+      test_clear_reuse();
+      test_pushPop_random();
+
+      // Container
+      test_stack_onSpill();
+
+      report("SpillStack");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no blocks and no file
+   void test_construct_default()
+   {  // exercise
+      custom::spill_stack <int, 2, 4> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.pFile == nullptr);
+      assertUnit(s.numHot == 0);
+      for (size_t i = 0; i < 4; i++)
+         assertUnit(s.ring[i] == nullptr);
+   }  // teardown
+
+   // a copy gets its own file with the same blocks in it
+   void test_constructCopy_spilled()
+   {  // setup
+      custom::spill_stack <int, 2, 4> sSrc;
+      for (int i = 0; i < 20; i++)
+         sSrc.push(i);
+      // exercise
+      custom::spill_stack <int, 2, 4> sDest(sSrc);
+      // verify
+      assertUnit(sDest.size() == 20);
+      assertUnit(sDest.pFile != nullptr);
+      assertUnit(sDest.pFile != sSrc.pFile);
+      assertUnit(sDest.stats().numOnDisk == 6);
+      assertUnit(sDest.stats().numSpilled == 0);
+      assertUnit(popAll(sDest) == 20);
+      assertUnit(sSrc.size() == 20);
+      assertUnit(popAll(sSrc) == 20);
+   }  // teardown
+
+   // a move takes the file along
+   void test_constructMove_spilled()
+   {  // setup
+      custom::spill_stack <int, 2, 4> sSrc;
+      for (int i = 0; i < 20; i++)
+         sSrc.push(i);
+      std::FILE * pFile = sSrc.pFile;
+      // exercise
+      custom::spill_stack <int, 2, 4> sDest(std::move(sSrc));
+      // verify
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.pFile == nullptr);
+      assertUnit(sDest.pFile == pFile);
+      assertUnit(sDest.stats().numSpilled == 6);
+      assertUnit(popAll(sDest) == 20);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // K full blocks fit without touching the disk
+   void test_push_inMemory()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      // exercise
+      for (int i = 0; i < 8; i++)
+         s.push(i);
+      // verify
+      //    +---+---+ +---+---+ +---+---+ +---+---+
+      //    | 0 | 1 | | 2 | 3 | | 4 | 5 | | 6 | 7 |
+      //    +---+---+ +---+---+ +---+---+ +---+---+
+      assertUnit(s.size() == 8);
+      assertUnit(s.top() == 7);
+      assertUnit(s.numHot == 4);
+      assertUnit(s.numInTop == 2);
+      assertUnit(s.pFile == nullptr);
+      assertUnit(s.stats().numSpilled == 0);
+   }  // teardown
+
+   // one more block sends the lowest to the file
+   void test_push_spill()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      for (int i = 0; i < 8; i++)
+         s.push(i);
+      // exercise
+      s.push(8);
+      // verify
+      //    disk          memory
+      //    +---+---+     +---+---+ +---+---+ +---+---+ +---+---+
+      //    | 0 | 1 |     | 2 | 3 | | 4 | 5 | | 6 | 7 | | 8 |   |
+      //    +---+---+     +---+---+ +---+---+ +---+---+ +---+---+
+      assertUnit(s.size() == 9);
+      assertUnit(s.top() == 8);
+      assertUnit(s.pFile != nullptr);
+      assertUnit(s.iBottom == 1);
+      assertUnit(s.numHot == 4);
+      assertUnit(s.numInTop == 1);
+      assertUnit(s.stats().numSpilled == 1);
+      assertUnit(s.stats().numOnDisk == 1);
+      assertUnit(s.stats().numInMemory == 4);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // everything spilled comes back, in order
+   void test_pop_fetchAll()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      for (int i = 0; i < 20; i++)
+         s.push(i);
+      // exercise
+      int numRight = popAll(s);
+      // verify
+      assertUnit(numRight == 20);
+      assertUnit(s.empty());
+      assertUnit(s.stats().numSpilled == 6);
+      assertUnit(s.stats().numFetched == 6);
+      assertUnit(s.stats().numOnDisk == 0);
+   }  // teardown
+
+   // emptying all but one block in memory reads K/2 back
+   void test_pop_readAhead()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      for (int i = 0; i < 20; i++)
+         s.push(i);
+      // exercise
+      s.pop_n(5);
+      int numFetchedBefore = (int)s.stats().numFetched;
+      s.pop();
+      // verify
+      assertUnit(numFetchedBefore == 0);
+      assertUnit(s.size() == 14);
+      assertUnit(s.top() == 13);
+      assertUnit(s.numHot == 3);
+      assertUnit(s.numInTop == 2);
+      assertUnit(s.stats().numFetched == 2);
+      assertUnit(s.stats().numOnDisk == 4);
+   }  // teardown
+
+   // a read that fails leaves the stack as it was
+   void test_pop_fetchFails()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      for (int i = 0; i < 20; i++)
+         s.push(i);
+      s.pop_n(5);
+      std::FILE * pFile = s.pFile;
+      s.pFile = std::tmpfile();            // empty, so every read comes up short
+      bool thrown = false;
+      // exercise
+      try
+      {
+         s.pop();
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(s.size() == 15);
+      assertUnit(s.top() == 14);
+      assertUnit(s.numHot == 2);
+      assertUnit(s.numInTop == 1);
+      assertUnit(s.stats().numFetched == 0);
+      assertUnit(s.stats().numOnDisk == 6);
+      std::fclose(s.pFile);
+      s.pFile = pFile;
+      assertUnit(popAll(s) == 15);          // the real file still works
+   }  // teardown
+
+   // going back and forth across the spill point writes once
+   void test_pushPop_oscillate()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      for (int i = 0; i < 9; i++)
+         s.push(i);
+      // exercise
+      for (int i = 0; i < 100; i++)
+      {
+         s.pop();
+         s.push(i);
+      }
+      // verify
+      assertUnit(s.size() == 9);
+      assertUnit(s.top() == 99);
+      assertUnit(s.stats().numSpilled == 1);
+      assertUnit(s.stats().numFetched == 0);
+   }  // teardown
+
+   // clear drops the file contents but keeps the buffers
+   void test_clear_reuse()
+   {  // setup
+      custom::spill_stack <int, 2, 4> s;
+      for (int i = 0; i < 20; i++)
+         s.push(i);
+      // exercise
+      s.clear();
+      s.push(26);
+      s.push(49);
+      s.push(67);
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit(s.stats().numOnDisk == 0);
+      assertUnit(s.stats().numInMemory == 2);
+      assertUnit(s.top() == 67);
+      s.pop();
+      assertUnit(s.top() == 49);
+      s.pop();
+      assertUnit(s.top() == 26);
+   }  // teardown
+
+   // a long run of pushes and pops matches a vector
+   void test_pushPop_random()
+   {  // setup
+      custom::spill_stack <int, 3, 4> s;
+      std::vector <int> model;
+      unsigned int seed = 4321;
+      int numWrong = 0;
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         seed = seed * 1103515245u + 12345u;
+         if ((seed >> 8) % 5 < 3 || model.empty())
+         {
+            s.push(i);
+            model.push_back(i);
+         }
+         else
+         {
+            s.pop();
+            model.pop_back();
+         }
+         if (s.size() != model.size() || (!model.empty() && s.top() != model.back()))
+            numWrong++;
+      }
+      // verify
+      assertUnit(numWrong == 0);
+      assertUnit(s.stats().numSpilled > 0);
+      assertUnit(s.stats().numFetched > 0);
+   }  // teardown
+
+   /***************************************
+    * CONTAINER
+    ***************************************/
+
+   // a custom::stack can keep its elements in a spill_stack
+   void test_stack_onSpill()
+   {  // setup
+      custom::stack <int, custom::spill_stack <int, 2, 4> > s;
+      // exercise
+      for (int i = 0; i < 20; i++)
+         s.push(i);
+      s.pop();
+      // verify
+      assertUnit(s.size() == 19);
+      assertUnit(s.top() == 18);
+   }  // teardown
+
+   /*************************************************************
+    * POP ALL
+    * Pop everything, counting the values that come off in the
+    * order 0 ... n-1 was pushed
+    *************************************************************/
+   template <size_t N, size_t K>
+   static int popAll(custom::spill_stack <int, N, K> & s)
+   {
+      int numRight = 0;
+      for (int expected = (int)s.size() - 1; expected >= 0; expected--)
+      {
+         if (s.top() == expected)
+            numRight++;
+         s.pop();
+      }
+      return numRight;
+   }
+};
+
+#endif // DEBUG
@@ -12,8 +12,13 @@
 #endif
  //#undef DEBUG  // Remove this comment to disable unit tests
 
-#include "testStack.h"       // for the stack unit tests
-#include "testSpy.h"         // for the spy unit tests
+#include "testStack.h"          // for the stack unit tests
+#include "testChunkedStack.h"   // for the chunked stack unit tests
+#include "testAggregateStack.h" // for the aggregate stack unit tests
+#include "testSpillStack.h"     // for the spill stack unit tests
+#include "testArenaStack.h"     // for the arena stack unit tests
+#include "testFlatCombining.h"  // for the flat combining unit tests
+#include "testSpy.h"            // for the spy unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -26,6 +31,11 @@ int main()
    // unit tests
    TestSpy().run();
    TestStack().run();
+   TestChunkedStack().run();
+   TestAggregateStack().run();
+   TestSpillStack().run();
+   TestArenaStack().run();
+   TestFlatCombining().run();
 #endif // DEBUG
   
    return 0;
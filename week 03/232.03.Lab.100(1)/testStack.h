@@ -37,6 +37,9 @@ public:
       test_constructMove_empty();
       test_constructMove_standard();
       test_constructMove_partiallyFilled();
+      test_constructContainer_copy();
+      test_constructContainer_move();
+      test_container_stdVector();
       test_destructor_empty();
       test_destructor_standard();
       test_destructor_partiallyFilled();
@@ -66,11 +69,19 @@ public:
       test_pushCopy_standard();
       test_pushMove_empty();
       test_pushMove_standard();
+      test_emplace_empty();
+      test_emplace_standard();
+      test_pushRange_empty();
+      test_pushRange_standard();
+      test_pushRange_repeated();
+      test_reserve_empty();
 
       // Delete
       test_pop_empty();
       test_pop_standard();
       test_pop_single_element();
+      test_popN_standard();
+      test_popN_tooMany();
 
       // Status
       test_size_empty();
@@ -386,6 +397,69 @@ public:
       teardownStandardFixture(sDest);
    }
 
+   /***************************************
+    * CONSTRUCTOR - Container
+    ***************************************/
+
+   // copy a filled container into a stack
+   void test_constructContainer_copy()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v { Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      custom::stack<Spy> s(v);
+      // verify
+      assertUnit(Spy::numCopy() == 4);      // copy [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);     // allocate [26,49,67,89]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.size() == 4);
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // move a filled container into a stack, taking its buffer
+   void test_constructContainer_move()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v { Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      custom::stack<Spy> s(std::move(v));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 0);
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // the same stack on a different backing store
+   void test_container_stdVector()
+   {  // setup
+      custom::stack<Spy, std::vector<Spy> > s;
+      // exercise
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+      s.pop();
+      // verify
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == Spy(49));
+      assertUnit(s.container.size() == 2);
+      assertUnit(!s.empty());
+   }  // teardown
+
 
    /***************************************
  * ASSIGN COPY
@@ -1060,6 +1134,152 @@ public:
       teardownStandardFixture(s);
    }
 
+   // build a value right on top of an empty stack
+   void test_emplace_empty()
+   {  // setup
+      custom::stack<Spy> s;
+      Spy::reset();
+      // exercise
+      s.emplace(26);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create [26] in place
+      assertUnit(Spy::numAlloc() == 1);      // allocate [26]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //    +----+
+      //    | 26 |
+      //    +----+
+      assertUnit(s.container.size() == 1);
+      assertUnit(s.container.capacity() == 1);
+      if (s.container.size() >= 1)
+         assertUnit(s.container[0] == Spy(26));
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // build a value on top of a stack with room for it
+   void test_emplace_standard()
+   {  // setup
+      //    +----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |    |    |
+      //    +----+----+----+----+----+----+
+      custom::stack<Spy> s;
+      setupStandardFixture(s);
+      s.container.reserve(6);
+      Spy::reset();
+      // exercise
+      s.emplace(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create [99] in place
+      assertUnit(Spy::numAlloc() == 1);      // allocate [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //    +----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 99 |    |
+      //    +----+----+----+----+----+----+
+      assertUnit(s.container.size() == 5);
+      assertUnit(s.container.capacity() == 6);
+      if (s.container.size() >= 5)
+      {
+         assertUnit(s.container[3] == Spy(89));
+         assertUnit(s.container[4] == Spy(99));
+      }
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // push a range onto an empty stack, growing just once
+   void test_pushRange_empty()
+   {  // setup
+      Spy rg[] = { Spy(26), Spy(49), Spy(67), Spy(89) };
+      custom::stack<Spy> s;
+      Spy::reset();
+      // exercise
+      s.push_range(rg, rg + 4);
+      // verify
+      assertUnit(Spy::numCopy() == 4);      // copy [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);     // allocate [26,49,67,89]
+      assertUnit(Spy::numCopyMove() == 0);  // never grew after the first time
+      assertUnit(Spy::numDestructor() == 0);
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // push a range onto a full stack
+   void test_pushRange_standard()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::stack<Spy> s;
+      setupStandardFixture(s);
+      custom::vector<Spy> v { Spy(11), Spy(99) };
+      Spy::reset();
+      // exercise
+      s.push_range(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numCopy() == 2);      // copy [11,99]
+      assertUnit(Spy::numCopyMove() == 4);  // one move of [26,49,67,89]
+      assertUnit(Spy::numDestructor() == 4);
+      //    +----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 11 | 99 |    |    |
+      //    +----+----+----+----+----+----+----+----+
+      assertUnit(s.container.size() == 6);
+      assertUnit(s.container.capacity() == 8);  // doubled, not just enough
+      assertUnit(s.top() == Spy(99));
+      if (s.container.size() >= 6)
+      {
+         assertUnit(s.container[0] == Spy(26));
+         assertUnit(s.container[3] == Spy(89));
+         assertUnit(s.container[4] == Spy(11));
+      }
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // many short ranges still grow the container by doubling
+   void test_pushRange_repeated()
+   {  // setup
+      custom::stack<int> s;
+      int rg[] = { 26, 49 };
+      int numGrow = 0;
+      // exercise
+      for (int i = 0; i < 500; i++)
+      {
+         size_t capacity = s.capacity();
+         s.push_range(rg, rg + 2);
+         if (s.capacity() != capacity)
+            numGrow++;
+      }
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(numGrow <= 10);            // 2, 4, 8, ... 1024
+      assertUnit(s.top() == 49);
+   }  // teardown
+
+   // reserve room on an empty stack
+   void test_reserve_empty()
+   {  // setup
+      custom::stack<Spy> s;
+      Spy::reset();
+      // exercise
+      s.reserve(10);
+      // verify
+      assertUnit(Spy::numDefault() == 0);   // the room holds nothing yet
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(s.capacity() == 10);
+      assertUnit(s.size() == 0);
+      assertUnit(s.empty());
+   }  // teardown
+
 
    /***************************************
     * PUSH - MOVE
@@ -1230,6 +1450,53 @@ public:
        teardownStandardFixture(s);
    }
 
+   // pop several at once, keeping the buffer
+   void test_popN_standard()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::stack<Spy> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      s.pop_n(3);
+      // verify
+      assertUnit(Spy::numDestructor() == 3); // [49,67,89]
+      assertUnit(Spy::numDelete() == 3);     // [49,67,89]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      //    +----+----+----+----+
+      //    | 26 |    |    |    |
+      //    +----+----+----+----+
+      assertUnit(s.size() == 1);
+      assertUnit(s.capacity() == 4);
+      assertUnit(s.top() == Spy(26));
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // asking to pop more than there are empties the stack
+   void test_popN_tooMany()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::stack<Spy> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      s.pop_n(10);
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // [26,49,67,89]
+      assertUnit(s.size() == 0);
+      assertUnit(s.empty());
+      assertUnit(s.capacity() == 4);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
    
    /*************************************************************
     * SETUP STANDARD FIXTURE
@@ -0,0 +1,220 @@
+/***********************************************************************
+ * Program:
+ *    Benchmark LRU Cache
+ * Summary:
+ *    Driver to time lru_cache and sharded_lru_cache.  Every cache runs
+ *    the same skewed (Zipf) trace of keys: a get, and a put on a miss.
+ *    For each it reports the hit rate and how many operations a second
+ *    it sustained.  The single-threaded cache is compared against the
+ *    hand-rolled std::list + std::unordered_map cache it replaces, and
+ *    the sharded cache against one lru_cache behind one mutex.
+ *
+ *    This is not part of the unit tests.  Build it on its own with
+ *    optimization, e.g.
+ *       g++ -std=c++17 -O2 -pthread benchLruCache.cpp
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#include <algorithm>      // for std::lower_bound
+#include <chrono>         // for std::chrono::steady_clock
+#include <cmath>          // for std::pow
+#include <cstdio>         // for printf
+#include <list>           // for std::list
+#include <mutex>          // for std::mutex
+#include <thread>         // for std::thread
+#include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::pair
+#include <vector>         // for std::vector
+#include "lruCache.h"     // for lru_cache and sharded_lru_cache
+
+const size_t NUM_KEYS = 100000;     // distinct keys in the trace
+const size_t NUM_OPS  = 4000000;    // lookups in the trace
+const double SKEW     = 0.99;       // Zipf exponent: higher is more skewed
+
+/*************************************************
+ * REFERENCE LRU
+ * What we hand-rolled before: a recency list plus an
+ * unordered_map into it, two allocations per entry
+ *************************************************/
+class ReferenceLru
+{
+public:
+   ReferenceLru(size_t capacity) : numCapacity(capacity), numHits(0), numMisses(0) {}
+
+   bool get(int key, int & value)
+   {
+      auto it = index.find(key);
+      if (it == index.end())
+      {
+         numMisses++;
+         return false;
+      }
+      recency.splice(recency.begin(), recency, it->second);
+      value = it->second->second;
+      numHits++;
+      return true;
+   }
+
+   void put(int key, int value)
+   {
+      auto it = index.find(key);
+      if (it != index.end())
+      {
+         it->second->second = value;
+         recency.splice(recency.begin(), recency, it->second);
+         return;
+      }
+      if (index.size() == numCapacity)
+      {
+         index.erase(recency.back().first);
+         recency.pop_back();
+      }
+      recency.emplace_front(key, value);
+      index[key] = recency.begin();
+   }
+
+   double hitRate() const
+   {
+      size_t numLookups = numHits + numMisses;
+      return numLookups == 0 ? 0.0 : (double)numHits / (double)numLookups;
+   }
+
+private:
+   size_t                                                       numCapacity;
+   size_t                                                       numHits;
+   size_t                                                       numMisses;
+   std::list <std::pair <int, int> >                            recency;
+   std::unordered_map <int, std::list <std::pair <int, int> >::iterator> index;
+};
+
+/*************************************************
+ * LOCKED LRU
+ * One lru_cache behind one mutex: what sharding
+ * is meant to beat
+ *************************************************/
+class LockedLru
+{
+public:
+   LockedLru(size_t capacity) : cache(capacity) {}
+
+   bool get(int key, int & value)
+   {
+      std::lock_guard <std::mutex> guard(lock);
+      return cache.get(key, value);
+   }
+   void put(int key, int value)
+   {
+      std::lock_guard <std::mutex> guard(lock);
+      cache.put(key, value);
+   }
+   double hitRate() const { return cache.hitRate(); }
+
+private:
+   std::mutex                  lock;
+   custom::lru_cache <int, int> cache;
+};
+
+/*************************************************
+ * MAKE TRACE
+ * NUM_OPS keys drawn from a Zipf distribution over
+ * NUM_KEYS, so a few keys are hot and most are cold
+ *************************************************/
+std::vector <int> makeTrace()
+{
+   std::vector <double> cdf(NUM_KEYS);
+   double sum = 0.0;
+   for (size_t i = 0; i < NUM_KEYS; i++)
+      cdf[i] = (sum += 1.0 / std::pow((double)(i + 1), SKEW));
+
+   std::vector <int> trace(NUM_OPS);
+   unsigned long long seed = 88172645463325252ull;
+   for (size_t i = 0; i < NUM_OPS; i++)
+   {
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      double target = (double)(seed >> 11) / (double)(1ull << 53) * sum;
+      trace[i] = (int)(std::lower_bound(cdf.begin(), cdf.end(), target) - cdf.begin());
+   }
+   return trace;
+}
+
+/*************************************************
+ * RUN
+ * Play keys [iBegin, iEnd) of the trace against the
+ * cache: get, and put on a miss
+ *************************************************/
+template <class Cache>
+void run(Cache & cache, const std::vector <int> & trace, size_t iBegin, size_t iEnd)
+{
+   int value;
+   for (size_t i = iBegin; i < iEnd; i++)
+      if (!cache.get(trace[i], value))
+         cache.put(trace[i], trace[i]);
+}
+
+/*************************************************
+ * MEASURE
+ * Run the whole trace split over numThreads threads
+ * and print the hit rate and throughput
+ *************************************************/
+template <class Cache>
+void measure(const char * name, Cache & cache, const std::vector <int> & trace, size_t numThreads)
+{
+   auto begin = std::chrono::steady_clock::now();
+   std::vector <std::thread> threads;
+   for (size_t t = 0; t < numThreads; t++)
+      threads.push_back(std::thread([&cache, &trace, t, numThreads]()
+      {
+         run(cache, trace, trace.size() * t / numThreads, trace.size() * (t + 1) / numThreads);
+      }));
+   for (auto & thread : threads)
+      thread.join();
+   auto end = std::chrono::steady_clock::now();
+
+   double seconds = std::chrono::duration <double>(end - begin).count();
+   printf("   %-22s %2d thread%s  hit rate %5.1f%%  %7.2f M ops/s\n",
+          name, (int)numThreads, numThreads == 1 ? " " : "s",
+          100.0 * cache.hitRate(), (double)trace.size() / seconds / 1e6);
+}
+
+/**********************************************************************
+ * MAIN
+ * Each capacity is a fraction of the key space
+ ***********************************************************************/
+int main()
+{
+   std::vector <int> trace = makeTrace();
+   size_t capacities[] = { NUM_KEYS / 100, NUM_KEYS / 10 };
+   size_t numHardware = std::thread::hardware_concurrency();
+   if (numHardware == 0)
+      numHardware = 4;
+
+   for (size_t capacity : capacities)
+   {
+      printf("capacity %d of %d keys, %d lookups\n",
+             (int)capacity, (int)NUM_KEYS, (int)NUM_OPS);
+      {
+         ReferenceLru cache(capacity);
+         measure("list + unordered_map", cache, trace, 1);
+      }
+      {
+         custom::lru_cache <int, int> cache(capacity);
+         measure("lru_cache", cache, trace, 1);
+      }
+      for (size_t numThreads = 2; numThreads <= numHardware; numThreads *= 2)
+      {
+         {
+            LockedLru cache(capacity);
+            measure("lru_cache + mutex", cache, trace, numThreads);
+         }
+         {
+            custom::sharded_lru_cache <int, int> cache(capacity);
+            measure("sharded_lru_cache", cache, trace, numThreads);
+         }
+      }
+   }
+
+   return 0;
+}
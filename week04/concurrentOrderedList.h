@@ -0,0 +1,302 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT ORDERED LIST
+ * Summary:
+ *    A sorted linked list that many threads can read and change at
+ *    once.  Instead of one lock for the whole list, every node has its
+ *    own lock, so threads working on different parts of the list do not
+ *    get in each other's way.  There are two ways to find a spot:
+ *
+ *       COUPLING   : hand-over-hand.  Lock the next node before letting
+ *                    go of the current one.  Simple, but every reader
+ *                    takes every lock on the way.
+ *       OPTIMISTIC : walk the list with no locks at all, lock only the
+ *                    two nodes at the spot, then make sure neither was
+ *                    removed in the meantime.  Retry if one was.
+ *                    contains() takes no locks.
+ *
+ *    Removed nodes are retired through epoch-based reclamation since
+ *    an optimistic reader may still be looking at them.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_ordered_list : a thread-safe sorted set
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>      // for std::atomic
+#include <functional>  // for std::less
+#include <mutex>       // for std::mutex
+#include "ebr.h"       // for ebr::guard and ebr::retire
+
+class TestConcurrentOrderedList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * CONCURRENT ORDERED LIST
+ * A sorted set of unique values guarded by
+ * one lock per node
+ *************************************************/
+template <class T, class Compare = std::less <T> >
+class concurrent_ordered_list
+{
+   friend class ::TestConcurrentOrderedList; // give unit tests access to the privates
+public:
+   enum Mode { COUPLING, OPTIMISTIC };
+
+   //
+   // Construct
+   //
+
+   concurrent_ordered_list(Mode mode = COUPLING, const Compare & compare = Compare()) :
+      mode(mode), numElements(0), compare(compare) {}
+   concurrent_ordered_list(const concurrent_ordered_list & rhs) = delete;
+   concurrent_ordered_list & operator = (const concurrent_ordered_list & rhs) = delete;
+   ~concurrent_ordered_list();
+
+   //
+   // Access
+   //
+
+   bool contains(const T & t);
+
+   //
+   // Insert
+   //
+
+   bool insert(const T & t);
+
+   //
+   // Remove
+   //
+
+   bool remove(const T & t);
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements.load();      }
+   bool   empty() const { return numElements.load() == 0; }
+
+private:
+
+   struct ListNode;
+
+   /*************************************************
+    * LINK
+    * The part of a node that a neighbor points to.
+    * The head of the list is a bare Link with no data.
+    *************************************************/
+   struct Link
+   {
+      Link() : pNext(nullptr), marked(false) {}
+
+      std::mutex               lock;
+      std::atomic <ListNode *> pNext;
+      std::atomic <bool>       marked;   // set once the node is unlinked
+   };
+
+   struct ListNode : public Link
+   {
+      ListNode(const T & t) : data(t) {}
+      T data;
+   };
+
+   void lockCoupling  (const T & t, Link * & pPred, ListNode * & pCurr);
+   void lockOptimistic(const T & t, Link * & pPred, ListNode * & pCurr);
+   void lockSpot      (const T & t, Link * & pPred, ListNode * & pCurr)
+   {
+      if (mode == COUPLING)
+         lockCoupling(t, pPred, pCurr);
+      else
+         lockOptimistic(t, pPred, pCurr);
+   }
+
+   static void unlock(Link * pPred, ListNode * pCurr)
+   {
+      if (pCurr)
+         pCurr->lock.unlock();
+      pPred->lock.unlock();
+   }
+
+   bool isEqual(const ListNode * pCurr, const T & t) const
+   {
+      return pCurr != nullptr && !compare(t, pCurr->data);
+   }
+
+   Link                  head;         // points to the smallest value
+   Mode                  mode;         // how to find a spot in the list
+   std::atomic <size_t>  numElements;  // the number of values in the list
+   Compare               compare;      // the ordering of the list
+};
+
+/*****************************************
+ * CONCURRENT ORDERED LIST :: DESTRUCTOR
+ * No other thread can be using the list now
+ ****************************************/
+template <class T, class Compare>
+concurrent_ordered_list <T, Compare> :: ~concurrent_ordered_list()
+{
+   ListNode * p = head.pNext.load();
+   while (p != nullptr)
+   {
+      ListNode * pDelete = p;
+      p = p->pNext.load();
+      delete pDelete;
+   }
+}
+
+/*****************************************
+ * CONCURRENT ORDERED LIST :: LOCK COUPLING
+ * Walk hand-over-hand from the head to the first node
+ * not less than t.
+ *   OUTPUT : pPred - the node before the spot, locked
+ *            pCurr - the first node not less than t,
+ *                    locked (or nullptr at the end)
+ ****************************************/
+template <class T, class Compare>
+void concurrent_ordered_list <T, Compare> :: lockCoupling(const T & t,
+                                                          Link * & pPred,
+                                                          ListNode * & pCurr)
+{
+   pPred = &head;
+   pPred->lock.lock();
+   pCurr = pPred->pNext.load();
+   while (pCurr != nullptr)
+   {
+      pCurr->lock.lock();
+      if (!compare(pCurr->data, t))
+         return;
+      pPred->lock.unlock();
+      pPred = pCurr;
+      pCurr = pCurr->pNext.load();
+   }
+}
+
+/*****************************************
+ * CONCURRENT ORDERED LIST :: LOCK OPTIMISTIC
+ * Walk without locks, then lock the two nodes at the
+ * spot.  The spot is still good if neither node has
+ * been removed and they are still next to each other.
+ * The caller must be pinned so nodes we pass over are
+ * not freed under us.
+ *   OUTPUT : same as lockCoupling()
+ ****************************************/
+template <class T, class Compare>
+void concurrent_ordered_list <T, Compare> :: lockOptimistic(const T & t,
+                                                            Link * & pPred,
+                                                            ListNode * & pCurr)
+{
+   for (;;)
+   {
+      pPred = &head;
+      pCurr = pPred->pNext.load();
+      while (pCurr != nullptr && compare(pCurr->data, t))
+      {
+         pPred = pCurr;
+         pCurr = pCurr->pNext.load();
+      }
+
+      pPred->lock.lock();
+      if (pCurr)
+         pCurr->lock.lock();
+
+      if (!pPred->marked.load() &&
+          (pCurr == nullptr || !pCurr->marked.load()) &&
+          pPred->pNext.load() == pCurr)
+         return;
+
+      unlock(pPred, pCurr);
+   }
+}
+
+/*****************************************
+ * CONCURRENT ORDERED LIST :: CONTAINS
+ * Is t in the list?  In optimistic mode this takes no
+ * locks: a node that is reachable and not marked is in
+ * the list.
+ *   COST   : O(n)
+ ****************************************/
+template <class T, class Compare>
+bool concurrent_ordered_list <T, Compare> :: contains(const T & t)
+{
+   ebr::guard guard;
+
+   if (mode == OPTIMISTIC)
+   {
+      ListNode * pCurr = head.pNext.load();
+      while (pCurr != nullptr && compare(pCurr->data, t))
+         pCurr = pCurr->pNext.load();
+      return isEqual(pCurr, t) && !pCurr->marked.load();
+   }
+
+   Link * pPred;
+   ListNode * pCurr;
+   lockCoupling(t, pPred, pCurr);
+   bool found = isEqual(pCurr, t);
+   unlock(pPred, pCurr);
+   return found;
+}
+
+/*****************************************
+ * CONCURRENT ORDERED LIST :: INSERT
+ * Put t in its sorted spot if it is not there already
+ *   OUTPUT : whether t was added
+ *   COST   : O(n)
+ ****************************************/
+template <class T, class Compare>
+bool concurrent_ordered_list <T, Compare> :: insert(const T & t)
+{
+   ebr::guard guard;
+   Link * pPred;
+   ListNode * pCurr;
+   lockSpot(t, pPred, pCurr);
+
+   bool added = !isEqual(pCurr, t);
+   if (added)
+   {
+      ListNode * pNew = new ListNode(t);
+      pNew->pNext.store(pCurr);
+      pPred->pNext.store(pNew);
+      numElements++;
+   }
+
+   unlock(pPred, pCurr);
+   return added;
+}
+
+/*****************************************
+ * CONCURRENT ORDERED LIST :: REMOVE
+ * Take t out of the list.  The node is marked before it
+ * is unlinked so optimistic threads can tell.
+ *   OUTPUT : whether t was removed
+ *   COST   : O(n)
+ ****************************************/
+template <class T, class Compare>
+bool concurrent_ordered_list <T, Compare> :: remove(const T & t)
+{
+   ebr::guard guard;
+   Link * pPred;
+   ListNode * pCurr;
+   lockSpot(t, pPred, pCurr);
+
+   bool removed = isEqual(pCurr, t);
+   if (removed)
+   {
+      pCurr->marked.store(true);
+      pPred->pNext.store(pCurr->pNext.load());
+      numElements--;
+   }
+
+   unlock(pPred, pCurr);
+   if (removed)
+      ebr::retire(pCurr);
+   return removed;
+}
+
+} // namespace custom
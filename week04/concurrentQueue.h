@@ -0,0 +1,218 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT QUEUE
+ * Summary:
+ *    A lock-free queue (Michael and Scott's algorithm).  The queue is a
+ *    singly-linked chain that always starts with a dummy node; push
+ *    links onto the tail and pop advances the head.  A lagging tail is
+ *    helped along by whichever thread notices it.  Old dummy nodes are
+ *    freed through hazard pointers.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_queue       : a thread-safe, lock-free queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>           // for std::atomic
+#include <new>              // for placement new
+#include <utility>          // for std::move
+#include "hazardPointer.h"  // for hazard_pointer and retire
+
+class TestConcurrentQueue; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * CONCURRENT QUEUE
+ * First-in-First-out, safe to share between threads
+ *************************************************/
+template <class T>
+class concurrent_queue
+{
+   friend class ::TestConcurrentQueue; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   concurrent_queue();
+   concurrent_queue(const concurrent_queue & rhs) = delete;
+   concurrent_queue & operator = (const concurrent_queue & rhs) = delete;
+   ~concurrent_queue();
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { pushNode(new QueueNode(t));            }
+   void push(      T && t) { pushNode(new QueueNode(std::move(t))); }
+
+   //
+   // Remove
+   //
+
+   bool pop(T & t);
+
+   //
+   // Status
+   //
+
+   bool empty() const;
+
+private:
+
+   /*************************************************
+    * QUEUE NODE
+    * Singly linked with an atomic link.  The data is
+    * constructed by push and destroyed by the pop that
+    * turns the node into the new dummy, so the dummy
+    * never needs a T.
+    *************************************************/
+   struct QueueNode
+   {
+      QueueNode() : pNext(nullptr) {}
+      QueueNode(const T &  t) : pNext(nullptr) { new (storage) T(t);            }
+      QueueNode(      T && t) : pNext(nullptr) { new (storage) T(std::move(t)); }
+
+      T & data() { return *reinterpret_cast<T *>(storage); }
+
+      alignas(T) unsigned char   storage[sizeof(T)];
+      std::atomic <QueueNode *>  pNext;
+   };
+
+   void pushNode(QueueNode * pNew);
+
+   std::atomic <QueueNode *> pHead;   // the dummy node
+   std::atomic <QueueNode *> pTail;   // the last node, or close to it
+};
+
+/*****************************************
+ * CONCURRENT QUEUE :: CONSTRUCTOR
+ * Start with just the dummy node
+ ****************************************/
+template <class T>
+concurrent_queue <T> :: concurrent_queue()
+{
+   QueueNode * pDummy = new QueueNode;
+   pHead.store(pDummy);
+   pTail.store(pDummy);
+}
+
+/*****************************************
+ * CONCURRENT QUEUE :: DESTRUCTOR
+ * Everything after the dummy still holds a value
+ ****************************************/
+template <class T>
+concurrent_queue <T> :: ~concurrent_queue()
+{
+   QueueNode * p = pHead.load();
+   QueueNode * pNext = p->pNext.load();
+   delete p;
+   while (pNext != nullptr)
+   {
+      p = pNext;
+      pNext = p->pNext.load();
+      p->data().~T();
+      delete p;
+   }
+}
+
+/*****************************************
+ * CONCURRENT QUEUE :: PUSH NODE
+ * Link the new node after the tail, then try to swing
+ * the tail to it.  If the tail is lagging, help it
+ * forward first.
+ *   COST   : O(1), lock-free
+ ****************************************/
+template <class T>
+void concurrent_queue <T> :: pushNode(QueueNode * pNew)
+{
+   hazard_pointer hp;
+   for (;;)
+   {
+      QueueNode * pLast = hp.protect(pTail);
+      QueueNode * pNext = pLast->pNext.load();
+      if (pLast != pTail.load())
+         continue;
+
+      if (pNext != nullptr)
+      {
+         pTail.compare_exchange_strong(pLast, pNext);
+         continue;
+      }
+
+      if (pLast->pNext.compare_exchange_strong(pNext, pNew))
+      {
+         pTail.compare_exchange_strong(pLast, pNew);
+         return;
+      }
+   }
+}
+
+/*****************************************
+ * CONCURRENT QUEUE :: POP
+ * Advance the head to the first real node, which
+ * becomes the new dummy once we have moved its value out.
+ *   OUTPUT : t - the value at the front of the queue
+ *            return false if the queue was empty
+ *   COST   : O(1), lock-free
+ ****************************************/
+template <class T>
+bool concurrent_queue <T> :: pop(T & t)
+{
+   hazard_pointer hpHead;
+   hazard_pointer hpNext;
+   for (;;)
+   {
+      QueueNode * pFirst = hpHead.protect(pHead);
+      QueueNode * pLast  = pTail.load();
+      QueueNode * pNext  = pFirst->pNext.load();
+      hpNext.set(pNext);
+      if (pFirst != pHead.load())
+         continue;
+
+      if (pNext == nullptr)
+         return false;
+
+      // the tail is behind; help it along before we move past it
+      if (pFirst == pLast)
+      {
+         pTail.compare_exchange_strong(pLast, pNext);
+         continue;
+      }
+
+      if (pHead.compare_exchange_strong(pFirst, pNext))
+      {
+         // only this thread can reach the value in pNext now
+         t = std::move(pNext->data());
+         pNext->data().~T();
+         hpHead.reset();
+         hpNext.reset();
+         retire(pFirst);
+         return true;
+      }
+   }
+}
+
+/*****************************************
+ * CONCURRENT QUEUE :: EMPTY
+ * Nothing after the dummy.  The dummy is protected
+ * before we look at its link since a pop could free
+ * it out from under us.  Already stale when it returns
+ * if others are busy.
+ *   COST   : O(1), lock-free
+ ****************************************/
+template <class T>
+bool concurrent_queue <T> :: empty() const
+{
+   hazard_pointer hp;
+   QueueNode * pFirst = hp.protect(pHead);
+   return pFirst->pNext.load() == nullptr;
+}
+
+} // namespace custom
@@ -0,0 +1,259 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT STACK
+ * Summary:
+ *    A lock-free stack (Treiber's algorithm).  The top of the stack is
+ *    a single atomic pointer to a chain of nodes, so push and pop are a
+ *    compare-and-swap on that pointer.  Popped nodes are freed through
+ *    hazard pointers so a thread still reading one is never left with
+ *    a dangling pointer.
+ *
+ *    When the CAS on the top fails, the thread backs off to an
+ *    elimination array instead of retrying at once.  A push leaves its
+ *    node in a random slot for a moment; a pop that finds it there takes
+ *    it directly.  The pair cancels out without touching the top, so
+ *    under heavy contention most operations never meet at one pointer.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_stack       : a thread-safe, lock-free stack
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>           // for std::atomic
+#include <cstddef>          // for size_t
+#include <utility>          // for std::move
+#include "hazardPointer.h"  // for hazard_pointer and retire
+
+class TestConcurrentStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * CONCURRENT STACK
+ * First-in-Last-out, safe to share between threads
+ *************************************************/
+template <class T>
+class concurrent_stack
+{
+   friend class ::TestConcurrentStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   concurrent_stack() : pTop(nullptr)
+   {
+      for (size_t i = 0; i < NUM_SLOTS; i++)
+         slots[i].pOffer.store(nullptr);
+   }
+   concurrent_stack(const concurrent_stack & rhs) = delete;
+   concurrent_stack & operator = (const concurrent_stack & rhs) = delete;
+   ~concurrent_stack();
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { pushNode(new StackNode(t));            }
+   void push(      T && t) { pushNode(new StackNode(std::move(t))); }
+
+   //
+   // Remove
+   //
+
+   bool pop(T & t);
+
+   //
+   // Status
+   //
+
+   bool empty() const { return pTop.load() == nullptr; }
+
+private:
+
+   /*************************************************
+    * STACK NODE
+    * Like Node, but singly linked with an atomic link
+    *************************************************/
+   struct StackNode
+   {
+      StackNode(const T &  data) : data(data),            pNext(nullptr) {}
+      StackNode(      T && data) : data(std::move(data)), pNext(nullptr) {}
+
+      T                          data;
+      std::atomic <StackNode *>  pNext;
+   };
+
+   /*************************************************
+    * SLOT
+    * One place in the elimination array.  Each gets a
+    * cache line so threads meeting in different slots
+    * do not slow each other down.
+    *************************************************/
+   struct alignas(64) Slot
+   {
+      std::atomic <StackNode *> pOffer;   // a node a push is waiting to hand over
+   };
+
+   static const size_t NUM_SLOTS = 8;     // the width of the elimination array
+   static const int    NUM_SPINS = 128;   // how long to wait in a slot
+
+   void        pushNode(StackNode * pNew);
+   bool        eliminatePush(StackNode * pNew, size_t iSlot);
+   StackNode * eliminatePop(size_t iSlot);
+   static size_t randomSlot();
+
+   std::atomic <StackNode *> pTop;               // the most recently pushed node
+   Slot                      slots[NUM_SLOTS];   // where collisions are eliminated
+};
+
+/*****************************************
+ * CONCURRENT STACK :: DESTRUCTOR
+ * No other thread can be using the stack now
+ ****************************************/
+template <class T>
+concurrent_stack <T> :: ~concurrent_stack()
+{
+   StackNode * p = pTop.load();
+   while (p != nullptr)
+   {
+      StackNode * pDelete = p;
+      p = p->pNext.load();
+      delete pDelete;
+   }
+}
+
+/*****************************************
+ * CONCURRENT STACK :: PUSH NODE
+ * Point the new node at the current top and swing
+ * the top over to it, retrying if someone beat us
+ *   COST   : O(1), lock-free
+ ****************************************/
+template <class T>
+void concurrent_stack <T> :: pushNode(StackNode * pNew)
+{
+   StackNode * pOld = pTop.load();
+   for (;;)
+   {
+      pNew->pNext.store(pOld);
+      if (pTop.compare_exchange_strong(pOld, pNew))
+         return;
+      if (eliminatePush(pNew, randomSlot()))
+         return;
+      pOld = pTop.load();
+   }
+}
+
+/*****************************************
+ * CONCURRENT STACK :: POP
+ * Take the top off the stack.  The top is protected by
+ * a hazard pointer while we read its pNext, which also
+ * keeps the CAS safe from the ABA problem.
+ *   OUTPUT : t - the value on the top of the stack
+ *            return false if the stack was empty
+ *   COST   : O(1), lock-free
+ ****************************************/
+template <class T>
+bool concurrent_stack <T> :: pop(T & t)
+{
+   hazard_pointer hp;
+   StackNode * pOld;
+   for (;;)
+   {
+      pOld = hp.protect(pTop);
+      if (pOld == nullptr)
+         return false;
+      if (pTop.compare_exchange_strong(pOld, pOld->pNext.load()))
+         break;
+
+      // lost the race: see if a push is waiting to hand one over
+      pOld = eliminatePop(randomSlot());
+      if (pOld != nullptr)
+         break;
+   }
+   hp.reset();
+
+   // only this thread can reach the data now
+   t = std::move(pOld->data);
+   retire(pOld);
+   return true;
+}
+
+/*****************************************
+ * CONCURRENT STACK :: ELIMINATE PUSH
+ * Offer pNew in a slot and wait a moment for a pop to
+ * take it.  pNew is held by a hazard pointer the whole
+ * time: once a pop takes it the pop retires it, and the
+ * hazard keeps its address from being reused (and
+ * offered again) while we are still watching the slot.
+ *   INPUT  : pNew  - the node to hand over
+ *            iSlot - which slot to try
+ *   OUTPUT : true if a pop took it; the push is done
+ *   COST   : O(NUM_SPINS), lock-free
+ ****************************************/
+template <class T>
+bool concurrent_stack <T> :: eliminatePush(StackNode * pNew, size_t iSlot)
+{
+   Slot & slot = slots[iSlot];
+   hazard_pointer hp;
+   hp.set(pNew);
+
+   StackNode * pEmpty = nullptr;
+   if (!slot.pOffer.compare_exchange_strong(pEmpty, pNew))
+      return false;
+
+   for (int i = 0; i < NUM_SPINS; i++)
+      if (slot.pOffer.load() != pNew)
+         return true;
+
+   // take the offer back, unless a pop gets there first
+   StackNode * pMine = pNew;
+   return !slot.pOffer.compare_exchange_strong(pMine, nullptr);
+}
+
+/*****************************************
+ * CONCURRENT STACK :: ELIMINATE POP
+ * Wait a moment for a push to offer a node in a slot
+ * and take it.  The node is never looked at before the
+ * CAS succeeds, and after that only this thread has it.
+ *   INPUT  : iSlot - which slot to try
+ *   OUTPUT : the node taken, nullptr if none came
+ *   COST   : O(NUM_SPINS), lock-free
+ ****************************************/
+template <class T>
+typename concurrent_stack <T> :: StackNode *
+concurrent_stack <T> :: eliminatePop(size_t iSlot)
+{
+   Slot & slot = slots[iSlot];
+   for (int i = 0; i < NUM_SPINS; i++)
+   {
+      StackNode * pOffer = slot.pOffer.load();
+      if (pOffer != nullptr && slot.pOffer.compare_exchange_strong(pOffer, nullptr))
+         return pOffer;
+   }
+   return nullptr;
+}
+
+/*****************************************
+ * CONCURRENT STACK :: RANDOM SLOT
+ * Spread colliding threads over the array.  Each
+ * thread has its own xorshift generator.
+ ****************************************/
+template <class T>
+size_t concurrent_stack <T> :: randomSlot()
+{
+   static thread_local unsigned int seed = 0;
+   if (seed == 0)
+      seed = (unsigned int)(size_t)&seed | 1u;
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return seed % NUM_SLOTS;
+}
+
+} // namespace custom
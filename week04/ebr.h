@@ -0,0 +1,277 @@
+/***********************************************************************
+ * Header:
+ *    EBR
+ * Summary:
+ *    Epoch-based reclamation for lock-free linked structures.  Readers
+ *    pin the current epoch before they touch shared nodes and unpin when
+ *    they are done.  Writers unlink a node and retire it instead of
+ *    deleting it.  The global epoch only advances when every pinned
+ *    thread has caught up to it, so a node retired in epoch e can be
+ *    freed once the global epoch reaches e + 2: by then no thread that
+ *    could have seen the node is still pinned.
+ *
+ *    Compared to hazard pointers, readers pay one store per operation
+ *    instead of one per node, which suits long traversals.
+ *
+ *    This will contain the class definition of:
+ *        ebr::guard             : pins the epoch for its lifetime (RAII)
+ *        ebr::retire()          : hand an unlinked node to the reclaimer
+ *        ebr::collect()         : try to advance the epoch and free nodes
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>      // for std::atomic
+#include <cassert>     // for ASSERT
+#include <cstdint>     // for uint64_t
+#include <mutex>       // for std::mutex
+#include <vector>      // for std::vector
+
+class TestEbr; // forward declaration for unit tests
+
+namespace custom
+{
+namespace ebr
+{
+
+const size_t COLLECT_THRESHOLD = 64;   // retires between collections
+
+/*****************************************
+ * RECORD
+ * The epoch a thread is pinned in.  The low bit is
+ * set while the thread is pinned, the rest is the
+ * epoch it saw.  Records are reused, never freed.
+ ****************************************/
+struct Record
+{
+   Record() : local(0), active(true), pNext(nullptr) {}
+
+   std::atomic <uint64_t> local;
+   std::atomic <bool>     active;
+   Record *               pNext;
+};
+
+/*****************************************
+ * RETIRED
+ * A node waiting to be freed, how to free it,
+ * and the epoch it was retired in
+ ****************************************/
+struct Retired
+{
+   void *   p;
+   void   (*deleter)(void *);
+   uint64_t epoch;
+};
+
+/*****************************************
+ * DOMAIN
+ * The global epoch, every registered thread,
+ * and nodes left behind by threads that exited
+ ****************************************/
+class Domain
+{
+public:
+   static Domain & instance()
+   {
+      // never destroyed so threads exiting after main() can still use it
+      static Domain * pDomain = new Domain;
+      return *pDomain;
+   }
+
+   uint64_t epoch() const { return global.load(); }
+
+   Record * acquire()
+   {
+      for (Record * p = pRecords.load(); p != nullptr; p = p->pNext)
+      {
+         bool inactive = false;
+         if (!p->active.load() && p->active.compare_exchange_strong(inactive, true))
+            return p;
+      }
+
+      Record * pNew = new Record;
+      pNew->pNext = pRecords.load();
+      while (!pRecords.compare_exchange_weak(pNew->pNext, pNew))
+         ;
+      return pNew;
+   }
+
+   void release(Record * pRecord)
+   {
+      pRecord->local.store(0);
+      pRecord->active.store(false);
+   }
+
+   // advance the epoch if every pinned thread has seen the current one
+   bool tryAdvance()
+   {
+      uint64_t current = global.load();
+      for (Record * p = pRecords.load(); p != nullptr; p = p->pNext)
+      {
+         uint64_t local = p->local.load();
+         if ((local & 1) && (local >> 1) != current)
+            return false;
+      }
+      return global.compare_exchange_strong(current, current + 1);
+   }
+
+   // free everything in retired that is two epochs old
+   void reclaim(std::vector <Retired> & retired)
+   {
+      {
+         std::lock_guard <std::mutex> guard(lockOrphans);
+         retired.insert(retired.end(), orphans.begin(), orphans.end());
+         orphans.clear();
+      }
+
+      uint64_t current = global.load();
+      size_t numKeep = 0;
+      for (size_t i = 0; i < retired.size(); i++)
+      {
+         if (retired[i].epoch + 2 <= current)
+            retired[i].deleter(retired[i].p);
+         else
+            retired[numKeep++] = retired[i];
+      }
+      retired.resize(numKeep);
+   }
+
+   void adopt(std::vector <Retired> & retired)
+   {
+      std::lock_guard <std::mutex> guard(lockOrphans);
+      orphans.insert(orphans.end(), retired.begin(), retired.end());
+      retired.clear();
+   }
+
+private:
+   Domain() : global(0), pRecords(nullptr) {}
+
+   std::atomic <uint64_t> global;      // the current epoch
+   std::atomic <Record *> pRecords;    // every record ever created
+   std::mutex             lockOrphans; // protects orphans
+   std::vector <Retired>  orphans;     // retired by threads that exited
+};
+
+/*****************************************
+ * THREAD STATE
+ * The thread is registered the first time it pins or
+ * retires and unregistered when it exits.
+ ****************************************/
+struct ThreadState
+{
+   ThreadState() : pRecord(Domain::instance().acquire()), depth(0) {}
+   ~ThreadState()
+   {
+      Domain::instance().release(pRecord);
+      Domain::instance().reclaim(retired);
+      if (!retired.empty())
+         Domain::instance().adopt(retired);
+   }
+
+   Record *              pRecord;
+   int                   depth;     // how many guards are alive
+   std::vector <Retired> retired;
+};
+
+inline ThreadState & threadState()
+{
+   thread_local ThreadState state;
+   return state;
+}
+
+/*****************************************
+ * PIN / UNPIN
+ * Announce that this thread is reading shared nodes.
+ * Pins nest; only the outermost one does any work.
+ ****************************************/
+inline void pin()
+{
+   ThreadState & state = threadState();
+   if (state.depth++ == 0)
+   {
+      uint64_t epoch = Domain::instance().epoch();
+      state.pRecord->local.store((epoch << 1) | 1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+   }
+}
+
+inline void unpin()
+{
+   ThreadState & state = threadState();
+   assert(state.depth > 0);
+   if (--state.depth == 0)
+      state.pRecord->local.store(0, std::memory_order_release);
+}
+
+inline bool isPinned()
+{
+   return threadState().depth > 0;
+}
+
+/*****************************************
+ * GUARD
+ * Keep this thread pinned for the guard's lifetime
+ ****************************************/
+class guard
+{
+public:
+   guard()  { pin();   }
+   ~guard() { unpin(); }
+   guard(const guard & rhs) = delete;
+   guard & operator = (const guard & rhs) = delete;
+};
+
+/*****************************************
+ * COLLECT
+ * Try to move the epoch forward, then free every node
+ * this thread retired at least two epochs ago.
+ *   OUTPUT : how many retired nodes are still waiting
+ ****************************************/
+inline size_t collect()
+{
+   ThreadState & state = threadState();
+   Domain::instance().tryAdvance();
+   Domain::instance().reclaim(state.retired);
+   return state.retired.size();
+}
+
+/*****************************************
+ * RETIRE
+ * pRetire has been unlinked and no new reader can
+ * reach it.  Free it once every reader that might
+ * still hold it has unpinned.
+ *   INPUT  : pRetire - the node to free
+ *            deleter - how to free it
+ *   COST   : O(1) amortized
+ ****************************************/
+inline void retire(void * pRetire, void (*deleter)(void *))
+{
+   ThreadState & state = threadState();
+   Retired retired = { pRetire, deleter, Domain::instance().epoch() };
+   state.retired.push_back(retired);
+   if (state.retired.size() % COLLECT_THRESHOLD == 0)
+      collect();
+}
+
+template <class T>
+inline void retire(T * pRetire)
+{
+   retire(pRetire, [](void * p) { delete static_cast<T *>(p); });
+}
+
+/*****************************************
+ * SYNCHRONIZE
+ * Free everything this thread has retired.  Must not be
+ * called while pinned, or it could wait on itself.
+ ****************************************/
+inline void synchronize()
+{
+   assert(!isPinned());
+   while (collect() != 0)
+      ;
+}
+
+} // namespace ebr
+} // namespace custom
@@ -0,0 +1,256 @@
+/***********************************************************************
+ * Header:
+ *    FORWARD LIST
+ * Summary:
+ *    A singly linked list built on ForwardNode, similar to
+ *    std::forward_list.  Everything is done from the front or relative
+ *    to the node before the spot, so no node needs a back pointer.
+ *
+ *    This will contain the class definition of:
+ *        forward_list           : A singly linked list
+ *        forward_list::iterator : An iterator through the list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>          // for ASSERT
+#include <initializer_list> // for std::initializer_list
+#include <utility>          // for std::swap
+#include "forwardNode.h"    // for ForwardNode
+
+class TestForwardList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * FORWARD LIST
+ * A list that can only be walked front to back
+ *************************************************/
+template <class T>
+class forward_list
+{
+   friend class ::TestForwardList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   forward_list() : pHead(nullptr), numElements(0) {}
+   forward_list(const forward_list &  rhs) : pHead(::copy(rhs.pHead)), numElements(rhs.numElements) {}
+   forward_list(      forward_list && rhs) : pHead(rhs.pHead),         numElements(rhs.numElements)
+   {
+      rhs.pHead = nullptr;
+      rhs.numElements = 0;
+   }
+   forward_list(const std::initializer_list <T> & il);
+   ~forward_list() { clear(); }
+
+   //
+   // Assign
+   //
+
+   forward_list & operator = (const forward_list & rhs)
+   {
+      ::assign(pHead, rhs.pHead);
+      numElements = rhs.numElements;
+      return *this;
+   }
+   forward_list & operator = (forward_list && rhs)
+   {
+      clear();
+      swap(rhs);
+      return *this;
+   }
+   void swap(forward_list & rhs)
+   {
+      std::swap(pHead, rhs.pHead);
+      std::swap(numElements, rhs.numElements);
+   }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(pHead);   }
+   iterator end()   { return iterator(nullptr); }
+
+   //
+   // Access
+   //
+
+   T & front()
+   {
+      assert(pHead != nullptr);
+      return pHead->data;
+   }
+   const T & front() const
+   {
+      assert(pHead != nullptr);
+      return pHead->data;
+   }
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  t) { linkFront(new ForwardNode <T>(t));            }
+   void push_front(      T && t) { linkFront(new ForwardNode <T>(std::move(t))); }
+   iterator insert_after(iterator it, const T &  t);
+   iterator insert_after(iterator it,       T && t);
+
+   //
+   // Remove
+   //
+
+   void pop_front();
+   iterator erase_after(iterator it);
+   void clear()
+   {
+      ::clear(pHead);
+      numElements = 0;
+   }
+
+   //
+   // Reorder
+   //
+
+   void reverse() { ::reverse(pHead); }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+private:
+
+   void linkFront(ForwardNode <T> * pNew)
+   {
+      pNew->pNext = pHead;
+      pHead = pNew;
+      numElements++;
+   }
+
+   ForwardNode <T> * pHead;        // the first node in the list
+   size_t            numElements;  // the number of nodes
+};
+
+/*************************************************
+ * FORWARD LIST ITERATOR
+ * Walk the list front to back
+ *************************************************/
+template <class T>
+class forward_list <T> :: iterator
+{
+   friend class ::TestForwardList; // give unit tests access to the privates
+   friend class forward_list;
+public:
+   iterator()                      : p(nullptr) {}
+   iterator(ForwardNode <T> * p)   : p(p)       {}
+   iterator(const iterator & rhs)  : p(rhs.p)   {}
+   iterator & operator = (const iterator & rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   bool operator != (const iterator & rhs) const { return rhs.p != p; }
+   bool operator == (const iterator & rhs) const { return rhs.p == p; }
+
+   T & operator * () { return p->data; }
+
+   iterator & operator ++ ()
+   {
+      p = p->pNext;
+      return *this;
+   }
+
+   iterator operator ++ (int postfix)
+   {
+      iterator itReturn(*this);
+      p = p->pNext;
+      return itReturn;
+   }
+
+private:
+   ForwardNode <T> * p;
+};
+
+/*****************************************
+ * FORWARD LIST :: INITIALIZER LIST CONSTRUCTOR
+ * Build the list back to front so each value goes
+ * on the front
+ ****************************************/
+template <class T>
+forward_list <T> :: forward_list(const std::initializer_list <T> & il) :
+   pHead(nullptr), numElements(0)
+{
+   for (const T * p = il.end(); p != il.begin(); )
+      push_front(*--p);
+}
+
+/*****************************************
+ * FORWARD LIST :: INSERT AFTER
+ * Put t right after the node it refers to
+ *   OUTPUT : an iterator to the new value
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+typename forward_list <T> :: iterator
+forward_list <T> :: insert_after(iterator it, const T & t)
+{
+   assert(it.p != nullptr);
+   numElements++;
+   return iterator(::insert_after(it.p, t));
+}
+
+template <class T>
+typename forward_list <T> :: iterator
+forward_list <T> :: insert_after(iterator it, T && t)
+{
+   assert(it.p != nullptr);
+   numElements++;
+   return iterator(::insert_after(it.p, std::move(t)));
+}
+
+/*****************************************
+ * FORWARD LIST :: POP FRONT
+ * Remove the first value, if there is one
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+void forward_list <T> :: pop_front()
+{
+   if (pHead == nullptr)
+      return;
+
+   ForwardNode <T> * pDelete = pHead;
+   pHead = pHead->pNext;
+   delete pDelete;
+   numElements--;
+}
+
+/*****************************************
+ * FORWARD LIST :: ERASE AFTER
+ * Remove the value after the one it refers to
+ *   OUTPUT : an iterator to the value now after it
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+typename forward_list <T> :: iterator
+forward_list <T> :: erase_after(iterator it)
+{
+   if (it.p == nullptr || it.p->pNext == nullptr)
+      return end();
+
+   numElements--;
+   return iterator(::erase_after(it.p));
+}
+
+} // namespace custom
@@ -0,0 +1,271 @@
+/***********************************************************************
+ * Header:
+ *    FORWARD NODE
+ * Summary:
+ *    One node in a singly linked list (and the functions to support
+ *    them).  This is Node without pPrev: a chain that is only ever
+ *    walked front to back does not need it, and dropping it saves a
+ *    pointer per node and a store per link update.  For an int payload
+ *    a node is 16 bytes instead of 24.
+ *
+ *    Without pPrev a node cannot unlink itself, so inserting and
+ *    erasing are done relative to the node before the spot.
+ *
+ *    This will contain the class definition of:
+ *        ForwardNode  : A class representing a singly linked node
+ *    Additionally, it will contain a few functions working on ForwardNode
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <utility>     // for std::move
+#include "nodeBlock.h" // for node_block
+
+/*************************************************
+ * FORWARD NODE
+ * Like Node, but with only a forward link
+ *************************************************/
+template <class T>
+class ForwardNode
+{
+public:
+
+   //
+   // Construct
+   //
+
+   ForwardNode()                : data(T()),             pNext(nullptr) {}
+   ForwardNode(const T &  data) : data(data),            pNext(nullptr) {}
+   ForwardNode(      T && data) : data(std::move(data)), pNext(nullptr) {}
+
+   //
+   // Allocate
+   // Same scheme as Node so a whole list can come from one block
+   //
+
+   static void * operator new(size_t size)
+   {
+      return custom::node_block <ForwardNode <T> >::allocate(size);
+   }
+   static void operator delete(void * p)
+   {
+      custom::node_block <ForwardNode <T> >::deallocate(p);
+   }
+
+   //
+   // Member variables
+   //
+
+   T data;                       // user data
+   ForwardNode <T> * pNext;      // pointer to next node
+};
+
+/******************************************************
+ * SIZE
+ * Count the nodes in the list
+ *  INPUT   : a pointer to the head of the linked list
+ *  OUTPUT  : number of nodes
+ *  COST    : O(n)
+ ********************************************************/
+template <class T>
+inline size_t size(const ForwardNode <T> * pHead)
+{
+   size_t s = 0;
+   for (auto p = pHead; p != nullptr; p = p->pNext)
+      s++;
+   return s;
+}
+
+/*****************************************************
+ * CLEAR
+ * Free all the data currently in the linked list
+ *   INPUT   : pointer to the head of the linked list
+ *   OUTPUT  : pHead set to NULL
+ *   COST    : O(n)
+ ****************************************************/
+template <class T>
+inline void clear(ForwardNode <T> * & pHead)
+{
+   while (pHead != nullptr)
+   {
+      ForwardNode <T> * pDelete = pHead;
+      pHead = pHead->pNext;
+      delete pDelete;
+   }
+}
+
+/***********************************************
+ * COPY BLOCK
+ * Copy the first num nodes of pSource into a new list
+ * held in a single allocation.
+ *   INPUT  : pSource - the list to be copied
+ *            num     - how many nodes to copy (at most size)
+ *   OUTPUT : return the new list, pTail its last node
+ *   COST   : O(num), one allocation
+ **********************************************/
+template <class T>
+inline ForwardNode <T> * copyBlock(const ForwardNode <T> * pSource, size_t num,
+                                   ForwardNode <T> * & pTail)
+{
+   pTail = nullptr;
+   if (num == 0)
+      return nullptr;
+
+   ForwardNode <T> * pBlock = custom::node_block <ForwardNode <T> >::allocate_run(num);
+
+   size_t i = 0;
+   ForwardNode <T> * pSlot = pBlock;
+   try
+   {
+      for (; i < num; i++, pSource = pSource->pNext,
+                          pSlot = custom::node_block <ForwardNode <T> >::next(pSlot))
+      {
+         ForwardNode <T> * pNew = ::new (pSlot) ForwardNode <T>(pSource->data);
+         if (pTail)
+            pTail->pNext = pNew;
+         pTail = pNew;
+      }
+   }
+   catch (...)
+   {
+      pSlot = pBlock;
+      for (size_t j = 0; j < num; j++)
+      {
+         ForwardNode <T> * pNext = custom::node_block <ForwardNode <T> >::next(pSlot);
+         if (j < i)
+            pSlot->~ForwardNode <T>();
+         custom::node_block <ForwardNode <T> >::deallocate(pSlot);
+         pSlot = pNext;
+      }
+      pTail = nullptr;
+      throw;
+   }
+
+   return pBlock;
+}
+
+/***********************************************
+ * COPY
+ * Copy the list from pSource and return the new list
+ *   INPUT  : the list to be copied
+ *   OUTPUT : return the new list
+ *   COST   : O(n), one allocation
+ **********************************************/
+template <class T>
+inline ForwardNode <T> * copy(const ForwardNode <T> * pSource)
+{
+   ForwardNode <T> * pTail;
+   return copyBlock(pSource, size(pSource), pTail);
+}
+
+/***********************************************
+ * ASSIGN
+ * Copy the values from pSource into pDestination
+ * reusing the nodes already in pDestination.  Any
+ * extra nodes needed are allocated together.
+ *   INPUT  : the list to be copied
+ *   OUTPUT : pDestination holds a copy of pSource
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline void assign(ForwardNode <T> * & pDestination, const ForwardNode <T> * pSource)
+{
+   const ForwardNode <T> * pSrc = pSource;
+   ForwardNode <T> ** ppDes = &pDestination;
+
+   // copy over the nodes we already have
+   while (pSrc != nullptr && *ppDes != nullptr)
+   {
+      (*ppDes)->data = pSrc->data;
+      ppDes = &(*ppDes)->pNext;
+      pSrc = pSrc->pNext;
+   }
+
+   // the destination ran out first: add the rest in one block
+   if (pSrc != nullptr)
+   {
+      ForwardNode <T> * pTail;
+      *ppDes = copyBlock(pSrc, size(pSrc), pTail);
+   }
+
+   // the source ran out first: free what is left over
+   else
+      clear(*ppDes);
+}
+
+/**********************************************
+ * INSERT AFTER
+ * Insert a new node holding t right after pCurrent.
+ * With no pCurrent the new node stands alone.
+ *   INPUT   : pCurrent - the node before the new one
+ *             t        - the value to be used for the new node
+ *   OUTPUT  : return the newly inserted node
+ *   COST    : O(1)
+ **********************************************/
+template <class T>
+inline ForwardNode <T> * insert_after(ForwardNode <T> * pCurrent, const T & t)
+{
+   ForwardNode <T> * pNew = new ForwardNode <T>(t);
+   if (pCurrent != nullptr)
+   {
+      pNew->pNext = pCurrent->pNext;
+      pCurrent->pNext = pNew;
+   }
+   return pNew;
+}
+
+template <class T>
+inline ForwardNode <T> * insert_after(ForwardNode <T> * pCurrent, T && t)
+{
+   ForwardNode <T> * pNew = new ForwardNode <T>(std::move(t));
+   if (pCurrent != nullptr)
+   {
+      pNew->pNext = pCurrent->pNext;
+      pCurrent->pNext = pNew;
+   }
+   return pNew;
+}
+
+/**********************************************
+ * ERASE AFTER
+ * Free the node right after pCurrent
+ *   INPUT   : pCurrent - the node before the one to free
+ *   OUTPUT  : return the node that now follows pCurrent
+ *   COST    : O(1)
+ **********************************************/
+template <class T>
+inline ForwardNode <T> * erase_after(ForwardNode <T> * pCurrent)
+{
+   if (pCurrent == nullptr || pCurrent->pNext == nullptr)
+      return nullptr;
+
+   ForwardNode <T> * pDelete = pCurrent->pNext;
+   pCurrent->pNext = pDelete->pNext;
+   delete pDelete;
+   return pCurrent->pNext;
+}
+
+/***********************************************
+ * REVERSE
+ * Turn the list around by relinking the nodes
+ *   INPUT  : pHead - the head of the list
+ *   OUTPUT : pHead set to what was the last node
+ *   COST   : O(n), no allocations
+ **********************************************/
+template <class T>
+inline void reverse(ForwardNode <T> * & pHead)
+{
+   ForwardNode <T> * pReversed = nullptr;
+   while (pHead != nullptr)
+   {
+      ForwardNode <T> * pNext = pHead->pNext;
+      pHead->pNext = pReversed;
+      pReversed = pHead;
+      pHead = pNext;
+   }
+   pHead = pReversed;
+}
@@ -0,0 +1,255 @@
+/***********************************************************************
+ * Header:
+ *    HARRIS LIST
+ * Summary:
+ *    A lock-free sorted linked list (Harris' algorithm, with Michael's
+ *    changes for safe memory reclamation).  Removing a value takes two
+ *    steps: first the low bit of the node's pNext is set to mark it as
+ *    logically deleted, then the predecessor is swung past it.  Any
+ *    thread walking the list that sees a marked node finishes the job,
+ *    so no thread ever has to wait on another.
+ *
+ *    Unlinked nodes are retired through epoch-based reclamation.  Since
+ *    nothing here is tied to one list, a hash table can use one of these
+ *    per bucket.
+ *
+ *    This will contain the class definition of:
+ *        lock_free_ordered_list : a thread-safe, lock-free sorted set
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>      // for std::atomic
+#include <cstdint>     // for uintptr_t
+#include <functional>  // for std::less
+#include <utility>     // for std::move
+#include "ebr.h"       // for ebr::guard and ebr::retire
+
+class TestHarrisList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LOCK-FREE ORDERED LIST
+ * A sorted set of unique values with no locks
+ *************************************************/
+template <class T, class Compare = std::less <T> >
+class lock_free_ordered_list
+{
+   friend class ::TestHarrisList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   lock_free_ordered_list(const Compare & compare = Compare()) :
+      head(0), numElements(0), compare(compare) {}
+   lock_free_ordered_list(const lock_free_ordered_list & rhs) = delete;
+   lock_free_ordered_list & operator = (const lock_free_ordered_list & rhs) = delete;
+   ~lock_free_ordered_list();
+
+   //
+   // Access
+   //
+
+   bool contains(const T & t) const;
+
+   //
+   // Insert
+   //
+
+   bool insert(const T &  t) { return insertNode(new ListNode(t));            }
+   bool insert(      T && t) { return insertNode(new ListNode(std::move(t))); }
+
+   //
+   // Remove
+   //
+
+   bool remove(const T & t);
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements.load();      }
+   bool   empty() const { return numElements.load() == 0; }
+
+private:
+
+   /*************************************************
+    * LIST NODE
+    * Like Node, but singly linked.  pNext holds the
+    * address of the next node with the low bit set
+    * once this node has been removed.
+    *************************************************/
+   struct ListNode
+   {
+      ListNode(const T &  data) : data(data),            pNext(0) {}
+      ListNode(      T && data) : data(std::move(data)), pNext(0) {}
+
+      T                       data;
+      std::atomic <uintptr_t> pNext;
+   };
+
+   static const uintptr_t MARK = 1;
+
+   static ListNode * address(uintptr_t link) { return reinterpret_cast<ListNode *>(link & ~MARK); }
+   static bool       isMarked(uintptr_t link) { return (link & MARK) != 0;                        }
+   static uintptr_t  linkTo(ListNode * p)     { return reinterpret_cast<uintptr_t>(p);            }
+
+   bool find(const T & t, std::atomic <uintptr_t> * & pPrev, ListNode * & pCurr);
+   bool insertNode(ListNode * pNew);
+
+   std::atomic <uintptr_t> head;         // the smallest node, never marked
+   std::atomic <size_t>    numElements;  // the number of values in the list
+   Compare                 compare;      // the ordering of the list
+};
+
+/*****************************************
+ * LOCK-FREE ORDERED LIST :: DESTRUCTOR
+ * No other thread can be using the list now.  Marked
+ * nodes that are still linked have not been retired.
+ ****************************************/
+template <class T, class Compare>
+lock_free_ordered_list <T, Compare> :: ~lock_free_ordered_list()
+{
+   ListNode * p = address(head.load());
+   while (p != nullptr)
+   {
+      ListNode * pDelete = p;
+      p = address(p->pNext.load());
+      delete pDelete;
+   }
+}
+
+/*****************************************
+ * LOCK-FREE ORDERED LIST :: FIND
+ * Walk to the first node not less than t, unlinking
+ * every marked node we pass.  If someone changes the
+ * link we are standing on, start over from the head.
+ * The caller must be pinned.
+ *   OUTPUT : pPrev - the link that points to pCurr
+ *            pCurr - the first unmarked node not less
+ *                    than t (or nullptr at the end)
+ *            return whether pCurr holds t
+ ****************************************/
+template <class T, class Compare>
+bool lock_free_ordered_list <T, Compare> :: find(const T & t,
+                                                 std::atomic <uintptr_t> * & pPrev,
+                                                 ListNode * & pCurr)
+{
+retry:
+   pPrev = &head;
+   pCurr = address(pPrev->load());
+   while (pCurr != nullptr)
+   {
+      uintptr_t next = pCurr->pNext.load();
+      if (isMarked(next))
+      {
+         // help the remover: swing pPrev past pCurr
+         uintptr_t expected = linkTo(pCurr);
+         if (!pPrev->compare_exchange_strong(expected, next & ~MARK))
+            goto retry;
+         ebr::retire(pCurr);
+         pCurr = address(next);
+         continue;
+      }
+
+      if (!compare(pCurr->data, t))
+         return !compare(t, pCurr->data);
+      pPrev = &pCurr->pNext;
+      pCurr = address(next);
+   }
+   return false;
+}
+
+/*****************************************
+ * LOCK-FREE ORDERED LIST :: CONTAINS
+ * Is t in the list?  This only reads: marked nodes are
+ * stepped over, not unlinked.
+ *   COST   : O(n), wait-free
+ ****************************************/
+template <class T, class Compare>
+bool lock_free_ordered_list <T, Compare> :: contains(const T & t) const
+{
+   ebr::guard guard;
+   ListNode * pCurr = address(head.load());
+   while (pCurr != nullptr && compare(pCurr->data, t))
+      pCurr = address(pCurr->pNext.load());
+   return pCurr != nullptr &&
+          !compare(t, pCurr->data) &&
+          !isMarked(pCurr->pNext.load());
+}
+
+/*****************************************
+ * LOCK-FREE ORDERED LIST :: INSERT NODE
+ * Link pNew into its sorted spot unless its value is
+ * already there, in which case pNew is freed.  No other
+ * thread has seen pNew, so it can be deleted directly.
+ *   OUTPUT : whether pNew was added
+ *   COST   : O(n), lock-free
+ ****************************************/
+template <class T, class Compare>
+bool lock_free_ordered_list <T, Compare> :: insertNode(ListNode * pNew)
+{
+   ebr::guard guard;
+   std::atomic <uintptr_t> * pPrev;
+   ListNode * pCurr;
+   for (;;)
+   {
+      if (find(pNew->data, pPrev, pCurr))
+      {
+         delete pNew;
+         return false;
+      }
+
+      pNew->pNext.store(linkTo(pCurr));
+      uintptr_t expected = linkTo(pCurr);
+      if (pPrev->compare_exchange_strong(expected, linkTo(pNew)))
+      {
+         numElements++;
+         return true;
+      }
+   }
+}
+
+/*****************************************
+ * LOCK-FREE ORDERED LIST :: REMOVE
+ * Take t out of the list.  Setting the mark is what
+ * removes it; unlinking is cleanup that find() will
+ * finish if our own attempt loses a race.
+ *   OUTPUT : whether t was removed by this call
+ *   COST   : O(n), lock-free
+ ****************************************/
+template <class T, class Compare>
+bool lock_free_ordered_list <T, Compare> :: remove(const T & t)
+{
+   ebr::guard guard;
+   std::atomic <uintptr_t> * pPrev;
+   ListNode * pCurr;
+   uintptr_t next;
+   for (;;)
+   {
+      if (!find(t, pPrev, pCurr))
+         return false;
+
+      next = pCurr->pNext.load();
+      if (!isMarked(next) &&
+          pCurr->pNext.compare_exchange_strong(next, next | MARK))
+         break;
+   }
+   numElements--;
+
+   uintptr_t expected = linkTo(pCurr);
+   if (pPrev->compare_exchange_strong(expected, next))
+      ebr::retire(pCurr);
+   else
+      find(t, pPrev, pCurr);
+   return true;
+}
+
+} // namespace custom
@@ -0,0 +1,265 @@
+/***********************************************************************
+ * Header:
+ *    HAZARD POINTER
+ * Summary:
+ *    Safe memory reclamation for lock-free linked structures.  A thread
+ *    that is about to dereference a shared node first publishes the
+ *    pointer in one of its hazard slots.  Unlinked nodes are retired
+ *    rather than deleted, and a retired node is only freed once no
+ *    thread has it published.
+ *
+ *    This will contain the class definition of:
+ *        hazard_pointer         : one published hazard slot (RAII)
+ *        retire()               : hand an unlinked node to the reclaimer
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>   // for std::sort, std::binary_search
+#include <atomic>      // for std::atomic
+#include <cassert>     // for ASSERT
+#include <mutex>       // for std::mutex
+#include <vector>      // for std::vector
+
+class TestHazardPointer; // forward declaration for unit tests
+
+namespace custom
+{
+namespace hazard
+{
+
+const int MAX_HAZARDS = 4;     // hazard slots per thread
+
+/*****************************************
+ * RECORD
+ * The hazard slots owned by one thread.  Records are
+ * never freed; a thread that exits gives its record
+ * back for the next thread to reuse.
+ ****************************************/
+struct Record
+{
+   Record() : active(true), pNext(nullptr)
+   {
+      for (int i = 0; i < MAX_HAZARDS; i++)
+         pHazard[i].store(nullptr);
+   }
+
+   std::atomic <bool>   active;
+   std::atomic <void *> pHazard[MAX_HAZARDS];
+   Record *             pNext;
+};
+
+/*****************************************
+ * RETIRED
+ * A node waiting to be freed and how to free it
+ ****************************************/
+struct Retired
+{
+   void * p;
+   void (*deleter)(void *);
+};
+
+/*****************************************
+ * DOMAIN
+ * Every hazard record in the program, plus the retired
+ * nodes left behind by threads that have exited.
+ ****************************************/
+class Domain
+{
+public:
+   static Domain & instance()
+   {
+      // never destroyed so threads exiting after main() can still use it
+      static Domain * pDomain = new Domain;
+      return *pDomain;
+   }
+
+   Record * acquire()
+   {
+      for (Record * p = pRecords.load(); p != nullptr; p = p->pNext)
+      {
+         bool inactive = false;
+         if (!p->active.load() && p->active.compare_exchange_strong(inactive, true))
+            return p;
+      }
+
+      Record * pNew = new Record;
+      pNew->pNext = pRecords.load();
+      while (!pRecords.compare_exchange_weak(pNew->pNext, pNew))
+         ;
+      numRecords++;
+      return pNew;
+   }
+
+   void release(Record * pRecord)
+   {
+      for (int i = 0; i < MAX_HAZARDS; i++)
+         pRecord->pHazard[i].store(nullptr);
+      pRecord->active.store(false);
+   }
+
+   // every pointer currently published by any thread
+   std::vector <void *> hazards() const
+   {
+      std::vector <void *> pointers;
+      for (Record * p = pRecords.load(); p != nullptr; p = p->pNext)
+         for (int i = 0; i < MAX_HAZARDS; i++)
+         {
+            void * pHazard = p->pHazard[i].load();
+            if (pHazard != nullptr)
+               pointers.push_back(pHazard);
+         }
+      std::sort(pointers.begin(), pointers.end());
+      return pointers;
+   }
+
+   size_t threshold() const
+   {
+      size_t num = 2 * numRecords.load() * MAX_HAZARDS;
+      return num < 64 ? 64 : num;
+   }
+
+   void adopt(std::vector <Retired> & retired)
+   {
+      std::lock_guard <std::mutex> guard(lockOrphans);
+      orphans.insert(orphans.end(), retired.begin(), retired.end());
+      retired.clear();
+   }
+
+   void reclaim(std::vector <Retired> & retired)
+   {
+      {
+         std::lock_guard <std::mutex> guard(lockOrphans);
+         retired.insert(retired.end(), orphans.begin(), orphans.end());
+         orphans.clear();
+      }
+
+      std::vector <void *> pointers = hazards();
+      size_t numKeep = 0;
+      for (size_t i = 0; i < retired.size(); i++)
+      {
+         if (std::binary_search(pointers.begin(), pointers.end(), retired[i].p))
+            retired[numKeep++] = retired[i];
+         else
+            retired[i].deleter(retired[i].p);
+      }
+      retired.resize(numKeep);
+   }
+
+private:
+   Domain() : pRecords(nullptr), numRecords(0) {}
+
+   std::atomic <Record *> pRecords;    // every record ever created
+   std::atomic <size_t>   numRecords;  // how many records exist
+   std::mutex             lockOrphans; // protects orphans
+   std::vector <Retired>  orphans;     // retired by threads that exited
+};
+
+/*****************************************
+ * THREAD STATE
+ * This thread's record, which of its slots are in use,
+ * and the nodes it has retired but not yet freed
+ ****************************************/
+struct ThreadState
+{
+   ThreadState() : pRecord(Domain::instance().acquire()), slotsUsed(0) {}
+   ~ThreadState()
+   {
+      Domain::instance().release(pRecord);
+      Domain::instance().reclaim(retired);
+      if (!retired.empty())
+         Domain::instance().adopt(retired);
+   }
+
+   Record *              pRecord;
+   unsigned int          slotsUsed;   // bit i set when slot i is taken
+   std::vector <Retired> retired;
+};
+
+inline ThreadState & threadState()
+{
+   thread_local ThreadState state;
+   return state;
+}
+
+} // namespace hazard
+
+/*****************************************
+ * HAZARD POINTER
+ * Owns one of this thread's hazard slots for its lifetime
+ ****************************************/
+class hazard_pointer
+{
+   friend class ::TestHazardPointer; // give unit tests access to the privates
+public:
+   hazard_pointer() : pSlot(nullptr), slot(0)
+   {
+      hazard::ThreadState & state = hazard::threadState();
+      while (slot < hazard::MAX_HAZARDS && (state.slotsUsed & (1u << slot)))
+         slot++;
+      assert(slot < hazard::MAX_HAZARDS);
+      state.slotsUsed |= (1u << slot);
+      pSlot = &state.pRecord->pHazard[slot];
+   }
+   hazard_pointer(const hazard_pointer & rhs) = delete;
+   hazard_pointer & operator = (const hazard_pointer & rhs) = delete;
+   ~hazard_pointer()
+   {
+      reset();
+      hazard::threadState().slotsUsed &= ~(1u << slot);
+   }
+
+   // publish whatever src points to, retrying until the
+   // published value is known to still be reachable
+   template <class T>
+   T * protect(const std::atomic <T *> & src)
+   {
+      T * p = src.load();
+      for (;;)
+      {
+         pSlot->store(p);
+         T * pCheck = src.load();
+         if (pCheck == p)
+            return p;
+         p = pCheck;
+      }
+   }
+
+   void set(void * p) { pSlot->store(p);       }
+   void reset()       { pSlot->store(nullptr); }
+
+private:
+   std::atomic <void *> * pSlot;   // the slot we publish in
+   int slot;                       // which of this thread's slots it is
+};
+
+/*****************************************
+ * RETIRE
+ * pRetire has been unlinked and no new reader can
+ * reach it.  Free it once no hazard pointer holds it.
+ *   INPUT  : pRetire - a node allocated with new
+ *   COST   : O(1) amortized
+ ****************************************/
+template <class T>
+inline void retire(T * pRetire)
+{
+   hazard::ThreadState & state = hazard::threadState();
+   hazard::Retired retired = { pRetire, [](void * p) { delete static_cast<T *>(p); } };
+   state.retired.push_back(retired);
+   if (state.retired.size() >= hazard::Domain::instance().threshold())
+      hazard::Domain::instance().reclaim(state.retired);
+}
+
+/*****************************************
+ * RECLAIM
+ * Free everything this thread has retired that is no
+ * longer protected, without waiting for the threshold
+ ****************************************/
+inline void reclaim()
+{
+   hazard::Domain::instance().reclaim(hazard::threadState().retired);
+}
+
+} // namespace custom
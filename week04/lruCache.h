@@ -0,0 +1,511 @@
+/***********************************************************************
+ * Header:
+ *    LRU CACHE
+ * Summary:
+ *    A fixed-size cache that throws out the least recently used entry
+ *    when it runs out of room.  Each entry is a Node on the recency list
+ *    (most recent at the front) that also carries the link for its hash
+ *    bucket, so an entry is one allocation instead of a list node plus a
+ *    hash map node.  Once the cache is full, a new key reuses the
+ *    evicted entry and nothing is allocated at all.
+ *
+ *    The sharded cache splits the keys over several caches, each with
+ *    its own lock, so threads working on different keys rarely wait.
+ *
+ *    This will contain the class definition of:
+ *        lru_cache              : A single-threaded LRU cache
+ *        sharded_lru_cache      : A thread-safe LRU cache
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // for ASSERT
+#include <cstdint>     // for uint64_t
+#include <functional>  // for std::hash
+#include <memory>      // for std::unique_ptr
+#include <mutex>       // for std::mutex
+#include <utility>     // for std::pair
+#include <vector>      // for std::vector
+#include "node.h"      // for Node
+#include "nodeBlock.h" // for node_block
+
+class TestLruCache; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LRU CACHE
+ * O(1) get, put, and evict
+ *************************************************/
+template <class K, class V, class Hash = std::hash <K> >
+class lru_cache
+{
+   friend class ::TestLruCache; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   lru_cache(size_t capacity, const Hash & hash = Hash());
+   lru_cache(const lru_cache & rhs) = delete;
+   lru_cache & operator = (const lru_cache & rhs) = delete;
+   ~lru_cache() { clear(); }
+
+   //
+   // Access
+   //
+
+   bool get(const K & key, V & value);
+   bool contains(const K & key) const { return find(key, hashOf(key)) != nullptr; }
+
+   //
+   // Insert
+   //
+
+   void put(const K & key, const V & value);
+
+   //
+   // Remove
+   //
+
+   bool erase(const K & key);
+   void clear();
+
+   //
+   // Status
+   //
+
+   size_t size()     const { return numElements;      }
+   size_t capacity() const { return numCapacity;      }
+   bool   empty()    const { return numElements == 0; }
+   size_t hits()     const { return numHits;          }
+   size_t misses()   const { return numMisses;        }
+   double hitRate()  const
+   {
+      size_t numLookups = numHits + numMisses;
+      return numLookups == 0 ? 0.0 : (double)numHits / (double)numLookups;
+   }
+
+private:
+
+   /*************************************************
+    * ENTRY
+    * A node on the recency list plus the link to the
+    * next entry in its hash bucket
+    *************************************************/
+   struct Entry : public Node <std::pair <K, V> >
+   {
+      Entry(const K & key, const V & value) :
+         Node <std::pair <K, V> >(std::pair <K, V>(key, value)), pBucketNext(nullptr) {}
+
+      // straight from the heap: no lock shared between shards
+      static void * operator new(size_t size)
+      {
+         assert(size == sizeof(Entry));
+         return node_block <Entry>::allocate(size);
+      }
+      static void operator delete(void * p)
+      {
+         node_block <Entry>::deallocate(p);
+      }
+
+      Entry * next() const { return static_cast<Entry *>(this->pNext); }
+      Entry * prev() const { return static_cast<Entry *>(this->pPrev); }
+
+      Entry * pBucketNext;
+   };
+
+   size_t   hashOf(const K & key) const { return hash(key); }
+   Entry *& bucket(size_t h)            { return buckets[h & (buckets.size() - 1)]; }
+   Entry *  find(const K & key, size_t h) const;
+   void     unlinkBucket(Entry * pEntry, size_t h);
+   void     unlinkRecency(Entry * pEntry);
+   void     pushFront(Entry * pEntry);
+
+   std::vector <Entry *> buckets;      // a power of two, at least the capacity
+   Entry *               pHead;        // the most recently used
+   Entry *               pTail;        // the least recently used
+   size_t                numElements;  // how many entries are in use
+   size_t                numCapacity;  // the most entries we will hold
+   size_t                numHits;      // gets that found their key
+   size_t                numMisses;    // gets that did not
+   Hash                  hash;         // how to hash a key
+};
+
+/*****************************************
+ * LRU CACHE :: CONSTRUCTOR
+ * The bucket array never has to grow since the cache
+ * never holds more than capacity entries.
+ ****************************************/
+template <class K, class V, class Hash>
+lru_cache <K, V, Hash> :: lru_cache(size_t capacity, const Hash & hash) :
+   pHead(nullptr), pTail(nullptr), numElements(0), numCapacity(capacity),
+   numHits(0), numMisses(0), hash(hash)
+{
+   assert(capacity > 0);
+   size_t numBuckets = 1;
+   while (numBuckets < capacity)
+      numBuckets *= 2;
+   buckets.assign(numBuckets, nullptr);
+}
+
+/*****************************************
+ * LRU CACHE :: FIND
+ * Look through one bucket for the key
+ *   COST   : O(1) expected
+ ****************************************/
+template <class K, class V, class Hash>
+typename lru_cache <K, V, Hash> :: Entry *
+lru_cache <K, V, Hash> :: find(const K & key, size_t h) const
+{
+   for (Entry * p = buckets[h & (buckets.size() - 1)]; p != nullptr; p = p->pBucketNext)
+      if (p->data.first == key)
+         return p;
+   return nullptr;
+}
+
+/*****************************************
+ * LRU CACHE :: GET
+ * Copy out the value for key and make it the most
+ * recently used
+ *   OUTPUT : value - the value, if key was there
+ *            return whether key was there
+ *   COST   : O(1) expected
+ ****************************************/
+template <class K, class V, class Hash>
+bool lru_cache <K, V, Hash> :: get(const K & key, V & value)
+{
+   Entry * pEntry = find(key, hashOf(key));
+   if (pEntry == nullptr)
+   {
+      numMisses++;
+      return false;
+   }
+
+   numHits++;
+   if (pEntry != pHead)
+   {
+      unlinkRecency(pEntry);
+      pushFront(pEntry);
+   }
+   value = pEntry->data.second;
+   return true;
+}
+
+/*****************************************
+ * LRU CACHE :: PUT
+ * Set the value for key and make it the most recently
+ * used.  When a new key arrives and the cache is full,
+ * the least recently used entry is taken over for it.
+ *   COST   : O(1) expected, no allocation once full
+ ****************************************/
+template <class K, class V, class Hash>
+void lru_cache <K, V, Hash> :: put(const K & key, const V & value)
+{
+   size_t h = hashOf(key);
+   Entry * pEntry = find(key, h);
+
+   // already there: update in place
+   if (pEntry != nullptr)
+   {
+      pEntry->data.second = value;
+      if (pEntry != pHead)
+      {
+         unlinkRecency(pEntry);
+         pushFront(pEntry);
+      }
+      return;
+   }
+
+   // full: recycle the least recently used entry
+   if (numElements == numCapacity)
+   {
+      pEntry = pTail;
+      unlinkBucket(pEntry, hashOf(pEntry->data.first));
+      unlinkRecency(pEntry);
+      pEntry->data.first = key;
+      pEntry->data.second = value;
+   }
+   else
+   {
+      pEntry = new Entry(key, value);
+      numElements++;
+   }
+
+   pEntry->pBucketNext = bucket(h);
+   bucket(h) = pEntry;
+   pushFront(pEntry);
+}
+
+/*****************************************
+ * LRU CACHE :: ERASE
+ * Throw out key if it is there
+ *   OUTPUT : whether key was there
+ *   COST   : O(1) expected
+ ****************************************/
+template <class K, class V, class Hash>
+bool lru_cache <K, V, Hash> :: erase(const K & key)
+{
+   size_t h = hashOf(key);
+   Entry * pEntry = find(key, h);
+   if (pEntry == nullptr)
+      return false;
+
+   unlinkBucket(pEntry, h);
+   unlinkRecency(pEntry);
+   delete pEntry;
+   numElements--;
+   return true;
+}
+
+/*****************************************
+ * LRU CACHE :: CLEAR
+ * Free every entry.  The statistics are kept.
+ *   COST   : O(n + buckets)
+ ****************************************/
+template <class K, class V, class Hash>
+void lru_cache <K, V, Hash> :: clear()
+{
+   while (pHead != nullptr)
+   {
+      Entry * pDelete = pHead;
+      pHead = pHead->next();
+      delete pDelete;
+   }
+   pTail = nullptr;
+   numElements = 0;
+   for (size_t i = 0; i < buckets.size(); i++)
+      buckets[i] = nullptr;
+}
+
+/*****************************************
+ * LRU CACHE :: UNLINK BUCKET
+ * Take the entry out of its hash bucket
+ ****************************************/
+template <class K, class V, class Hash>
+void lru_cache <K, V, Hash> :: unlinkBucket(Entry * pEntry, size_t h)
+{
+   Entry ** pp = &bucket(h);
+   while (*pp != pEntry)
+      pp = &(*pp)->pBucketNext;
+   *pp = pEntry->pBucketNext;
+   pEntry->pBucketNext = nullptr;
+}
+
+/*****************************************
+ * LRU CACHE :: UNLINK RECENCY
+ * Take the entry out of the recency list
+ ****************************************/
+template <class K, class V, class Hash>
+void lru_cache <K, V, Hash> :: unlinkRecency(Entry * pEntry)
+{
+   if (pEntry->pPrev)
+      pEntry->pPrev->pNext = pEntry->pNext;
+   else
+      pHead = pEntry->next();
+
+   if (pEntry->pNext)
+      pEntry->pNext->pPrev = pEntry->pPrev;
+   else
+      pTail = pEntry->prev();
+
+   pEntry->pPrev = nullptr;
+   pEntry->pNext = nullptr;
+}
+
+/*****************************************
+ * LRU CACHE :: PUSH FRONT
+ * Make the entry the most recently used
+ ****************************************/
+template <class K, class V, class Hash>
+void lru_cache <K, V, Hash> :: pushFront(Entry * pEntry)
+{
+   pEntry->pPrev = nullptr;
+   pEntry->pNext = pHead;
+   if (pHead)
+      pHead->pPrev = pEntry;
+   else
+      pTail = pEntry;
+   pHead = pEntry;
+}
+
+/**************************************************
+ * SHARDED LRU CACHE
+ * Several LRU caches, each behind its own lock.  A
+ * key always goes to the same shard, so each shard
+ * evicts on its own; the cache as a whole is close
+ * to, not exactly, least recently used.
+ *************************************************/
+template <class K, class V, class Hash = std::hash <K> >
+class sharded_lru_cache
+{
+   friend class ::TestLruCache; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   sharded_lru_cache(size_t capacity, size_t numShards = 16, const Hash & hash = Hash());
+   sharded_lru_cache(const sharded_lru_cache & rhs) = delete;
+   sharded_lru_cache & operator = (const sharded_lru_cache & rhs) = delete;
+
+   //
+   // Access
+   //
+
+   bool get(const K & key, V & value)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard <std::mutex> guard(shard.lock);
+      return shard.cache.get(key, value);
+   }
+   bool contains(const K & key)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard <std::mutex> guard(shard.lock);
+      return shard.cache.contains(key);
+   }
+
+   //
+   // Insert
+   //
+
+   void put(const K & key, const V & value)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard <std::mutex> guard(shard.lock);
+      shard.cache.put(key, value);
+   }
+
+   //
+   // Remove
+   //
+
+   bool erase(const K & key)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard <std::mutex> guard(shard.lock);
+      return shard.cache.erase(key);
+   }
+   void clear();
+
+   //
+   // Status
+   //
+
+   size_t size()     const;
+   size_t capacity() const;
+   size_t hits()     const;
+   size_t misses()   const;
+   double hitRate()  const
+   {
+      size_t numHits = hits();
+      size_t numLookups = numHits + misses();
+      return numLookups == 0 ? 0.0 : (double)numHits / (double)numLookups;
+   }
+
+private:
+
+   struct Shard
+   {
+      Shard(size_t capacity, const Hash & hash) : cache(capacity, hash) {}
+
+      mutable std::mutex        lock;
+      lru_cache <K, V, Hash>    cache;
+   };
+
+   // spread the hash over the shards with a multiply so the
+   // low bits that pick a bucket inside the shard stay random
+   Shard & shardOf(const K & key)
+   {
+      uint64_t mixed = (uint64_t)hash(key) * 0x9E3779B97F4A7C15ull;
+      return *shards[(size_t)(mixed >> 32) % shards.size()];
+   }
+
+   std::vector <std::unique_ptr <Shard> > shards;
+   Hash                                   hash;
+};
+
+/*****************************************
+ * SHARDED LRU CACHE :: CONSTRUCTOR
+ * Split the capacity as evenly as we can
+ ****************************************/
+template <class K, class V, class Hash>
+sharded_lru_cache <K, V, Hash> :: sharded_lru_cache(size_t capacity, size_t numShards,
+                                                    const Hash & hash) :
+   hash(hash)
+{
+   assert(numShards > 0 && capacity >= numShards);
+   for (size_t i = 0; i < numShards; i++)
+   {
+      size_t shardCapacity = capacity / numShards + (i < capacity % numShards ? 1 : 0);
+      shards.push_back(std::unique_ptr <Shard>(new Shard(shardCapacity, hash)));
+   }
+}
+
+/*****************************************
+ * SHARDED LRU CACHE :: CLEAR / STATUS
+ * Each shard is locked in turn, so these are exact
+ * only when no other thread is changing the cache
+ ****************************************/
+template <class K, class V, class Hash>
+void sharded_lru_cache <K, V, Hash> :: clear()
+{
+   for (auto & pShard : shards)
+   {
+      std::lock_guard <std::mutex> guard(pShard->lock);
+      pShard->cache.clear();
+   }
+}
+
+template <class K, class V, class Hash>
+size_t sharded_lru_cache <K, V, Hash> :: size() const
+{
+   size_t num = 0;
+   for (auto & pShard : shards)
+   {
+      std::lock_guard <std::mutex> guard(pShard->lock);
+      num += pShard->cache.size();
+   }
+   return num;
+}
+
+template <class K, class V, class Hash>
+size_t sharded_lru_cache <K, V, Hash> :: capacity() const
+{
+   size_t num = 0;
+   for (auto & pShard : shards)
+      num += pShard->cache.capacity();
+   return num;
+}
+
+template <class K, class V, class Hash>
+size_t sharded_lru_cache <K, V, Hash> :: hits() const
+{
+   size_t num = 0;
+   for (auto & pShard : shards)
+   {
+      std::lock_guard <std::mutex> guard(pShard->lock);
+      num += pShard->cache.hits();
+   }
+   return num;
+}
+
+template <class K, class V, class Hash>
+size_t sharded_lru_cache <K, V, Hash> :: misses() const
+{
+   size_t num = 0;
+   for (auto & pShard : shards)
+   {
+      std::lock_guard <std::mutex> guard(pShard->lock);
+      num += pShard->cache.misses();
+   }
+   return num;
+}
+
+} // namespace custom
@@ -22,6 +22,13 @@
 
 #include <cassert>     // for ASSERT
 #include <iostream>    // for NULL
+#include <functional>  // for std::less
+#include <utility>     // for std::move
+#include "nodeBlock.h" // for node_block
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h> // for _mm_prefetch
+#endif
+#include "reclaimer.h" // for clear_async
 
 /*************************************************
  * NODE
@@ -49,12 +56,27 @@ public:
        this->pPrev = nullptr;
        this->pNext = nullptr;
    }
-   Node(      T && data) : data(data)
+   Node(      T && data) : data(std::move(data))
    {
        pPrev = nullptr;
        pNext = nullptr;
    }
 
+   //
+   // Allocate
+   // A node can be freed on its own whether it came from the
+   // heap by itself or as part of a run built by copy().
+   //
+
+   static void * operator new(size_t size)
+   {
+      return custom::node_block <Node <T> >::allocate(size);
+   }
+   static void operator delete(void * p)
+   {
+      custom::node_block <Node <T> >::deallocate(p);
+   }
+
    //
    // Member variables
    //
@@ -64,10 +86,62 @@ public:
    Node <T> * pPrev;       // pointer to previous node
 };
 
+/***********************************************
+ * COPY BLOCK
+ * Copy the first num nodes of pSource into a new list
+ * whose nodes sit one after the other in a single
+ * allocation.
+ *   INPUT  : pSource - the list to be copied
+ *            num     - how many nodes to copy (at most size)
+ *   OUTPUT : return the new list, pTail its last node
+ *   COST   : O(num), one allocation
+ **********************************************/
+template <class T>
+inline Node <T> * copyBlock(const Node <T> * pSource, size_t num, Node <T> * & pTail)
+{
+   pTail = nullptr;
+   if (num == 0)
+      return nullptr;
+
+   Node <T> * pBlock = custom::node_block <Node <T> >::allocate_run(num);
+
+   size_t i = 0;
+   Node <T> * pSlot = pBlock;
+   try
+   {
+      for (; i < num; i++, pSource = pSource->pNext, pSlot = custom::node_block <Node <T> >::next(pSlot))
+      {
+         Node <T> * pNew = ::new (pSlot) Node <T>(pSource->data);
+         pNew->pPrev = pTail;
+         if (pTail)
+            pTail->pNext = pNew;
+         pTail = pNew;
+      }
+   }
+   catch (...)
+   {
+      // give back the nodes we built and the slots we did not
+      pSlot = pBlock;
+      for (size_t j = 0; j < num; j++)
+      {
+         Node <T> * pNext = custom::node_block <Node <T> >::next(pSlot);
+         if (j < i)
+            pSlot->~Node <T>();
+         custom::node_block <Node <T> >::deallocate(pSlot);
+         pSlot = pNext;
+      }
+      pTail = nullptr;
+      throw;
+   }
+
+   return pBlock;
+}
+
 /***********************************************
  * COPY
  * Copy the list from the pSource and return
- * the new list
+ * the new list.  The source is counted first so every
+ * node can come from a single allocation.
  *   INPUT  : the list to be copied
  *   OUTPUT : return the new list
  *   COST   : O(n)
@@ -75,39 +149,15 @@ public:
 template <class T>
 inline Node <T> * copy(const Node <T> * pSource) 
 {
-   Node<T>* pDes = nullptr;
-   if (pSource == nullptr) {
-        return pDes;
-   }
-   else if (pSource->pNext==nullptr) {
-       pDes = new Node<T>(pSource->data);
-       return pDes;
-   }
-   
-   if (pSource->pNext != nullptr) {
-       Node<T>* pSrc = pSource->pNext->pPrev;
-       Node<T>* pStart = new Node<T>(pSrc->data);
-       pDes = pStart;
-       pSrc = pSrc->pNext;
-       while (pSrc!=nullptr)
-       {
-           pDes->pNext = new Node<T>(pSrc->data);
-           pDes->pNext->pPrev = pDes;
-           pDes = pDes->pNext;
-           pSrc = pSrc->pNext;
-           
-       }
-       return pStart;
-   }
-   
-   return pDes;
-    
+   Node <T> * pTail;
+   return copyBlock(pSource, size(pSource), pTail);
 }
 
 /***********************************************
  * Assign
  * Copy the values from pSource into pDestination
  * reusing the nodes already created in pDestination if possible.
+ * Any extra nodes needed are allocated together.
  *   INPUT  : the list to be copied
  *   OUTPUT : return the new list
  *   COST   : O(n)
@@ -115,79 +165,138 @@ inline Node <T> * copy(const Node <T> * pSource)
 template <class T>
 inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
 {
-    
-    if (pSource == nullptr) {
-        if (pDestination != nullptr) {
-            while (pDestination->pNext != nullptr)
-            {
-                pDestination = pDestination->pNext;
-                delete pDestination->pPrev;
-            }
-            Node<T>* deleteableData = pDestination;
-            pDestination = nullptr;
-            delete deleteableData;
-        }
-    }
-    else {
-        Node<T>* pSrc = nullptr;
-        Node<T>* pDesPrevious = nullptr;
-        Node<T>* pDes = pDestination;
-        
-        //we do the first step with the constant variable.
-        if (pDes != nullptr) {
-            pDes->data = pSource->data;
-            pDes = pDes->pNext;
-            pSrc = pSource->pNext;
-            while (pDes != nullptr && pSrc != nullptr) { //itterate through the lists until on of them ends
-
-                pDes->data = pSrc->data;
-                if (pDes->pNext == nullptr) {
-                    pDesPrevious = pDes;
-                }
-                pDes = pDes->pNext;
-                pSrc = pSrc->pNext;
-            }
-        }
-        else {
-            if (pSource != nullptr) {
-                pSrc = pSource->pNext->pPrev;
-            }
-        }
-        if (pSrc != nullptr) {  //if the destination list ended first.
-            pDes = pDesPrevious;
-
-            if (pSrc == nullptr) {
-                pSrc = pSource->pNext->pPrev;
-            }
-            if (pDes == nullptr && pSrc != nullptr) {
-                pDestination = new Node<T>(pSrc->data);
-                pDes = pDestination;
-                pSrc = pSrc->pNext;
-            }
-
-            while (pSrc != nullptr) {
-                Node<T>* freshNode = new Node<T>(pSrc->data);
-                pDes->pNext = freshNode;
-                freshNode->pPrev = pDes;
-                pSrc = pSrc->pNext;
-                pDes = pDes->pNext;
-            }
-        }
+   const Node <T> * pSrc = pSource;
+   Node <T> * pDes = pDestination;
+   Node <T> * pDesPrevious = nullptr;
 
-        else if (pDes != nullptr) { //if the source list ended first
-
-            Node<T>* pDeleter = pDes;
-            pDes = pDes->pPrev;
-            while (pDeleter->pNext != nullptr) {
-                pDeleter = pDeleter->pNext;
-            }
-            while (pDeleter != pDes) {
-                pDeleter = pDeleter->pPrev;
-                delete pDeleter->pNext;
-            }
-            pDes->pNext = nullptr;
-        }
-    }
+   // copy over the nodes we already have
+   while (pSrc != nullptr && pDes != nullptr)
+   {
+      pDes->data = pSrc->data;
+      pDesPrevious = pDes;
+      pDes = pDes->pNext;
+      pSrc = pSrc->pNext;
+   }
+
+   // the destination ran out first: add the rest in one block
+   if (pSrc != nullptr)
+   {
+      Node <T> * pTail;
+      Node <T> * pRest = copyBlock(pSrc, size(pSrc), pTail);
+      pRest->pPrev = pDesPrevious;
+      if (pDesPrevious)
+         pDesPrevious->pNext = pRest;
+      else
+         pDestination = pRest;
+   }
+
+   // the source ran out first: free what is left over
+   else if (pDes != nullptr)
+   {
+      if (pDesPrevious)
+         pDesPrevious->pNext = nullptr;
+      else
+         pDestination = nullptr;
+
+      while (pDes != nullptr)
+      {
+         Node <T> * pDelete = pDes;
+         pDes = pDes->pNext;
+         delete pDelete;
+      }
+   }
+}
+
+/***********************************************
+ * FRAGMENTATION
+ * How scattered the list is in memory: the fraction of
+ * links that do not go to the very next slot.  A list
+ * fresh from copy() or compact() scores 0.0.
+ *   INPUT  : pHead - the head of the list
+ *   OUTPUT : 0.0 (contiguous) through 1.0 (no two adjacent)
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline double fragmentation(const Node <T> * pHead)
+{
+   size_t numLinks = 0;
+   size_t numJumps = 0;
+   for (const Node <T> * p = pHead; p != nullptr && p->pNext != nullptr; p = p->pNext)
+   {
+      numLinks++;
+      if (p->pNext != custom::node_block <Node <T> >::next(p))
+         numJumps++;
+   }
+   return numLinks == 0 ? 0.0 : (double)numJumps / (double)numLinks;
+}
+
+/***********************************************
+ * COMPACT
+ * Move the list into a single contiguous block in list
+ * order so a traversal walks memory front to back.  The
+ * values are moved, not copied, unless moving T could
+ * throw.  Every node gets a new address.
+ *   INPUT  : pHead - the head of the list
+ *   OUTPUT : pHead set to the head of the relocated list
+ *   COST   : O(n), one allocation
+ **********************************************/
+template <class T>
+inline void compact(Node <T> * & pHead)
+{
+   size_t num = size(pHead);
+   if (num == 0)
+      return;
+
+   Node <T> * pBlock = custom::node_block <Node <T> >::allocate_run(num);
+
+   size_t i = 0;
+   Node <T> * pSlot = pBlock;
+   Node <T> * pTail = nullptr;
+   try
+   {
+      for (Node <T> * p = pHead; i < num; i++, p = p->pNext, pSlot = custom::node_block <Node <T> >::next(pSlot))
+      {
+         Node <T> * pNew = ::new (pSlot) Node <T>(std::move_if_noexcept(p->data));
+         pNew->pPrev = pTail;
+         if (pTail)
+            pTail->pNext = pNew;
+         pTail = pNew;
+      }
+   }
+   catch (...)
+   {
+      // the old list still has its values since T was copied
+      pSlot = pBlock;
+      for (size_t j = 0; j < num; j++)
+      {
+         Node <T> * pNext = custom::node_block <Node <T> >::next(pSlot);
+         if (j < i)
+            pSlot->~Node <T>();
+         custom::node_block <Node <T> >::deallocate(pSlot);
+         pSlot = pNext;
+      }
+      throw;
+   }
+
+   clear(pHead);
+   pHead = pBlock;
+}
+
+/***********************************************
+ * COMPACT IF FRAGMENTED
+ * Compact the list only when it has become scattered
+ *   INPUT  : pHead     - the head of the list
+ *            threshold - the fragmentation that triggers it
+ *   OUTPUT : whether the list was compacted
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline bool compact_if_fragmented(Node <T> * & pHead, double threshold = 0.5)
+{
+   if (fragmentation(pHead) <= threshold)
+      return false;
+   compact(pHead);
+   return true;
 }
 
 /***********************************************
@@ -323,4 +432,317 @@ inline void clear(Node <T> * & pHead)
     }
 }
 
+/*****************************************************
+ * CLEAR BATCHED
+ * Free at most budget nodes off the front of the list so
+ * a long teardown can be spread across many calls, each
+ * with a bounded cost.
+ *   INPUT   : pHead  - the head of the linked list
+ *             budget - the most nodes to free this call
+ *   OUTPUT  : pHead set to the first node not freed (or NULL)
+ *             return the number of nodes freed
+ *   COST    : O(budget)
+ ****************************************************/
+template <class T>
+inline size_t clear_batched(Node <T> * & pHead, size_t budget)
+{
+   size_t numFreed = 0;
+   while (pHead != nullptr && numFreed < budget)
+   {
+      Node <T> * pDelete = pHead;
+      pHead = pHead->pNext;
+      delete pDelete;
+      numFreed++;
+   }
+
+   if (pHead != nullptr)
+      pHead->pPrev = nullptr;
+   return numFreed;
+}
+
+/*****************************************************
+ * CLEAR ASYNC
+ * Detach the list and let the background reclaimer free
+ * it.  The destructors of T run on that other thread.
+ *   INPUT   : pHead - the head of the linked list
+ *   OUTPUT  : pHead set to NULL
+ *   COST    : O(1) on this thread, O(n) in the background
+ ****************************************************/
+template <class T>
+inline void clear_async(Node <T> * & pHead)
+{
+   if (pHead == nullptr)
+      return;
+
+   custom::reclaimer::instance().submit(pHead, [](void * p)
+   {
+      Node <T> * pDetached = static_cast<Node <T> *>(p);
+      clear(pDetached);
+   });
+   pHead = nullptr;
+}
+
+/***********************************************
+ * SPLIT
+ * Detach the list after the first num nodes
+ *   INPUT  : pHead - the head of the list to split
+ *            num   - how many nodes stay in the front half
+ *   OUTPUT : the head of the back half (or nullptr)
+ *   COST   : O(num)
+ **********************************************/
+template <class T>
+inline Node <T> * split(Node <T> * pHead, size_t num)
+{
+   for (size_t i = 1; pHead != nullptr && i < num; i++)
+      pHead = pHead->pNext;
+
+   if (pHead == nullptr)
+      return nullptr;
+
+   Node <T> * pBack = pHead->pNext;
+   pHead->pNext = nullptr;
+   if (pBack)
+      pBack->pPrev = nullptr;
+   return pBack;
+}
+
+/***********************************************
+ * MERGE
+ * Merge two sorted lists into one sorted list by
+ * relinking the existing nodes.  When two items are
+ * equivalent, the one from pLHS goes first (stable).
+ *   INPUT  : pLHS, pRHS - heads of the sorted lists
+ *            compare    - the ordering of the lists
+ *            pTail      - receives the last node of the result
+ *   OUTPUT : the head of the merged list
+ *   COST   : O(n + m), no allocations
+ **********************************************/
+template <class T, class Compare>
+inline Node <T> * merge(Node <T> * pLHS, Node <T> * pRHS,
+                        Compare compare, Node <T> * & pTail)
+{
+   Node <T> * pHead = nullptr;
+   pTail = nullptr;
+
+   while (pLHS != nullptr && pRHS != nullptr)
+   {
+      Node <T> * pTake;
+      if (compare(pRHS->data, pLHS->data))
+      {
+         pTake = pRHS;
+         pRHS = pRHS->pNext;
+      }
+      else
+      {
+         pTake = pLHS;
+         pLHS = pLHS->pNext;
+      }
+
+      pTake->pPrev = pTail;
+      if (pTail)
+         pTail->pNext = pTake;
+      else
+         pHead = pTake;
+      pTail = pTake;
+   }
+
+   // hook up whichever list still has nodes
+   Node <T> * pRest = (pLHS != nullptr ? pLHS : pRHS);
+   if (pRest != nullptr)
+   {
+      pRest->pPrev = pTail;
+      if (pTail)
+         pTail->pNext = pRest;
+      else
+         pHead = pRest;
+      while (pRest->pNext != nullptr)
+         pRest = pRest->pNext;
+      pTail = pRest;
+   }
+
+   return pHead;
+}
+
+template <class T, class Compare = std::less <T> >
+inline Node <T> * merge(Node <T> * pLHS, Node <T> * pRHS,
+                        Compare compare = Compare())
+{
+   Node <T> * pTail;
+   return merge(pLHS, pRHS, compare, pTail);
+}
+
+/***********************************************
+ * SORT
+ * Sort the list with a bottom-up merge sort.  We merge
+ * runs of 1, 2, 4, ... nodes in place, so the only
+ * extra space is a handful of pointers and no node is
+ * allocated, copied, or freed.
+ *   INPUT  : pHead   - the head of the list
+ *            compare - the ordering to sort by
+ *   OUTPUT : pHead set to the new head of the sorted list
+ *   COST   : O(n log n)
+ **********************************************/
+template <class T, class Compare = std::less <T> >
+inline void sort(Node <T> * & pHead, Compare compare = Compare())
+{
+   if (pHead == nullptr || pHead->pNext == nullptr)
+      return;
+
+   size_t num = size(pHead);
+   for (size_t width = 1; width < num; width *= 2)
+   {
+      Node <T> * pRest = pHead;
+      Node <T> * pTail = nullptr;
+      pHead = nullptr;
+
+      while (pRest != nullptr)
+      {
+         // peel off two runs of "width" nodes each
+         Node <T> * pLeft = pRest;
+         Node <T> * pRight = split(pLeft, width);
+         pRest = split(pRight, width);
+
+         // merge them and put the result on the end of the list
+         Node <T> * pMergedTail;
+         Node <T> * pMerged = merge(pLeft, pRight, compare, pMergedTail);
+         pMerged->pPrev = pTail;
+         if (pTail)
+            pTail->pNext = pMerged;
+         else
+            pHead = pMerged;
+         pTail = pMergedTail;
+      }
+   }
+}
+
+/***********************************************
+ * PREFETCH
+ * Ask the processor to start loading a node into the
+ * cache.  This is only a hint; it does nothing where
+ * the compiler has no way to express it.
+ **********************************************/
+inline void prefetch(const void * p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+   _mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#else
+   (void)p;
+#endif
+}
+
+const size_t PREFETCH_DISTANCE = 4;    // how many nodes to run ahead
+
+/***********************************************
+ * WALK
+ * Visit each node in order while running a few nodes
+ * ahead: the ring holds the next PREFETCH_DISTANCE nodes,
+ * each already requested from memory, so loading the
+ * next link overlaps with visiting the current node.
+ *   INPUT  : pHead - the head of the list
+ *            visit - called on each node; return false to stop.
+ *                    It must not unlink or free nodes.
+ *   OUTPUT : the node where visit stopped, or nullptr
+ *   COST   : O(n)
+ **********************************************/
+template <class TNode, class Visit>
+inline TNode * walk(TNode * pHead, Visit visit)
+{
+   TNode * ring[PREFETCH_DISTANCE];
+   size_t iOldest = 0;
+   size_t numRing = 0;
+   TNode * pFrontier = pHead;   // the newest node in the ring
+
+   if (pFrontier != nullptr)
+   {
+      prefetch(pFrontier);
+      ring[numRing++] = pFrontier;
+   }
+
+   while (numRing > 0)
+   {
+      // look one node further ahead
+      if (pFrontier != nullptr && numRing < PREFETCH_DISTANCE)
+      {
+         pFrontier = pFrontier->pNext;
+         if (pFrontier != nullptr)
+         {
+            prefetch(pFrontier);
+            ring[(iOldest + numRing) % PREFETCH_DISTANCE] = pFrontier;
+            if (++numRing < PREFETCH_DISTANCE)
+               continue;
+         }
+      }
+
+      // visit the oldest node; it was requested long ago
+      TNode * p = ring[iOldest];
+      iOldest = (iOldest + 1) % PREFETCH_DISTANCE;
+      numRing--;
+      if (!visit(p))
+         return p;
+   }
+   return nullptr;
+}
+
+/***********************************************
+ * FOR EACH
+ * Call f on the data of every node in order
+ *   INPUT  : pHead - the head of the list
+ *            f     - called with each value
+ *   OUTPUT : f, after it has seen every value
+ *   COST   : O(n)
+ **********************************************/
+template <class T, class Function>
+inline Function for_each(Node <T> * pHead, Function f)
+{
+   walk(pHead, [&f](Node <T> * p) { f(p->data); return true; });
+   return f;
+}
+
+template <class T, class Function>
+inline Function for_each(const Node <T> * pHead, Function f)
+{
+   walk(pHead, [&f](const Node <T> * p) { f(p->data); return true; });
+   return f;
+}
+
+/***********************************************
+ * FIND
+ * Find the first node holding t
+ *   INPUT  : pHead - the head of the list
+ *            t     - the value to look for
+ *   OUTPUT : the node, or nullptr if t is not there
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline Node <T> * find(Node <T> * pHead, const T & t)
+{
+   return walk(pHead, [&t](Node <T> * p) { return !(p->data == t); });
+}
 
+template <class T>
+inline const Node <T> * find(const Node <T> * pHead, const T & t)
+{
+   return walk(pHead, [&t](const Node <T> * p) { return !(p->data == t); });
+}
+
+/***********************************************
+ * ACCUMULATE
+ * Fold every value in the list into init, front to back
+ *   INPUT  : pHead - the head of the list
+ *            init  - the starting value
+ *            op    - combines the running total with a value
+ *   OUTPUT : the total
+ *   COST   : O(n)
+ **********************************************/
+template <class T, class U, class BinaryOperation = std::plus <> >
+inline U accumulate(const Node <T> * pHead, U init, BinaryOperation op = BinaryOperation())
+{
+   walk(pHead, [&init, &op](const Node <T> * p)
+   {
+      init = op(std::move(init), p->data);
+      return true;
+   });
+   return init;
+}
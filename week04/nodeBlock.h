@@ -0,0 +1,203 @@
+/***********************************************************************
+ * Header:
+ *    NODE BLOCK
+ * Summary:
+ *    Memory for linked list nodes that can be freed one node at a time
+ *    no matter how they were allocated.  A node can be allocated on its
+ *    own, straight from the heap, or as one of a run of nodes that share
+ *    a single heap allocation when a whole list is being built at once.
+ *
+ *    A node on its own costs exactly what ::operator new would: nothing
+ *    is added to it.  A run is one allocation, a small header followed
+ *    by the nodes as an array, and it counts its live nodes:
+ *
+ *        +-----+------+------+------+
+ *        | run | node | node | node |
+ *        +-----+------+------+------+
+ *
+ *    Freeing a node looks its address up in the runs that are still
+ *    alive.  With no runs alive that is one atomic load; otherwise it is
+ *    a search under a shared lock.  A run goes back to the heap with its
+ *    last node, so a list that was copied and then mostly erased keeps
+ *    the whole run until the rest is gone; compact() gives it back.
+ *
+ *    This will contain the class definition of:
+ *        node_block             : the allocator for one type of node
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>       // for std::atomic
+#include <cassert>      // for ASSERT
+#include <cstddef>      // for size_t
+#include <functional>   // for std::less
+#include <map>          // for std::map
+#include <mutex>        // for std::unique_lock
+#include <new>          // for ::operator new
+#include <shared_mutex> // for std::shared_mutex
+
+namespace custom
+{
+
+/*****************************************
+ * NODE BLOCK
+ * Allocation for objects of type T.  All of the
+ * methods are thread-safe.
+ ****************************************/
+template <class T>
+class node_block
+{
+public:
+   static void * allocate(size_t size);
+   static T *    allocate_run(size_t num);
+   static void   deallocate(void * p);
+
+   // the slot after p in a run
+   static       T * next(      T * p) { return p + 1; }
+   static const T * next(const T * p) { return p + 1; }
+
+   // how many times we went to the heap, and for how many bytes
+   static size_t numAllocations() { return registry().allocations.load(std::memory_order_relaxed); }
+   static size_t numBytes()       { return registry().bytes.load(std::memory_order_relaxed);       }
+
+private:
+   struct Run
+   {
+      std::atomic <size_t> numLive;   // nodes not yet freed
+      const T *            pEnd;      // one past the last slot
+   };
+
+   // the run header is padded so the first slot is aligned
+   static const size_t HEADER = (sizeof(Run) + alignof(T) - 1) / alignof(T) * alignof(T);
+   static_assert(alignof(T) <= alignof(std::max_align_t), "node is over-aligned");
+
+   struct Registry
+   {
+      Registry() : numRuns(0), allocations(0), bytes(0) {}
+
+      std::shared_mutex               lock;        // protects runs
+      std::map <const T *, Run *>     runs;        // live runs by first slot
+      std::atomic <size_t>            numRuns;     // runs.size(), read without the lock
+      std::atomic <size_t>            allocations; // trips to the heap
+      std::atomic <size_t>            bytes;       // bytes asked of the heap
+   };
+
+   static Registry & registry()
+   {
+      // never destroyed: a node can outlive any static object
+      static Registry * pRegistry = new Registry;
+      return *pRegistry;
+   }
+
+   static Run * find(const void * p);
+};
+
+/*****************************************
+ * NODE BLOCK :: ALLOCATE
+ * Room for one object of size bytes, on its own.
+ * The size can be bigger than T for a type derived
+ * from it.
+ *   INPUT  : size - the number of bytes
+ *   COST   : O(1), one heap allocation
+ ****************************************/
+template <class T>
+void * node_block <T> :: allocate(size_t size)
+{
+   void * p = ::operator new(size);
+   Registry & r = registry();
+   r.allocations.fetch_add(1, std::memory_order_relaxed);
+   r.bytes.fetch_add(size, std::memory_order_relaxed);
+   return p;
+}
+
+/*****************************************
+ * NODE BLOCK :: ALLOCATE RUN
+ * Room for num T's, one after the other in memory.
+ * Each slot can later be freed on its own.
+ *   INPUT  : num - the number of slots
+ *   OUTPUT : the first slot
+ *   COST   : O(log r) for r live runs, one heap allocation
+ ****************************************/
+template <class T>
+T * node_block <T> :: allocate_run(size_t num)
+{
+   assert(num > 0);
+   size_t size = HEADER + num * sizeof(T);
+   char * pRaw = static_cast<char *>(::operator new(size));
+   T * pFirst = reinterpret_cast<T *>(pRaw + HEADER);
+   Run * pRun = ::new (pRaw) Run;
+   pRun->numLive.store(num, std::memory_order_relaxed);
+   pRun->pEnd = pFirst + num;
+
+   Registry & r = registry();
+   try
+   {
+      std::unique_lock <std::shared_mutex> guard(r.lock);
+      r.runs[pFirst] = pRun;
+      r.numRuns.fetch_add(1);
+   }
+   catch (...)
+   {
+      pRun->~Run();
+      ::operator delete(static_cast<void *>(pRaw));
+      throw;
+   }
+   r.allocations.fetch_add(1, std::memory_order_relaxed);
+   r.bytes.fetch_add(size, std::memory_order_relaxed);
+   return pFirst;
+}
+
+/*****************************************
+ * NODE BLOCK :: DEALLOCATE
+ * Free a node on its own right away, or a node from
+ * a run once it is the last one left in it
+ *   COST   : O(1) with no live runs, O(log r) otherwise
+ ****************************************/
+template <class T>
+void node_block <T> :: deallocate(void * p)
+{
+   if (p == nullptr)
+      return;
+
+   // whoever handed us p saw its run registered first
+   Run * pRun = (registry().numRuns.load() == 0 ? nullptr : find(p));
+   if (pRun == nullptr)
+   {
+      ::operator delete(p);
+      return;
+   }
+
+   if (pRun->numLive.fetch_sub(1, std::memory_order_acq_rel) == 1)
+   {
+      Registry & r = registry();
+      {
+         std::unique_lock <std::shared_mutex> guard(r.lock);
+         r.runs.erase(reinterpret_cast<const T *>(reinterpret_cast<char *>(pRun) + HEADER));
+         r.numRuns.fetch_sub(1);
+      }
+      pRun->~Run();
+      ::operator delete(static_cast<void *>(pRun));
+   }
+}
+
+/*****************************************
+ * NODE BLOCK :: FIND
+ * The live run holding p, or nullptr if p was
+ * allocated on its own
+ ****************************************/
+template <class T>
+typename node_block <T> :: Run * node_block <T> :: find(const void * p)
+{
+   const T * pNode = static_cast<const T *>(p);
+   Registry & r = registry();
+   std::shared_lock <std::shared_mutex> guard(r.lock);
+   auto it = r.runs.upper_bound(pNode);
+   if (it == r.runs.begin())
+      return nullptr;
+   --it;
+   return std::less <const T *>()(pNode, it->second->pEnd) ? it->second : nullptr;
+}
+
+} // namespace custom
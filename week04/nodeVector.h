@@ -0,0 +1,110 @@
+/***********************************************************************
+ * Header:
+ *    NODE VECTOR
+ * Summary:
+ *    Bulk conversion between a chain of Nodes and a custom::vector.
+ *    Each direction allocates once: the vector is sized to the list
+ *    before anything is pushed, and the list is built in a single
+ *    block, the same way copy() does it.
+ *
+ *    This will contain the definition of:
+ *        to_vector   : copy (or move) a list into a vector
+ *        from_vector : move a vector into a list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <utility>     // for std::move
+#include "node.h"      // for Node
+#include "vector.h"    // for custom::vector
+
+/***********************************************
+ * TO VECTOR
+ * Copy the values of a list into a vector
+ *   INPUT  : pHead - the list to copy
+ *   OUTPUT : a vector holding the same values in order
+ *   COST   : O(n), one allocation
+ **********************************************/
+template <class T>
+inline custom::vector <T> to_vector(const Node <T> * pHead)
+{
+   custom::vector <T> v;
+   v.reserve(size(pHead));
+   for (const Node <T> * p = pHead; p != nullptr; p = p->pNext)
+      v.push_back(p->data);
+   return v;
+}
+
+/***********************************************
+ * MOVE TO VECTOR
+ * Move the values of a list into a vector and free
+ * the list
+ *   INPUT  : pHead - the list to empty
+ *   OUTPUT : a vector holding the values in order,
+ *            pHead set to nullptr
+ *   COST   : O(n), one allocation
+ **********************************************/
+template <class T>
+inline custom::vector <T> move_to_vector(Node <T> * & pHead)
+{
+   custom::vector <T> v;
+   v.reserve(size(pHead));
+   for (Node <T> * p = pHead; p != nullptr; p = p->pNext)
+      v.push_back(std::move(p->data));
+   clear(pHead);
+   return v;
+}
+
+/***********************************************
+ * FROM VECTOR
+ * Move the values of a vector into a new list whose
+ * nodes sit one after the other in a single allocation.
+ * The vector is left empty but
+ * keeps its buffer.
+ *   INPUT  : v - the vector to empty
+ *   OUTPUT : the head of the new list
+ *   COST   : O(n), one allocation
+ **********************************************/
+template <class T>
+inline Node <T> * from_vector(custom::vector <T> && v)
+{
+   size_t num = v.size();
+   if (num == 0)
+      return nullptr;
+
+   Node <T> * pBlock = custom::node_block <Node <T> >::allocate_run(num);
+
+   size_t i = 0;
+   Node <T> * pSlot = pBlock;
+   Node <T> * pTail = nullptr;
+   try
+   {
+      for (; i < num; i++, pSlot = custom::node_block <Node <T> >::next(pSlot))
+      {
+         Node <T> * pNew = ::new (pSlot) Node <T>(std::move(v[i]));
+         pNew->pPrev = pTail;
+         if (pTail)
+            pTail->pNext = pNew;
+         pTail = pNew;
+      }
+   }
+   catch (...)
+   {
+      // give back the nodes we built and the slots we did not
+      pSlot = pBlock;
+      for (size_t j = 0; j < num; j++)
+      {
+         Node <T> * pNext = custom::node_block <Node <T> >::next(pSlot);
+         if (j < i)
+            pSlot->~Node <T>();
+         custom::node_block <Node <T> >::deallocate(pSlot);
+         pSlot = pNext;
+      }
+      throw;
+   }
+
+   v.clear();
+   return pBlock;
+}
@@ -0,0 +1,644 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT LIST
+ * Summary:
+ *    A doubly linked list that lives in a memory-mapped file, so it is
+ *    still there the next time the program runs with nothing to rebuild.
+ *    A node cannot hold a raw pointer since the file may be mapped at a
+ *    different address each time, so pNext and pPrev are replaced by
+ *    offsets from the start of the file (0 means nullptr; the file
+ *    header sits there).
+ *
+ *    The file is a header followed by a fixed number of node slots:
+ *
+ *       +--------+------+------+------+-     -+------+
+ *       | header | slot | slot | slot |  ...  | slot |
+ *       +--------+------+------+------+-     -+------+
+ *
+ *    Every change is written in an order that keeps the chain from the
+ *    head through offNext a valid list at every moment, and each step
+ *    is flushed to disk before the next one starts.  If the program dies
+ *    part way through, the next open walks that chain once to repair
+ *    offPrev, the tail, the count, and the free list.  A list that was
+ *    closed normally opens with no walk at all.
+ *
+ *    Only trivially copyable types can be stored since the bytes go
+ *    straight to disk.
+ *
+ *    This will contain the class definition of:
+ *        mapped_file            : A file mapped into memory (POSIX or Windows)
+ *        persistent_list        : A linked list stored in a mapped file
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // for ASSERT
+#include <cstdint>     // for uint64_t
+#include <new>         // for std::bad_alloc
+#include <stdexcept>   // for std::runtime_error
+#include <string>      // for std::string
+#include <type_traits> // for std::is_trivially_copyable
+#include <vector>      // for std::vector
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>   // for CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, msync
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for ftruncate, sysconf
+#endif
+
+class TestPersistentList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * MAPPED FILE
+ * Open (or create) a file of a given size and map
+ * all of it into memory for reading and writing
+ *************************************************/
+class mapped_file
+{
+public:
+   mapped_file(const char * path, size_t numBytes);
+   mapped_file(const mapped_file & rhs) = delete;
+   mapped_file & operator = (const mapped_file & rhs) = delete;
+   ~mapped_file();
+
+   unsigned char * data()  const { return pData;    }
+   size_t          size()  const { return numBytes; }
+   bool            isNew() const { return created;  }
+
+   // wait until numBytes starting at offset are on the disk
+   void flush(size_t offset, size_t num);
+
+private:
+   unsigned char * pData;
+   size_t          numBytes;
+   bool            created;     // was the file empty when we opened it?
+#ifdef _WIN32
+   HANDLE          hFile;
+   HANDLE          hMapping;
+#else
+   int             fd;
+#endif
+};
+
+#ifdef _WIN32
+
+/*****************************************
+ * MAPPED FILE :: CONSTRUCTOR (Windows)
+ ****************************************/
+inline mapped_file :: mapped_file(const char * path, size_t numBytes) :
+   pData(nullptr), numBytes(numBytes), created(false),
+   hFile(INVALID_HANDLE_VALUE), hMapping(nullptr)
+{
+   hFile = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                       OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (hFile == INVALID_HANDLE_VALUE)
+      throw std::runtime_error(std::string("Unable to open ") + path);
+
+   LARGE_INTEGER size;
+   GetFileSizeEx(hFile, &size);
+   created = (size.QuadPart == 0);
+   if (!created)
+      this->numBytes = numBytes = (size_t)size.QuadPart;
+
+   hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READWRITE,
+                                 (DWORD)((uint64_t)numBytes >> 32),
+                                 (DWORD)(numBytes & 0xFFFFFFFF), nullptr);
+   if (hMapping == nullptr)
+   {
+      CloseHandle(hFile);
+      throw std::runtime_error(std::string("Unable to map ") + path);
+   }
+
+   pData = static_cast<unsigned char *>(MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, numBytes));
+   if (pData == nullptr)
+   {
+      CloseHandle(hMapping);
+      CloseHandle(hFile);
+      throw std::runtime_error(std::string("Unable to map ") + path);
+   }
+}
+
+inline mapped_file :: ~mapped_file()
+{
+   FlushViewOfFile(pData, numBytes);
+   FlushFileBuffers(hFile);
+   UnmapViewOfFile(pData);
+   CloseHandle(hMapping);
+   CloseHandle(hFile);
+}
+
+/*****************************************
+ * MAPPED FILE :: FLUSH (Windows)
+ * Write the dirty pages, then make the file
+ * system commit them
+ ****************************************/
+inline void mapped_file :: flush(size_t offset, size_t num)
+{
+   FlushViewOfFile(pData + offset, num);
+   FlushFileBuffers(hFile);
+}
+
+#else // POSIX
+
+/*****************************************
+ * MAPPED FILE :: CONSTRUCTOR (POSIX)
+ ****************************************/
+inline mapped_file :: mapped_file(const char * path, size_t numBytes) :
+   pData(nullptr), numBytes(numBytes), created(false), fd(-1)
+{
+   fd = ::open(path, O_RDWR | O_CREAT, 0644);
+   if (fd < 0)
+      throw std::runtime_error(std::string("Unable to open ") + path);
+
+   struct stat status;
+   fstat(fd, &status);
+   created = (status.st_size == 0);
+   if (!created)
+      this->numBytes = numBytes = (size_t)status.st_size;
+   else if (ftruncate(fd, (off_t)numBytes) != 0)
+   {
+      ::close(fd);
+      throw std::runtime_error(std::string("Unable to size ") + path);
+   }
+
+   void * p = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (p == MAP_FAILED)
+   {
+      ::close(fd);
+      throw std::runtime_error(std::string("Unable to map ") + path);
+   }
+   pData = static_cast<unsigned char *>(p);
+}
+
+inline mapped_file :: ~mapped_file()
+{
+   msync(pData, numBytes, MS_SYNC);
+   munmap(pData, numBytes);
+   ::close(fd);
+}
+
+/*****************************************
+ * MAPPED FILE :: FLUSH (POSIX)
+ * msync wants a page-aligned address, so round the
+ * start down to its page
+ ****************************************/
+inline void mapped_file :: flush(size_t offset, size_t num)
+{
+   static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+   size_t start = offset - offset % pageSize;
+   msync(pData + start, num + (offset - start), MS_SYNC);
+}
+
+#endif // _WIN32
+
+/**************************************************
+ * PERSISTENT NODE
+ * Node with offsets instead of pointers
+ *************************************************/
+template <class T>
+struct PersistentNode
+{
+   T        data;      // user data
+   uint64_t offNext;   // offset of the next node, 0 for none
+   uint64_t offPrev;   // offset of the previous node, 0 for none
+};
+
+/**************************************************
+ * PERSISTENT LIST
+ * A list of T stored in a file
+ *************************************************/
+template <class T>
+class persistent_list
+{
+   friend class ::TestPersistentList; // give unit tests access to the privates
+   static_assert(std::is_trivially_copyable <T>::value,
+                 "persistent_list can only store trivially copyable types");
+public:
+
+   //
+   // Construct
+   //
+
+   persistent_list(const char * path, size_t capacity);
+   persistent_list(const persistent_list & rhs) = delete;
+   persistent_list & operator = (const persistent_list & rhs) = delete;
+   ~persistent_list();
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(this, pHeader->offHead); }
+   iterator end()   { return iterator(this, 0);                }
+
+   //
+   // Access
+   //
+
+   T & front()
+   {
+      assert(!empty());
+      return node(pHeader->offHead)->data;
+   }
+   T & back()
+   {
+      assert(!empty());
+      return node(pHeader->offTail)->data;
+   }
+
+   //
+   // Insert
+   //
+
+   void push_back (const T & t);
+   void push_front(const T & t);
+
+   //
+   // Remove
+   //
+
+   void pop_front();
+   void pop_back();
+   void clear()
+   {
+      while (!empty())
+         pop_back();
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()      const { return (size_t)pHeader->numElements;      }
+   bool   empty()     const { return pHeader->numElements == 0;         }
+   size_t capacity()  const { return (size_t)pHeader->capacity;         }
+   bool   recovered() const { return wasRecovered;                      }
+
+private:
+
+   typedef PersistentNode <T> ListNode;
+
+   static const uint64_t MAGIC   = 0x4C5354504E4F4445ull;   // marks our files
+   static const uint32_t VERSION = 1;
+
+   /*************************************************
+    * HEADER
+    * The first bytes of the file
+    *************************************************/
+   struct Header
+   {
+      uint64_t magic;
+      uint32_t version;
+      uint32_t nodeSize;     // sizeof(ListNode) when the file was made
+      uint64_t dataSize;     // sizeof(T) when the file was made
+      uint64_t capacity;     // how many node slots follow the header
+      uint64_t offHead;      // the first node
+      uint64_t offTail;      // the last node
+      uint64_t numElements;  // nodes on the list
+      uint64_t offFree;      // a freed slot, linked through offNext
+      uint64_t offUnused;    // the first slot never handed out
+      uint64_t clean;        // 1 when the file was closed normally
+   };
+
+   static size_t firstSlot()             { return (sizeof(Header) + alignof(ListNode) - 1) / alignof(ListNode) * alignof(ListNode); }
+   static size_t fileSize(size_t num)    { return firstSlot() + num * sizeof(ListNode); }
+
+   ListNode * node(uint64_t off) const   { return off == 0 ? nullptr : reinterpret_cast<ListNode *>(file.data() + off); }
+   void flushNode(uint64_t off)          { file.flush((size_t)off, sizeof(ListNode)); }
+   void flushHeader()                    { file.flush(0, sizeof(Header));           }
+
+   uint64_t allocate();
+   void     deallocate(uint64_t off);
+   void     format();
+   void     recover();
+
+   mapped_file file;
+   Header *    pHeader;
+   bool        wasRecovered;   // did opening the file need a repair?
+};
+
+/*************************************************
+ * PERSISTENT LIST ITERATOR
+ * Walk the list front to back by offsets
+ *************************************************/
+template <class T>
+class persistent_list <T> :: iterator
+{
+   friend class ::TestPersistentList; // give unit tests access to the privates
+public:
+   iterator() : pList(nullptr), off(0) {}
+   iterator(const persistent_list * pList, uint64_t off) : pList(pList), off(off) {}
+
+   bool operator != (const iterator & rhs) const { return rhs.off != off; }
+   bool operator == (const iterator & rhs) const { return rhs.off == off; }
+
+   T & operator * () { return pList->node(off)->data; }
+
+   iterator & operator ++ ()
+   {
+      off = pList->node(off)->offNext;
+      return *this;
+   }
+
+   iterator & operator -- ()
+   {
+      off = off == 0 ? pList->pHeader->offTail : pList->node(off)->offPrev;
+      return *this;
+   }
+
+private:
+   const persistent_list * pList;
+   uint64_t                off;
+};
+
+/*****************************************
+ * PERSISTENT LIST :: CONSTRUCTOR
+ * Open path, creating it with room for capacity nodes
+ * if it does not exist.  An existing file keeps its own
+ * capacity.  If it was not closed normally, repair it.
+ ****************************************/
+template <class T>
+persistent_list <T> :: persistent_list(const char * path, size_t capacity) :
+   file(path, fileSize(capacity)), pHeader(nullptr), wasRecovered(false)
+{
+   pHeader = reinterpret_cast<Header *>(file.data());
+
+   if (file.isNew())
+   {
+      pHeader->capacity = capacity;
+      format();
+   }
+   else if (file.size() < sizeof(Header) ||
+            pHeader->magic != MAGIC ||
+            pHeader->version != VERSION ||
+            pHeader->nodeSize != sizeof(ListNode) ||
+            pHeader->dataSize != sizeof(T) ||
+            fileSize((size_t)pHeader->capacity) > file.size())
+      throw std::runtime_error("Not a persistent list of this type");
+   else if (!pHeader->clean)
+      recover();
+
+   // from here on a crash leaves the file marked as not clean
+   pHeader->clean = 0;
+   flushHeader();
+}
+
+/*****************************************
+ * PERSISTENT LIST :: DESTRUCTOR
+ * Everything is already on disk; just say so
+ ****************************************/
+template <class T>
+persistent_list <T> :: ~persistent_list()
+{
+   pHeader->clean = 1;
+   flushHeader();
+}
+
+/*****************************************
+ * PERSISTENT LIST :: FORMAT
+ * Set up the header of a brand new file
+ ****************************************/
+template <class T>
+void persistent_list <T> :: format()
+{
+   pHeader->magic       = MAGIC;
+   pHeader->version     = VERSION;
+   pHeader->nodeSize    = sizeof(ListNode);
+   pHeader->dataSize    = sizeof(T);
+   pHeader->offHead     = 0;
+   pHeader->offTail     = 0;
+   pHeader->numElements = 0;
+   pHeader->offFree     = 0;
+   pHeader->offUnused   = firstSlot();
+   pHeader->clean       = 0;
+   flushHeader();
+}
+
+/*****************************************
+ * PERSISTENT LIST :: RECOVER
+ * The chain from offHead through offNext is always
+ * right.  Everything else is rebuilt from it: the back
+ * links, the tail, the count, and the free list (which
+ * picks up any slot that was allocated but never linked).
+ *   COST   : O(capacity)
+ ****************************************/
+template <class T>
+void persistent_list <T> :: recover()
+{
+   wasRecovered = true;
+   std::vector <bool> isUsed((size_t)pHeader->capacity, false);
+
+   uint64_t offPrev = 0;
+   uint64_t num = 0;
+   for (uint64_t off = pHeader->offHead; off != 0; off = node(off)->offNext)
+   {
+      if (num == pHeader->capacity || off < firstSlot() || off >= pHeader->offUnused)
+         throw std::runtime_error("The persistent list is damaged");
+      node(off)->offPrev = offPrev;
+      isUsed[(size_t)((off - firstSlot()) / sizeof(ListNode))] = true;
+      offPrev = off;
+      num++;
+   }
+   pHeader->offTail = offPrev;
+   pHeader->numElements = num;
+
+   // every slot below offUnused that is not on the list is free
+   pHeader->offFree = 0;
+   for (uint64_t off = pHeader->offUnused; off > firstSlot(); )
+   {
+      off -= sizeof(ListNode);
+      if (!isUsed[(size_t)((off - firstSlot()) / sizeof(ListNode))])
+      {
+         node(off)->offNext = pHeader->offFree;
+         pHeader->offFree = off;
+      }
+   }
+
+   file.flush(0, file.size());
+}
+
+/*****************************************
+ * PERSISTENT LIST :: ALLOCATE
+ * Take a slot off the free list, or the next slot that
+ * has never been used.  The header is flushed before the
+ * slot is, so it is never handed out twice.
+ *   OUTPUT : the offset of the slot
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+uint64_t persistent_list <T> :: allocate()
+{
+   uint64_t off = pHeader->offFree;
+   if (off != 0)
+      pHeader->offFree = node(off)->offNext;
+   else if (pHeader->offUnused < fileSize((size_t)pHeader->capacity))
+   {
+      off = pHeader->offUnused;
+      pHeader->offUnused += sizeof(ListNode);
+   }
+   else
+      throw std::bad_alloc();
+
+   flushHeader();
+   return off;
+}
+
+/*****************************************
+ * PERSISTENT LIST :: DEALLOCATE
+ * Put a slot that is no longer linked on the free list
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+void persistent_list <T> :: deallocate(uint64_t off)
+{
+   node(off)->offNext = pHeader->offFree;
+   flushNode(off);
+   pHeader->offFree = off;
+   flushHeader();
+}
+
+/*****************************************
+ * PERSISTENT LIST :: PUSH BACK
+ *   1. fill in the new node and flush it
+ *   2. link it after the tail and flush: it is now on the list
+ *   3. update the tail and the count and flush
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+void persistent_list <T> :: push_back(const T & t)
+{
+   uint64_t off = allocate();
+   ListNode * pNew = node(off);
+   pNew->data = t;
+   pNew->offNext = 0;
+   pNew->offPrev = pHeader->offTail;
+   flushNode(off);
+
+   if (pHeader->offTail != 0)
+   {
+      node(pHeader->offTail)->offNext = off;
+      flushNode(pHeader->offTail);
+   }
+   else
+   {
+      pHeader->offHead = off;
+      flushHeader();
+   }
+
+   pHeader->offTail = off;
+   pHeader->numElements++;
+   flushHeader();
+}
+
+/*****************************************
+ * PERSISTENT LIST :: PUSH FRONT
+ *   1. fill in the new node, pointing at the head, and flush
+ *   2. make it the head and flush: it is now on the list
+ *   3. fix the old head's back link, the tail, and the count
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+void persistent_list <T> :: push_front(const T & t)
+{
+   uint64_t off = allocate();
+   ListNode * pNew = node(off);
+   pNew->data = t;
+   pNew->offNext = pHeader->offHead;
+   pNew->offPrev = 0;
+   flushNode(off);
+
+   uint64_t offOldHead = pHeader->offHead;
+   pHeader->offHead = off;
+   flushHeader();
+
+   if (offOldHead != 0)
+   {
+      node(offOldHead)->offPrev = off;
+      flushNode(offOldHead);
+   }
+   else
+      pHeader->offTail = off;
+   pHeader->numElements++;
+   flushHeader();
+}
+
+/*****************************************
+ * PERSISTENT LIST :: POP FRONT
+ *   1. move the head past the first node and flush
+ *   2. fix the new head's back link, the tail, and the count
+ *   3. free the old node
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+void persistent_list <T> :: pop_front()
+{
+   if (empty())
+      return;
+
+   uint64_t off = pHeader->offHead;
+   uint64_t offNext = node(off)->offNext;
+   pHeader->offHead = offNext;
+   flushHeader();
+
+   if (offNext != 0)
+   {
+      node(offNext)->offPrev = 0;
+      flushNode(offNext);
+   }
+   else
+      pHeader->offTail = 0;
+   pHeader->numElements--;
+   flushHeader();
+
+   deallocate(off);
+}
+
+/*****************************************
+ * PERSISTENT LIST :: POP BACK
+ *   1. cut the last node off the chain and flush
+ *   2. update the tail and the count and flush
+ *   3. free the old node
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+void persistent_list <T> :: pop_back()
+{
+   if (empty())
+      return;
+
+   uint64_t off = pHeader->offTail;
+   uint64_t offPrev = node(off)->offPrev;
+   if (offPrev != 0)
+   {
+      node(offPrev)->offNext = 0;
+      flushNode(offPrev);
+   }
+   else
+   {
+      pHeader->offHead = 0;
+      flushHeader();
+   }
+
+   pHeader->offTail = offPrev;
+   pHeader->numElements--;
+   flushHeader();
+
+   deallocate(off);
+}
+
+} // namespace custom
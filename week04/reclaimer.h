@@ -0,0 +1,108 @@
+/***********************************************************************
+ * Header:
+ *    RECLAIMER
+ * Summary:
+ *    A background thread that frees detached data structures.  Tearing
+ *    down a very long linked list is O(n) no matter what; handing the
+ *    detached list to the reclaimer moves that cost off the calling
+ *    thread so it can get back to work right away.
+ *
+ *    This will contain the class definition of:
+ *        reclaimer              : the background thread and its queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <condition_variable>  // for std::condition_variable
+#include <deque>               // for std::deque
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+
+namespace custom
+{
+
+/*****************************************
+ * RECLAIMER
+ * Runs each submitted job on its own thread, in the
+ * order they were submitted.  The thread starts the
+ * first time the reclaimer is used and finishes every
+ * outstanding job before the program exits.
+ ****************************************/
+class reclaimer
+{
+public:
+   static reclaimer & instance()
+   {
+      static reclaimer theReclaimer;
+      return theReclaimer;
+   }
+
+   // queue p to be freed with deleter on the background thread
+   void submit(void * p, void (*deleter)(void *))
+   {
+      {
+         std::lock_guard <std::mutex> guard(lock);
+         jobs.push_back(Job{ p, deleter });
+      }
+      cvWork.notify_one();
+   }
+
+   // wait until everything submitted so far has been freed
+   void flush()
+   {
+      std::unique_lock <std::mutex> guard(lock);
+      cvIdle.wait(guard, [this]() { return jobs.empty() && !busy; });
+   }
+
+private:
+   struct Job
+   {
+      void * p;
+      void (*deleter)(void *);
+   };
+
+   reclaimer() : busy(false), done(false), worker(&reclaimer::work, this) {}
+   ~reclaimer()
+   {
+      {
+         std::lock_guard <std::mutex> guard(lock);
+         done = true;
+      }
+      cvWork.notify_one();
+      worker.join();
+   }
+
+   // the background thread: free jobs until told to stop
+   void work()
+   {
+      std::unique_lock <std::mutex> guard(lock);
+      for (;;)
+      {
+         cvWork.wait(guard, [this]() { return done || !jobs.empty(); });
+         if (jobs.empty())
+            return;
+
+         Job job = jobs.front();
+         jobs.pop_front();
+         busy = true;
+         guard.unlock();
+         job.deleter(job.p);
+         guard.lock();
+         busy = false;
+         if (jobs.empty())
+            cvIdle.notify_all();
+      }
+   }
+
+   std::mutex              lock;     // protects jobs, busy, and done
+   std::condition_variable cvWork;   // signaled when there is a job
+   std::condition_variable cvIdle;   // signaled when the queue drains
+   std::deque <Job>        jobs;     // waiting to be freed
+   bool                    busy;     // is a job being freed right now?
+   bool                    done;     // is the program shutting down?
+   std::thread             worker;   // the background thread
+};
+
+} // namespace custom
@@ -0,0 +1,569 @@
+/***********************************************************************
+ * Header:
+ *    SKIP LIST
+ * Summary:
+ *    An ordered set built out of a linked list with express lanes.
+ *    The bottom lane of the skip list is an ordinary chain of Node
+ *    objects, so the read-only functions in node.h (size, find,
+ *    for_each, and the like) work on it.  Each node also carries a
+ *    tower of forward pointers of random height, giving us O(log n)
+ *    expected search, insert, and erase.  Anything that adds or
+ *    removes nodes must go through skip_list: node.h would leave the
+ *    towers pointing at nodes that are gone.
+ *
+ *    A skip_list is not thread-safe, not even for inserts that touch
+ *    different towers: the links, the size, and the random level
+ *    generator are all plain data.  Callers that share one must lock
+ *    around it.  For an ordered set that threads can insert into at
+ *    once, use concurrent_ordered_list or lock_free_ordered_list.
+ *
+ *    This will contain the class definition of:
+ *        skip_list              : An ordered set similar to std::set
+ *        skip_list::iterator    : An iterator through the bottom lane
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // for ASSERT
+#include <cstdint>     // for uint64_t
+#include <functional>  // for std::less
+#include <new>         // for placement new
+#include <utility>     // for std::pair
+#include "node.h"      // for Node
+
+class TestSkipList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * SKIP LIST
+ * An ordered set of unique values.  Level 0 is a
+ * doubly-linked chain of Node <T>; levels 1 and up
+ * skip over roughly half the nodes of the level below.
+ ****************************************/
+template <class T, class Compare = std::less <T> >
+class skip_list
+{
+   friend class ::TestSkipList; // give unit tests access to the privates
+public:
+   static const int MAX_LEVEL = 32;
+
+   //
+   // Construct
+   //
+
+   skip_list(const Compare & compare = Compare());
+   skip_list(const Node <T> * pSorted, const Compare & compare = Compare());
+   skip_list(const skip_list &  rhs);
+   skip_list(      skip_list && rhs);
+   ~skip_list() { clear(); }
+
+   //
+   // Assign
+   //
+
+   skip_list & operator = (const skip_list & rhs);
+   skip_list & operator = (skip_list && rhs);
+   void assign(const Node <T> * pSorted);
+   void swap(skip_list & rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() const { return iterator(pHeads[0]); }
+   iterator end()   const { return iterator(nullptr);   }
+
+   //
+   // Access
+   //
+
+   iterator find       (const T & t) const;
+   iterator lower_bound(const T & t) const;
+   iterator upper_bound(const T & t) const;
+   const Node <T> * chain() const { return pHeads[0]; }
+
+   //
+   // Insert
+   //
+
+   std::pair <iterator, bool> insert(const T & t);
+
+   //
+   // Remove
+   //
+
+   size_t erase(const T & t);
+   void clear();
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+private:
+
+   struct SkipNode;
+
+   SkipNode * findPredecessors(const T & t, SkipNode * preds[]) const;
+   SkipNode * allocate(const T & t, int height);
+   void       unallocate(SkipNode * pNode);
+   void       append(SkipNode * pLast[], const T & t);
+   int        randomHeight();
+
+   SkipNode * pHeads[MAX_LEVEL];  // the first node of each level
+   SkipNode * pTail;              // the last node of level 0
+   int        numLevels;          // how many levels are in use
+   size_t     numElements;        // the number of values in the set
+   uint64_t   seed;               // state of the tower height generator
+   Compare    compare;            // the ordering of the set
+};
+
+/*****************************************
+ * SKIP LIST :: SKIP NODE
+ * A Node with a tower of next pointers for levels
+ * 1 .. height-1 stored directly after it in memory.
+ * Level 0 is the ordinary pNext.
+ ****************************************/
+template <class T, class Compare>
+struct skip_list <T, Compare> :: SkipNode : public Node <T>
+{
+   SkipNode(const T & t, int height) : Node <T>(t), height(height) {}
+
+   SkipNode ** tower() { return reinterpret_cast<SkipNode **>(this + 1); }
+
+   SkipNode * next(int level)
+   {
+      return level == 0 ? static_cast<SkipNode *>(this->pNext) : tower()[level - 1];
+   }
+
+   void setNext(int level, SkipNode * pNext)
+   {
+      if (level == 0)
+         this->pNext = pNext;
+      else
+         tower()[level - 1] = pNext;
+   }
+
+   int height;
+};
+
+/**************************************************
+ * SKIP LIST ITERATOR
+ * Walk the bottom lane in order.  The values are the
+ * keys of the set, so they cannot be changed.
+ *************************************************/
+template <class T, class Compare>
+class skip_list <T, Compare> :: iterator
+{
+   friend class ::TestSkipList; // give unit tests access to the privates
+   friend class skip_list;
+public:
+   iterator()                    : p(nullptr) {}
+   iterator(const Node <T> * p)  : p(p)       {}
+   iterator(const iterator & rhs) : p(rhs.p)  {}
+   iterator & operator = (const iterator & rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   bool operator != (const iterator & rhs) const { return rhs.p != p; }
+   bool operator == (const iterator & rhs) const { return rhs.p == p; }
+
+   const T & operator * () const { return p->data; }
+
+   iterator & operator ++ ()
+   {
+      p = p->pNext;
+      return *this;
+   }
+
+   iterator operator ++ (int postfix)
+   {
+      iterator itReturn(*this);
+      p = p->pNext;
+      return itReturn;
+   }
+
+   iterator & operator -- ()
+   {
+      p = p->pPrev;
+      return *this;
+   }
+
+   iterator operator -- (int postfix)
+   {
+      iterator itReturn(*this);
+      p = p->pPrev;
+      return itReturn;
+   }
+
+private:
+   const Node <T> * p;
+};
+
+/*****************************************
+ * SKIP LIST :: DEFAULT CONSTRUCTOR
+ ****************************************/
+template <class T, class Compare>
+skip_list <T, Compare> :: skip_list(const Compare & compare) :
+   pTail(nullptr), numLevels(1), numElements(0),
+   seed(0x9E3779B97F4A7C15ull), compare(compare)
+{
+   for (int level = 0; level < MAX_LEVEL; level++)
+      pHeads[level] = nullptr;
+}
+
+/*****************************************
+ * SKIP LIST :: SORTED CHAIN CONSTRUCTOR
+ * Build the skip list from a sorted Node chain
+ ****************************************/
+template <class T, class Compare>
+skip_list <T, Compare> :: skip_list(const Node <T> * pSorted, const Compare & compare) :
+   skip_list(compare)
+{
+   assign(pSorted);
+}
+
+/*****************************************
+ * SKIP LIST :: COPY CONSTRUCTOR
+ * The bottom lane of rhs is already sorted, so this is
+ * the same O(n) bulk build.
+ ****************************************/
+template <class T, class Compare>
+skip_list <T, Compare> :: skip_list(const skip_list & rhs) :
+   skip_list(rhs.compare)
+{
+   assign(rhs.chain());
+}
+
+/*****************************************
+ * SKIP LIST :: MOVE CONSTRUCTOR
+ ****************************************/
+template <class T, class Compare>
+skip_list <T, Compare> :: skip_list(skip_list && rhs) :
+   skip_list(rhs.compare)
+{
+   swap(rhs);
+}
+
+/*****************************************
+ * SKIP LIST :: ASSIGN
+ ****************************************/
+template <class T, class Compare>
+skip_list <T, Compare> & skip_list <T, Compare> :: operator = (const skip_list & rhs)
+{
+   if (this != &rhs)
+   {
+      compare = rhs.compare;
+      assign(rhs.chain());
+   }
+   return *this;
+}
+
+template <class T, class Compare>
+skip_list <T, Compare> & skip_list <T, Compare> :: operator = (skip_list && rhs)
+{
+   clear();
+   swap(rhs);
+   return *this;
+}
+
+/*****************************************
+ * SKIP LIST :: SWAP
+ ****************************************/
+template <class T, class Compare>
+void skip_list <T, Compare> :: swap(skip_list & rhs)
+{
+   for (int level = 0; level < MAX_LEVEL; level++)
+      std::swap(pHeads[level], rhs.pHeads[level]);
+   std::swap(pTail,       rhs.pTail);
+   std::swap(numLevels,   rhs.numLevels);
+   std::swap(numElements, rhs.numElements);
+   std::swap(seed,        rhs.seed);
+   std::swap(compare,     rhs.compare);
+}
+
+/*****************************************
+ * SKIP LIST :: ASSIGN SORTED CHAIN
+ * Replace the contents with the values of a sorted
+ * Node chain.  Since the input is in order, every new
+ * node goes on the end of each of its levels and we
+ * never have to search.  Duplicates are skipped.
+ *   INPUT  : pSorted - a chain sorted by compare
+ *   COST   : O(n)
+ ****************************************/
+template <class T, class Compare>
+void skip_list <T, Compare> :: assign(const Node <T> * pSorted)
+{
+   clear();
+
+   SkipNode * pLast[MAX_LEVEL] = {};
+   for (const Node <T> * p = pSorted; p != nullptr; p = p->pNext)
+   {
+      assert(pTail == nullptr || !compare(p->data, pTail->data));
+      if (pTail == nullptr || compare(pTail->data, p->data))
+         append(pLast, p->data);
+   }
+}
+
+/*****************************************
+ * SKIP LIST :: FIND
+ ****************************************/
+template <class T, class Compare>
+typename skip_list <T, Compare> :: iterator
+skip_list <T, Compare> :: find(const T & t) const
+{
+   iterator it = lower_bound(t);
+   if (it.p != nullptr && !compare(t, it.p->data))
+      return it;
+   return end();
+}
+
+/*****************************************
+ * SKIP LIST :: LOWER BOUND
+ * The first value that is not less than t
+ ****************************************/
+template <class T, class Compare>
+typename skip_list <T, Compare> :: iterator
+skip_list <T, Compare> :: lower_bound(const T & t) const
+{
+   SkipNode * pPrev = nullptr;
+   for (int level = numLevels - 1; level >= 0; level--)
+   {
+      SkipNode * pNext = pPrev ? pPrev->next(level) : pHeads[level];
+      while (pNext != nullptr && compare(pNext->data, t))
+      {
+         pPrev = pNext;
+         pNext = pNext->next(level);
+      }
+   }
+   return iterator(pPrev ? pPrev->next(0) : pHeads[0]);
+}
+
+/*****************************************
+ * SKIP LIST :: UPPER BOUND
+ * The first value that is greater than t
+ ****************************************/
+template <class T, class Compare>
+typename skip_list <T, Compare> :: iterator
+skip_list <T, Compare> :: upper_bound(const T & t) const
+{
+   SkipNode * pPrev = nullptr;
+   for (int level = numLevels - 1; level >= 0; level--)
+   {
+      SkipNode * pNext = pPrev ? pPrev->next(level) : pHeads[level];
+      while (pNext != nullptr && !compare(t, pNext->data))
+      {
+         pPrev = pNext;
+         pNext = pNext->next(level);
+      }
+   }
+   return iterator(pPrev ? pPrev->next(0) : pHeads[0]);
+}
+
+/*****************************************
+ * SKIP LIST :: INSERT
+ * Add t to the set if it is not already there.
+ *   OUTPUT : the node holding t, and whether it is new
+ *   COST   : O(log n) expected
+ ****************************************/
+template <class T, class Compare>
+std::pair <typename skip_list <T, Compare> :: iterator, bool>
+skip_list <T, Compare> :: insert(const T & t)
+{
+   SkipNode * preds[MAX_LEVEL];
+   SkipNode * pFound = findPredecessors(t, preds);
+   if (pFound != nullptr && !compare(t, pFound->data))
+      return std::make_pair(iterator(pFound), false);
+
+   int height = randomHeight();
+   for (int level = numLevels; level < height; level++)
+      preds[level] = nullptr;
+   if (height > numLevels)
+      numLevels = height;
+
+   SkipNode * pNew = allocate(t, height);
+   for (int level = 0; level < height; level++)
+   {
+      if (preds[level])
+      {
+         pNew->setNext(level, preds[level]->next(level));
+         preds[level]->setNext(level, pNew);
+      }
+      else
+      {
+         pNew->setNext(level, pHeads[level]);
+         pHeads[level] = pNew;
+      }
+   }
+
+   // level 0 is doubly linked
+   pNew->pPrev = preds[0];
+   if (pNew->pNext)
+      pNew->pNext->pPrev = pNew;
+   else
+      pTail = pNew;
+
+   numElements++;
+   return std::make_pair(iterator(pNew), true);
+}
+
+/*****************************************
+ * SKIP LIST :: ERASE
+ * Remove t from the set
+ *   OUTPUT : the number of values removed (0 or 1)
+ *   COST   : O(log n) expected
+ ****************************************/
+template <class T, class Compare>
+size_t skip_list <T, Compare> :: erase(const T & t)
+{
+   SkipNode * preds[MAX_LEVEL];
+   SkipNode * pErase = findPredecessors(t, preds);
+   if (pErase == nullptr || compare(t, pErase->data))
+      return 0;
+
+   for (int level = 0; level < pErase->height; level++)
+   {
+      if (preds[level])
+         preds[level]->setNext(level, pErase->next(level));
+      else
+         pHeads[level] = pErase->next(level);
+   }
+
+   if (pErase->pNext)
+      pErase->pNext->pPrev = pErase->pPrev;
+   else
+      pTail = preds[0];
+
+   while (numLevels > 1 && pHeads[numLevels - 1] == nullptr)
+      numLevels--;
+
+   unallocate(pErase);
+   numElements--;
+   return 1;
+}
+
+/*****************************************
+ * SKIP LIST :: CLEAR
+ * Free every node by walking the bottom lane
+ ****************************************/
+template <class T, class Compare>
+void skip_list <T, Compare> :: clear()
+{
+   SkipNode * p = pHeads[0];
+   while (p != nullptr)
+   {
+      SkipNode * pDelete = p;
+      p = p->next(0);
+      unallocate(pDelete);
+   }
+
+   for (int level = 0; level < MAX_LEVEL; level++)
+      pHeads[level] = nullptr;
+   pTail = nullptr;
+   numLevels = 1;
+   numElements = 0;
+}
+
+/*****************************************
+ * SKIP LIST :: FIND PREDECESSORS
+ * Fill preds[] with the last node on each level that is
+ * less than t (nullptr meaning the head of the level).
+ *   OUTPUT : the first node not less than t, or nullptr
+ ****************************************/
+template <class T, class Compare>
+typename skip_list <T, Compare> :: SkipNode *
+skip_list <T, Compare> :: findPredecessors(const T & t, SkipNode * preds[]) const
+{
+   SkipNode * pPrev = nullptr;
+   for (int level = numLevels - 1; level >= 0; level--)
+   {
+      SkipNode * pNext = pPrev ? pPrev->next(level) : pHeads[level];
+      while (pNext != nullptr && compare(pNext->data, t))
+      {
+         pPrev = pNext;
+         pNext = pNext->next(level);
+      }
+      preds[level] = pPrev;
+   }
+   return pPrev ? pPrev->next(0) : pHeads[0];
+}
+
+/*****************************************
+ * SKIP LIST :: ALLOCATE
+ * One allocation holds the node and its tower.  It
+ * comes from Node's own operator new so the memory
+ * matches what Node's operator delete expects.
+ ****************************************/
+template <class T, class Compare>
+typename skip_list <T, Compare> :: SkipNode *
+skip_list <T, Compare> :: allocate(const T & t, int height)
+{
+   void * pRaw = Node <T>::operator new(sizeof(SkipNode) + (height - 1) * sizeof(SkipNode *));
+   SkipNode * pNode = ::new (pRaw) SkipNode(t, height);
+   for (int level = 1; level < height; level++)
+      pNode->tower()[level - 1] = nullptr;
+   return pNode;
+}
+
+template <class T, class Compare>
+void skip_list <T, Compare> :: unallocate(SkipNode * pNode)
+{
+   pNode->~SkipNode();
+   Node <T>::operator delete(static_cast<void *>(pNode));
+}
+
+/*****************************************
+ * SKIP LIST :: APPEND
+ * Put t after every node in pLast[], the current end
+ * of each level.  Used by the bulk build.
+ ****************************************/
+template <class T, class Compare>
+void skip_list <T, Compare> :: append(SkipNode * pLast[], const T & t)
+{
+   int height = randomHeight();
+   if (height > numLevels)
+      numLevels = height;
+
+   SkipNode * pNew = allocate(t, height);
+   for (int level = 0; level < height; level++)
+   {
+      if (pLast[level])
+         pLast[level]->setNext(level, pNew);
+      else
+         pHeads[level] = pNew;
+      pLast[level] = pNew;
+   }
+
+   pNew->pPrev = pTail;
+   pTail = pNew;
+   numElements++;
+}
+
+/*****************************************
+ * SKIP LIST :: RANDOM HEIGHT
+ * Each level is half as likely as the one below it.
+ * A xorshift generator is plenty random for this.
+ ****************************************/
+template <class T, class Compare>
+int skip_list <T, Compare> :: randomHeight()
+{
+   seed ^= seed << 13;
+   seed ^= seed >> 7;
+   seed ^= seed << 17;
+
+   int height = 1;
+   for (uint64_t bits = seed; (bits & 1) && height < MAX_LEVEL; bits >>= 1)
+      height++;
+   return height;
+}
+
+} // namespace custom
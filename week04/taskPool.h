@@ -0,0 +1,355 @@
+/***********************************************************************
+ * Header:
+ *    TASK POOL
+ * Summary:
+ *    A fork/join scheduler built on ws_deque.  Each worker thread owns a
+ *    deque: tasks it spawns go on its bottom and it runs them newest
+ *    first, so a recursive algorithm stays depth-first and cache-warm on
+ *    each thread.  A worker with nothing to do steals the oldest task
+ *    from a random other worker.  Only tasks submitted from outside the
+ *    pool go through a shared, locked queue, and a spawn only takes that
+ *    lock to wake a worker when one is asleep.
+ *
+ *    A thread that waits on a group does not block while the group
+ *    still has work: it runs tasks itself, so a task can spawn children
+ *    and wait for them without tying up a worker.
+ *
+ *    This will contain the class definition of:
+ *        task_pool              : the worker threads and their deques
+ *        task_pool::group       : a set of tasks that can be waited on
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>              // for std::atomic
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for std::deque
+#include <exception>           // for std::exception_ptr
+#include <functional>          // for std::function
+#include <memory>              // for std::unique_ptr
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include <utility>             // for std::forward
+#include <vector>              // for std::vector
+#include "wsDeque.h"           // for ws_deque
+
+class TestTaskPool; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * TASK POOL
+ * A fixed set of worker threads sharing work by
+ * stealing
+ *************************************************/
+class task_pool
+{
+   friend class ::TestTaskPool; // give unit tests access to the privates
+public:
+
+   /*************************************************
+    * GROUP
+    * Counts the tasks spawned into it that have not
+    * finished, and keeps the first exception thrown
+    * by one of them for wait() to rethrow.
+    *************************************************/
+   class group
+   {
+      friend class task_pool;
+   public:
+      group() : numPending(0) {}
+      group(const group & rhs) = delete;
+      group & operator = (const group & rhs) = delete;
+
+      bool done() const { return numPending.load() == 0; }
+
+   private:
+      std::atomic <size_t> numPending;  // spawned but not finished
+      std::mutex           lockError;   // protects error
+      std::exception_ptr   error;       // the first exception thrown
+   };
+
+   //
+   // Construct
+   //
+
+   task_pool(size_t numThreads = std::thread::hardware_concurrency());
+   task_pool(const task_pool & rhs) = delete;
+   task_pool & operator = (const task_pool & rhs) = delete;
+   ~task_pool();
+
+   //
+   // Fork and join
+   //
+
+   template <class F>
+   void spawn(group & g, F && f);
+   void wait(group & g);
+
+   //
+   // Status
+   //
+
+   size_t size() const { return workers.size(); }
+
+private:
+
+   /*************************************************
+    * TASK
+    * The work and the group it reports to
+    *************************************************/
+   struct Task
+   {
+      std::function <void()> work;
+      group *                pGroup;
+   };
+
+   /*************************************************
+    * WORKER
+    * One thread and the deque it owns
+    *************************************************/
+   struct Worker
+   {
+      ws_deque <Task *> deque;
+      std::thread       thread;
+   };
+
+   void   loop(size_t iWorker);
+   Task * find(size_t iWorker);
+   void   execute(Task * pTask);
+   void   submit(Task * pTask);
+
+   // which worker of which pool the calling thread is, if any
+   static task_pool * & currentPool()  { static thread_local task_pool * p = nullptr; return p; }
+   static size_t      & currentIndex() { static thread_local size_t i = 0;           return i; }
+
+   std::vector <std::unique_ptr <Worker> > workers;
+   std::mutex                lockShared;    // protects shared and guards sleeping
+   std::deque <Task *>       shared;        // tasks submitted from outside the pool
+   std::condition_variable   wakeup;        // idle workers sleep here
+   std::atomic <size_t>      numQueued;     // tasks waiting anywhere to be run
+   std::atomic <size_t>      numSleeping;   // workers asleep or about to be
+   std::atomic <bool>        stopping;      // the destructor has been called
+};
+
+/*****************************************
+ * TASK POOL :: CONSTRUCTOR
+ * Start the workers.  Every deque exists before any
+ * thread starts, so thieves never see a missing one.
+ ****************************************/
+inline task_pool :: task_pool(size_t numThreads) : numQueued(0), numSleeping(0), stopping(false)
+{
+   if (numThreads == 0)
+      numThreads = 1;
+   for (size_t i = 0; i < numThreads; i++)
+      workers.push_back(std::unique_ptr <Worker>(new Worker));
+   for (size_t i = 0; i < numThreads; i++)
+      workers[i]->thread = std::thread([this, i]() { loop(i); });
+}
+
+/*****************************************
+ * TASK POOL :: DESTRUCTOR
+ * Tell the workers to finish and wait for them.  Work
+ * should already have been waited on; anything left is
+ * dropped.
+ ****************************************/
+inline task_pool :: ~task_pool()
+{
+   {
+      std::lock_guard <std::mutex> guard(lockShared);
+      stopping.store(true);
+   }
+   wakeup.notify_all();
+   for (auto & pWorker : workers)
+      pWorker->thread.join();
+
+   Task * pTask;
+   for (auto & pWorker : workers)
+      while (pWorker->deque.pop(pTask))
+         delete pTask;
+   for (Task * p : shared)
+      delete p;
+}
+
+/*****************************************
+ * TASK POOL :: SPAWN
+ * Add f to the pool as part of g.  From a worker it
+ * goes on that worker's own deque; from anywhere else
+ * it goes on the shared queue.
+ *   INPUT  : g - the group to count it in
+ *            f - what to run, taking no parameters
+ *   COST   : O(1)
+ ****************************************/
+template <class F>
+void task_pool :: spawn(group & g, F && f)
+{
+   g.numPending++;
+   submit(new Task { std::function <void()>(std::forward <F>(f)), &g });
+}
+
+inline void task_pool :: submit(Task * pTask)
+{
+   // count it first so it is never taken before it is counted
+   numQueued++;
+   if (currentPool() == this)
+      workers[currentIndex()]->deque.push(pTask);
+   else
+   {
+      std::lock_guard <std::mutex> guard(lockShared);
+      shared.push_back(pTask);
+   }
+
+   // a worker counts itself in numSleeping before it checks
+   // numQueued, so one of us sees the other.  With nobody
+   // asleep there is nothing to lock or notify.
+   if (numSleeping.load() != 0)
+   {
+      // taking the lock means a worker between checking
+      // numQueued and sleeping cannot miss the notify
+      {
+         std::lock_guard <std::mutex> guard(lockShared);
+      }
+      wakeup.notify_one();
+   }
+}
+
+/*****************************************
+ * TASK POOL :: WAIT
+ * Return once every task in g has finished, running
+ * tasks (from g or not) in the meantime.  Rethrows the
+ * first exception a task in g threw.
+ *   INPUT  : g - the group to wait on
+ ****************************************/
+inline void task_pool :: wait(group & g)
+{
+   size_t iWorker = (currentPool() == this ? currentIndex() : workers.size());
+   while (!g.done())
+   {
+      Task * pTask = find(iWorker);
+      if (pTask)
+         execute(pTask);
+      else
+         std::this_thread::yield();
+   }
+
+   std::exception_ptr error;
+   {
+      std::lock_guard <std::mutex> guard(g.lockError);
+      std::swap(error, g.error);
+   }
+   if (error)
+      std::rethrow_exception(error);
+}
+
+/*****************************************
+ * TASK POOL :: FIND
+ * Find something to run: our own newest task first,
+ * then the shared queue, then the oldest task of
+ * each other worker, starting from a different one
+ * each time.
+ *   INPUT  : iWorker - who is asking; size() if
+ *                      it is not one of the workers
+ *   OUTPUT : a task now owned by the caller, or nullptr
+ ****************************************/
+inline task_pool::Task * task_pool :: find(size_t iWorker)
+{
+   Task * pTask = nullptr;
+   size_t num = workers.size();
+
+   if (iWorker < num && workers[iWorker]->deque.pop(pTask))
+   {
+      numQueued--;
+      return pTask;
+   }
+
+   if (numQueued.load() == 0)
+      return nullptr;
+
+   {
+      std::lock_guard <std::mutex> guard(lockShared);
+      if (!shared.empty())
+      {
+         pTask = shared.front();
+         shared.pop_front();
+         numQueued--;
+         return pTask;
+      }
+   }
+
+   static thread_local size_t seed = 0;
+   size_t iStart = seed++;
+   for (size_t i = 0; i < num; i++)
+   {
+      size_t iVictim = (iStart + i) % num;
+      if (iVictim != iWorker && workers[iVictim]->deque.steal(pTask))
+      {
+         numQueued--;
+         return pTask;
+      }
+   }
+   return nullptr;
+}
+
+/*****************************************
+ * TASK POOL :: EXECUTE
+ * Run a task, remember its exception if it throws,
+ * and count it off its group
+ ****************************************/
+inline void task_pool :: execute(Task * pTask)
+{
+   group * pGroup = pTask->pGroup;
+   try
+   {
+      pTask->work();
+   }
+   catch (...)
+   {
+      std::lock_guard <std::mutex> guard(pGroup->lockError);
+      if (!pGroup->error)
+         pGroup->error = std::current_exception();
+   }
+   delete pTask;
+   pGroup->numPending--;
+}
+
+/*****************************************
+ * TASK POOL :: LOOP
+ * What each worker thread does until the pool stops:
+ * run what it can find, and sleep when nothing is
+ * queued anywhere
+ ****************************************/
+inline void task_pool :: loop(size_t iWorker)
+{
+   currentPool() = this;
+   currentIndex() = iWorker;
+
+   while (!stopping.load())
+   {
+      Task * pTask = find(iWorker);
+      if (pTask)
+      {
+         execute(pTask);
+         continue;
+      }
+
+      if (numQueued.load() != 0)
+      {
+         // queued somewhere but we lost the race for it
+         std::this_thread::yield();
+         continue;
+      }
+
+      std::unique_lock <std::mutex> lock(lockShared);
+      numSleeping++;
+      wakeup.wait(lock, [this]() { return stopping.load() || numQueued.load() != 0; });
+      numSleeping--;
+   }
+
+   currentPool() = nullptr;
+}
+
+} // namespace custom
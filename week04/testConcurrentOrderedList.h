@@ -0,0 +1,342 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT ORDERED LIST
+ * Summary:
+ *    Unit tests for concurrent_ordered_list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrentOrderedList.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestConcurrentOrderedList : public UnitTest
+{
+   typedef custom::concurrent_ordered_list <Spy> SpyList;
+   typedef custom::concurrent_ordered_list <int> IntList;
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_insert_coupling();
+      test_insert_optimistic();
+      test_insert_duplicate();
+
+      // Access
+      test_contains_coupling();
+      test_contains_optimistic();
+
+      // Remove
+      test_remove_coupling();
+      test_remove_optimistic();
+
+      // Threads
+      test_threads_coupling();
+      test_threads_optimistic();
+
+      report("ConcurrentOrderedList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      SpyList l;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(l.mode == SpyList::COUPLING);
+      assertUnit(l.head.pNext.load() == nullptr);
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // inserting out of order still leaves the list sorted
+   void test_insert_coupling()
+   {  // setup
+      SpyList l(SpyList::COUPLING);
+      Spy::reset();
+      // exercise
+      setupStandardFixture(l);
+      // verify
+      assertUnit(Spy::numCopy() == 3);         // copy [11][26][31] into nodes
+      assertStandardFixture(l);
+   }  // teardown
+
+   // same, finding the spot optimistically
+   void test_insert_optimistic()
+   {  // setup
+      SpyList l(SpyList::OPTIMISTIC);
+      Spy::reset();
+      // exercise
+      setupStandardFixture(l);
+      // verify
+      assertUnit(Spy::numCopy() == 3);         // copy [11][26][31] into nodes
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a value already in the list is not added again
+   void test_insert_duplicate()
+   {  // setup
+      SpyList l(SpyList::OPTIMISTIC);
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      bool added = l.insert(Spy(26));
+      // verify
+      assertUnit(!added);
+      assertUnit(Spy::numCopy() == 0);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // look for values in and out of the list, hand-over-hand
+   void test_contains_coupling()
+   {  // setup
+      SpyList l(SpyList::COUPLING);
+      setupStandardFixture(l);
+      // exercise
+      bool has11 = l.contains(Spy(11));
+      bool has31 = l.contains(Spy(31));
+      bool has20 = l.contains(Spy(20));
+      bool has99 = l.contains(Spy(99));
+      // verify
+      assertUnit(has11 && has31);
+      assertUnit(!has20 && !has99);
+      assertUnit(allUnlocked(l));
+   }  // teardown
+
+   // same, without taking any locks
+   void test_contains_optimistic()
+   {  // setup
+      SpyList l(SpyList::OPTIMISTIC);
+      setupStandardFixture(l);
+      // exercise
+      bool has11 = l.contains(Spy(11));
+      bool has31 = l.contains(Spy(31));
+      bool has20 = l.contains(Spy(20));
+      bool has99 = l.contains(Spy(99));
+      // verify
+      assertUnit(has11 && has31);
+      assertUnit(!has20 && !has99);
+      assertUnit(allUnlocked(l));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // remove the middle value, hand-over-hand
+   void test_remove_coupling()
+   {  // setup
+      SpyList l(SpyList::COUPLING);
+      setupStandardFixture(l);
+      // exercise
+      bool removed26 = l.remove(Spy(26));
+      bool removed99 = l.remove(Spy(99));
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(removed26 && !removed99);
+      assertUnit(l.size() == 2);
+      assertUnit(!l.contains(Spy(26)));
+      assertUnit(l.contains(Spy(11)) && l.contains(Spy(31)));
+      assertUnit(allUnlocked(l));
+   }  // teardown
+
+   // remove the ends, optimistically; nodes are freed through EBR
+   void test_remove_optimistic()
+   {  // setup
+      SpyList l(SpyList::OPTIMISTIC);
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      bool removed11 = l.remove(Spy(11));
+      bool removed31 = l.remove(Spy(31));
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(removed11 && removed31);
+      assertUnit(Spy::numDestructor() == 4);   // two arguments, two nodes
+      assertUnit(l.size() == 1);
+      assertUnit(l.head.pNext.load() != nullptr);
+      if (l.head.pNext.load())
+      {
+         assertUnit(l.head.pNext.load()->data == Spy(26));
+         assertUnit(l.head.pNext.load()->pNext.load() == nullptr);
+      }
+      assertUnit(allUnlocked(l));
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // a mostly-read workload, hand-over-hand
+   void test_threads_coupling()
+   {  // setup
+      IntList l(IntList::COUPLING);
+      // exercise
+      bool isValid = runMixedWorkload(l);
+      // verify
+      assertUnit(isValid);
+      assertUnit(isSorted(l));
+   }  // teardown
+
+   // the same workload, optimistically
+   void test_threads_optimistic()
+   {  // setup
+      IntList l(IntList::OPTIMISTIC);
+      // exercise
+      bool isValid = runMixedWorkload(l);
+      // verify
+      assertUnit(isValid);
+      assertUnit(isSorted(l));
+   }  // teardown
+
+   /*************************************************************
+    * RUN MIXED WORKLOAD
+    * Each thread owns the keys equal to its number mod the
+    * thread count, so it knows exactly what should be there.
+    * 90% of the operations read, 5% insert, 5% remove.
+    *************************************************************/
+   bool runMixedWorkload(IntList& l)
+   {
+      const int NUM_THREADS = 4;
+      const int NUM_KEYS = 256;
+      const int NUM_OPERATIONS = 4000;
+      std::vector <std::thread> threads;
+      std::vector <char> isValid(NUM_THREADS, 1);
+      std::vector <std::vector <char>> isPresent(NUM_THREADS, std::vector <char>(NUM_KEYS, 0));
+
+      for (int id = 0; id < NUM_THREADS; id++)
+         threads.push_back(std::thread([&, id]()
+         {
+            unsigned int seed = 26 + id;
+            for (int i = 0; i < NUM_OPERATIONS; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               int key = (int)((seed >> 8) % NUM_KEYS) / NUM_THREADS * NUM_THREADS + id;
+               int slot = key / NUM_THREADS;
+               int choice = (seed >> 20) % 100;
+               if (choice < 90)
+                  l.contains((key + 1) % NUM_KEYS);            // someone else's key
+               else if (choice < 95)
+               {
+                  if (l.insert(key) == (bool)isPresent[id][slot])
+                     isValid[id] = 0;
+                  isPresent[id][slot] = 1;
+               }
+               else
+               {
+                  if (l.remove(key) != (bool)isPresent[id][slot])
+                     isValid[id] = 0;
+                  isPresent[id][slot] = 0;
+               }
+            }
+
+            for (int slot = 0; slot < NUM_KEYS / NUM_THREADS; slot++)
+               if (l.contains(slot * NUM_THREADS + id) != (bool)isPresent[id][slot])
+                  isValid[id] = 0;
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      custom::ebr::synchronize();
+
+      size_t numPresent = 0;
+      for (int id = 0; id < NUM_THREADS; id++)
+      {
+         if (!isValid[id])
+            return false;
+         for (char present : isPresent[id])
+            numPresent += present;
+      }
+      return numPresent == l.size();
+   }
+
+   /*************************************************************
+    * IS SORTED
+    * Strictly increasing with no marked nodes left behind
+    *************************************************************/
+   bool isSorted(IntList& l)
+   {
+      size_t num = 0;
+      for (auto p = l.head.pNext.load(); p; p = p->pNext.load(), num++)
+         if (p->marked.load() || (p->pNext.load() && !(p->data < p->pNext.load()->data)))
+            return false;
+      return num == l.size();
+   }
+
+   /*************************************************************
+    * ALL UNLOCKED
+    * Every lock in the list can be taken right now
+    *************************************************************/
+   bool allUnlocked(SpyList& l)
+   {
+      if (!l.head.lock.try_lock())
+         return false;
+      l.head.lock.unlock();
+      for (auto p = l.head.pNext.load(); p; p = p->pNext.load())
+      {
+         if (!p->lock.try_lock())
+            return false;
+         p->lock.unlock();
+      }
+      return true;
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void setupStandardFixture(SpyList& l)
+   {
+      l.insert(Spy(26));
+      l.insert(Spy(31));
+      l.insert(Spy(11));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void assertStandardFixtureParameters(SpyList& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      auto p = l.head.pNext.load();
+      assertIndirect(p != nullptr);
+      if (p && p->pNext.load() && p->pNext.load()->pNext.load())
+      {
+         assertIndirect(p->data == Spy(11));
+         assertIndirect(p->pNext.load()->data == Spy(26));
+         assertIndirect(p->pNext.load()->pNext.load()->data == Spy(31));
+         assertIndirect(p->pNext.load()->pNext.load()->pNext.load() == nullptr);
+      }
+      assertIndirect(allUnlocked(l));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,253 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT QUEUE
+ * Summary:
+ *    Unit tests for concurrent_queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrentQueue.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestConcurrentQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_standard();
+
+      // Insert
+      test_pushCopy_empty();
+      test_pushMove_standard();
+
+      // Remove
+      test_pop_empty();
+      test_pop_standard();
+
+      // Threads
+      test_threads_order();
+      test_threads_emptyDuringPop();
+
+      report("ConcurrentQueue");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor: only the dummy, which holds no value
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::concurrent_queue <Spy> q;
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(q.pHead.load() != nullptr);
+      assertUnit(q.pHead.load() == q.pTail.load());
+      assertUnit(q.empty());
+   }  // teardown
+
+   // the destructor frees what is left, but no value for the dummy
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::concurrent_queue <Spy> q;
+         setupStandardFixture(q);
+         Spy::reset();
+      // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 3);   // destroy [11][26][31]
+      assertUnit(Spy::numDelete() == 3);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push a copy onto an empty queue
+   void test_pushCopy_empty()
+   {  // setup
+      custom::concurrent_queue <Spy> q;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      q.push(s26);
+      // verify
+      assertUnit(Spy::numCopy() == 1);         // copy [26] into the node
+      assertUnit(Spy::numAlloc() == 1);
+      assertUnit(!q.empty());
+      assertUnit(q.pTail.load() == q.pHead.load()->pNext.load());
+      if (q.pTail.load())
+         assertUnit(q.pTail.load()->data() == Spy(26));
+   }  // teardown
+
+   // move onto the back of [11][26][31]
+   void test_pushMove_standard()
+   {  // setup
+      custom::concurrent_queue <Spy> q;
+      setupStandardFixture(q);
+      Spy s99(99);
+      Spy::reset();
+      // exercise
+      q.push(std::move(s99));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);     // move [99] into the node
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(s99.empty());
+      assertUnit(q.pTail.load() != nullptr);
+      if (q.pTail.load())
+      {
+         assertUnit(q.pTail.load()->data() == Spy(99));
+         assertUnit(q.pTail.load()->pNext.load() == nullptr);
+      }
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop from an empty queue
+   void test_pop_empty()
+   {  // setup
+      custom::concurrent_queue <Spy> q;
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = q.pop(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value.empty());
+      assertUnit(Spy::numAssignMove() == 0);
+   }  // teardown
+
+   // pop everything from [11][26][31] in FIFO order
+   void test_pop_standard()
+   {  // setup
+      custom::concurrent_queue <Spy> q;
+      setupStandardFixture(q);
+      Spy s11, s26, s31, sEmpty;
+      Spy::reset();
+      // exercise
+      bool popped11 = q.pop(s11);
+      bool popped26 = q.pop(s26);
+      bool popped31 = q.pop(s31);
+      bool poppedEmpty = q.pop(sEmpty);
+      // verify
+      assertUnit(Spy::numAssignMove() == 3);   // move each value out
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 3);   // the moved-from values
+      assertUnit(popped11 && popped26 && popped31 && !poppedEmpty);
+      assertUnit(s11 == Spy(11));
+      assertUnit(s26 == Spy(26));
+      assertUnit(s31 == Spy(31));
+      assertUnit(q.empty());
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // several producers and consumers; each producer's values
+   // come out in the order they went in
+   void test_threads_order()
+   {  // setup
+      const int NUM_THREADS = 4;
+      const int NUM_EACH = 10000;
+      custom::concurrent_queue <int> q;
+      std::vector <std::thread> threads;
+      std::vector <int> counts(NUM_THREADS, 0);
+      std::vector <char> inOrder(NUM_THREADS, 1);
+      // exercise
+      for (int i = 0; i < NUM_THREADS; i++)
+         threads.push_back(std::thread([&q, i, NUM_EACH]()
+         {
+            for (int j = 0; j < NUM_EACH; j++)
+               q.push(i * NUM_EACH + j);
+         }));
+      for (int i = 0; i < NUM_THREADS; i++)
+         threads.push_back(std::thread([&q, &counts, &inOrder, i, NUM_EACH, NUM_THREADS]()
+         {
+            std::vector <int> last(NUM_THREADS, -1);
+            int value;
+            while (counts[i] < NUM_EACH)
+               if (q.pop(value))
+               {
+                  int producer = value / NUM_EACH;
+                  if (value <= last[producer])
+                     inOrder[i] = 0;
+                  last[producer] = value;
+                  counts[i]++;
+               }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      for (int i = 0; i < NUM_THREADS; i++)
+         assertUnit(inOrder[i] == 1);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // asking whether it is empty while others pop is safe
+   void test_threads_emptyDuringPop()
+   {  // setup
+      const int NUM_POPPERS = 4;
+      const int NUM_CHECKERS = 2;
+      const int NUM_VALUES = 40000;
+      custom::concurrent_queue <int> q;
+      for (int i = 0; i < NUM_VALUES; i++)
+         q.push(i);
+      std::atomic <int> numPopped(0);
+      std::vector <std::thread> threads;
+      // exercise
+      for (int i = 0; i < NUM_POPPERS; i++)
+         threads.push_back(std::thread([&q, &numPopped]()
+         {
+            int value;
+            while (q.pop(value))
+               numPopped++;
+         }));
+      for (int i = 0; i < NUM_CHECKERS; i++)
+         threads.push_back(std::thread([&q]()
+         {
+            // the dummy it looks at may be retired at any moment
+            while (!q.empty())
+               ;
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      assertUnit(numPopped.load() == NUM_VALUES);
+      assertUnit(q.empty());
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    [11][26][31] with 11 at the front
+    *************************************************************/
+   void setupStandardFixture(custom::concurrent_queue <Spy>& q)
+   {
+      q.push(Spy(11));
+      q.push(Spy(26));
+      q.push(Spy(31));
+   }
+};
+
+#endif // DEBUG
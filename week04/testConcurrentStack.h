@@ -0,0 +1,307 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT STACK
+ * Summary:
+ *    Unit tests for concurrent_stack
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrentStack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestConcurrentStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_standard();
+
+      // Insert
+      test_pushCopy_empty();
+      test_pushMove_empty();
+
+      // Remove
+      test_pop_empty();
+      test_pop_standard();
+
+      // Eliminate
+      test_eliminatePush_noPop();
+      test_eliminatePop_noPush();
+      test_eliminatePop_offer();
+
+      // Threads
+      test_threads_pushPop();
+      test_threads_contended();
+
+      report("ConcurrentStack");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::concurrent_stack <Spy> s;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(s.pTop.load() == nullptr);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // the destructor frees what is left
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::concurrent_stack <Spy> s;
+         setupStandardFixture(s);
+         Spy::reset();
+      // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 3);   // destroy [11][26][31]
+      assertUnit(Spy::numDelete() == 3);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push a copy onto an empty stack
+   void test_pushCopy_empty()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      s.push(s26);
+      // verify
+      assertUnit(Spy::numCopy() == 1);         // copy [26] into the node
+      assertUnit(Spy::numAlloc() == 1);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(s.pTop.load() != nullptr);
+      if (s.pTop.load())
+      {
+         assertUnit(s.pTop.load()->data == Spy(26));
+         assertUnit(s.pTop.load()->pNext.load() == nullptr);
+      }
+   }  // teardown
+
+   // move onto an empty stack
+   void test_pushMove_empty()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      s.push(std::move(s26));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);     // move [26] into the node
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(s26.empty());
+      assertUnit(!s.empty());
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop from an empty stack
+   void test_pop_empty()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = s.pop(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value.empty());
+      assertUnit(Spy::numAssignMove() == 0);
+   }  // teardown
+
+   // pop everything from [11][26][31] in LIFO order
+   void test_pop_standard()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      setupStandardFixture(s);
+      Spy s31, s26, s11, sEmpty;
+      Spy::reset();
+      // exercise
+      bool popped31 = s.pop(s31);
+      bool popped26 = s.pop(s26);
+      bool popped11 = s.pop(s11);
+      bool poppedEmpty = s.pop(sEmpty);
+      custom::reclaim();
+      // verify
+      assertUnit(Spy::numAssignMove() == 3);   // move each value out
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 3);   // the three retired nodes
+      assertUnit(popped31 && popped26 && popped11 && !poppedEmpty);
+      assertUnit(s31 == Spy(31));
+      assertUnit(s26 == Spy(26));
+      assertUnit(s11 == Spy(11));
+      assertUnit(s.empty());
+   }  // teardown
+
+   /***************************************
+    * ELIMINATE
+    ***************************************/
+
+   // a push with nobody to meet takes its offer back
+   void test_eliminatePush_noPop()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      auto * pNew = new custom::concurrent_stack <Spy>::StackNode(Spy(99));
+      Spy::reset();
+      // exercise
+      bool eliminated = s.eliminatePush(pNew, 0);
+      // verify
+      assertUnit(!eliminated);
+      assertUnit(s.slots[0].pOffer.load() == nullptr);
+      assertUnit(s.pTop.load() == nullptr);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      // teardown
+      delete pNew;
+   }
+
+   // a pop with nobody to meet comes back empty-handed
+   void test_eliminatePop_noPush()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      // exercise
+      auto * pTaken = s.eliminatePop(0);
+      // verify
+      assertUnit(pTaken == nullptr);
+      assertUnit(s.slots[0].pOffer.load() == nullptr);
+   }  // teardown
+
+   // a pop takes a node a push left in its slot
+   void test_eliminatePop_offer()
+   {  // setup
+      custom::concurrent_stack <Spy> s;
+      auto * pNew = new custom::concurrent_stack <Spy>::StackNode(Spy(99));
+      s.slots[3].pOffer.store(pNew);
+      Spy::reset();
+      // exercise
+      auto * pTaken = s.eliminatePop(3);
+      // verify
+      assertUnit(pTaken == pNew);
+      assertUnit(s.slots[3].pOffer.load() == nullptr);
+      assertUnit(s.pTop.load() == nullptr);      // the top was never touched
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      if (pTaken)
+         assertUnit(pTaken->data == Spy(99));
+      // teardown
+      delete pTaken;
+   }
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // many threads push and pop at once; every value comes out once
+   void test_threads_pushPop()
+   {  // setup
+      const int NUM_THREADS = 4;
+      const int NUM_EACH = 10000;
+      custom::concurrent_stack <int> s;
+      std::vector <std::thread> threads;
+      std::vector <long long> sums(NUM_THREADS, 0);
+      std::vector <int> counts(NUM_THREADS, 0);
+      // exercise
+      for (int i = 0; i < NUM_THREADS; i++)
+         threads.push_back(std::thread([&s, i, NUM_EACH]()
+         {
+            for (int j = 1; j <= NUM_EACH; j++)
+               s.push(j);
+         }));
+      for (int i = 0; i < NUM_THREADS; i++)
+         threads.push_back(std::thread([&s, &sums, &counts, i, NUM_EACH]()
+         {
+            int value;
+            while (counts[i] < NUM_EACH)
+               if (s.pop(value))
+               {
+                  sums[i] += value;
+                  counts[i]++;
+               }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      long long total = 0;
+      for (long long sum : sums)
+         total += sum;
+      assertUnit(total == (long long)NUM_THREADS * NUM_EACH * (NUM_EACH + 1) / 2);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // every thread both pushes and pops on a nearly empty stack,
+   // the case where pushes and pops collide the most
+   void test_threads_contended()
+   {  // setup
+      const int NUM_THREADS = 8;
+      const int NUM_EACH = 10000;
+      custom::concurrent_stack <int> s;
+      std::vector <std::thread> threads;
+      std::vector <long long> sums(NUM_THREADS, 0);
+      // exercise
+      for (int i = 0; i < NUM_THREADS; i++)
+         threads.push_back(std::thread([&s, &sums, i, NUM_EACH]()
+         {
+            int value;
+            for (int j = 1; j <= NUM_EACH; j++)
+            {
+               s.push(j);
+               while (!s.pop(value))
+                  ;
+               sums[i] += value;
+            }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      long long total = 0;
+      for (long long sum : sums)
+         total += sum;
+      assertUnit(total == (long long)NUM_THREADS * NUM_EACH * (NUM_EACH + 1) / 2);
+      assertUnit(s.empty());
+      for (size_t i = 0; i < custom::concurrent_stack <int>::NUM_SLOTS; i++)
+         assertUnit(s.slots[i].pOffer.load() == nullptr);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    [11][26][31] with 31 on top
+    *************************************************************/
+   void setupStandardFixture(custom::concurrent_stack <Spy>& s)
+   {
+      s.push(Spy(11));
+      s.push(Spy(26));
+      s.push(Spy(31));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,214 @@
+/***********************************************************************
+ * Header:
+ *    TEST EBR
+ * Summary:
+ *    Unit tests for epoch-based reclamation
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "ebr.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestEbr : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Pin
+      test_guard_nested();
+      test_advance_unpinned();
+      test_advance_pinned();
+
+      // Retire
+      test_retire_unpinned();
+      test_retire_pinned();
+      test_retire_batched();
+
+      // Threads
+      test_threads_readersWriter();
+
+      report("Ebr");
+   }
+
+   /***************************************
+    * PIN
+    ***************************************/
+
+   // only the outermost guard pins and unpins
+   void test_guard_nested()
+   {  // setup
+      custom::ebr::ThreadState& state = custom::ebr::threadState();
+      bool pinnedOuter = false;
+      bool pinnedInner = false;
+      bool pinnedAfterInner = false;
+      // exercise
+      {
+         custom::ebr::guard outer;
+         pinnedOuter = (state.pRecord->local.load() & 1) == 1;
+         {
+            custom::ebr::guard inner;
+            pinnedInner = custom::ebr::isPinned();
+         }
+         pinnedAfterInner = (state.pRecord->local.load() & 1) == 1;
+      }
+      // verify
+      assertUnit(pinnedOuter);
+      assertUnit(pinnedInner);
+      assertUnit(pinnedAfterInner);
+      assertUnit(!custom::ebr::isPinned());
+      assertUnit(state.pRecord->local.load() == 0);
+   }  // teardown
+
+   // with nobody pinned the epoch moves freely
+   void test_advance_unpinned()
+   {  // setup
+      uint64_t epochBefore = custom::ebr::Domain::instance().epoch();
+      // exercise
+      custom::ebr::collect();
+      custom::ebr::collect();
+      // verify
+      assertUnit(custom::ebr::Domain::instance().epoch() == epochBefore + 2);
+   }  // teardown
+
+   // a pinned thread holds the epoch at most one past its own
+   void test_advance_pinned()
+   {  // setup
+      uint64_t epochBefore;
+      uint64_t epochAfter;
+      // exercise
+      {
+         custom::ebr::guard pinned;
+         epochBefore = custom::ebr::Domain::instance().epoch();
+         for (int i = 0; i < 5; i++)
+            custom::ebr::collect();
+         epochAfter = custom::ebr::Domain::instance().epoch();
+      }
+      // verify
+      assertUnit(epochAfter == epochBefore + 1);
+   }  // teardown
+
+   /***************************************
+    * RETIRE
+    ***************************************/
+
+   // nobody is reading, so two collections free the node
+   void test_retire_unpinned()
+   {  // setup
+      Spy* pSpy = new Spy(26);
+      Spy::reset();
+      // exercise
+      custom::ebr::retire(pSpy);
+      int numAfterRetire = Spy::numDestructor();
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(numAfterRetire == 0);
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numDelete() == 1);
+   }  // teardown
+
+   // a node retired while a reader is pinned outlives the pin
+   void test_retire_pinned()
+   {  // setup
+      Spy* pSpy = new Spy(26);
+      int numWhilePinned;
+      Spy::reset();
+      // exercise
+      {
+         custom::ebr::guard reader;
+         custom::ebr::retire(pSpy);
+         for (int i = 0; i < 5; i++)
+            custom::ebr::collect();
+         numWhilePinned = Spy::numDestructor();
+      }
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(numWhilePinned == 0);
+      assertUnit(Spy::numDestructor() == 1);
+   }  // teardown
+
+   // retiring enough nodes frees the old ones without being asked
+   void test_retire_batched()
+   {  // setup
+      custom::ebr::synchronize();
+      Spy::reset();
+      // exercise
+      for (size_t i = 0; i < 4 * custom::ebr::COLLECT_THRESHOLD; i++)
+         custom::ebr::retire(new Spy((int)i));
+      int numBeforeSynchronize = Spy::numDestructor();
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(numBeforeSynchronize > 0);
+      assertUnit(Spy::numDestructor() == 4 * (int)custom::ebr::COLLECT_THRESHOLD);
+      assertUnit(custom::ebr::threadState().retired.empty());
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // readers walk a chain without locks while a writer unlinks
+   // and retires nodes out from under them
+   void test_threads_readersWriter()
+   {  // setup
+      struct Link
+      {
+         Link(int value) : value(value), pNext(nullptr) {}
+         ~Link() { value = -1; }
+         int value;
+         std::atomic <Link*> pNext;
+      };
+      const int NUM_LINKS = 1000;
+      const int NUM_READERS = 3;
+      std::atomic <Link*> pHead(nullptr);
+      for (int i = NUM_LINKS; i > 0; i--)
+      {
+         Link* pNew = new Link(i);
+         pNew->pNext.store(pHead.load());
+         pHead.store(pNew);
+      }
+      std::atomic <bool> done(false);
+      std::atomic <bool> sawFreed(false);
+      std::vector <std::thread> readers;
+      // exercise
+      for (int i = 0; i < NUM_READERS; i++)
+         readers.push_back(std::thread([&]()
+         {
+            while (!done.load())
+            {
+               custom::ebr::guard reader;
+               for (Link* p = pHead.load(); p != nullptr; p = p->pNext.load())
+                  if (p->value <= 0)
+                     sawFreed.store(true);
+            }
+         }));
+      for (int i = 0; i < NUM_LINKS; i++)
+      {
+         Link* pRemove = pHead.load();
+         pHead.store(pRemove->pNext.load());
+         custom::ebr::retire(pRemove);
+      }
+      done.store(true);
+      for (auto& reader : readers)
+         reader.join();
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(!sawFreed.load());
+      assertUnit(pHead.load() == nullptr);
+      assertUnit(custom::ebr::threadState().retired.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
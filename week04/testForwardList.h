@@ -0,0 +1,270 @@
+/***********************************************************************
+ * Header:
+ *    TEST FORWARD LIST
+ * Summary:
+ *    Unit tests for forward_list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "forwardList.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+
+class TestForwardList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_construct_copy();
+      test_construct_move();
+
+      // Assign
+      test_assign_copy();
+
+      // Insert
+      test_pushFront_empty();
+      test_insertAfter_middle();
+
+      // Remove
+      test_popFront_standard();
+      test_eraseAfter_middle();
+      test_clear_standard();
+
+      // Reorder
+      test_reverse_standard();
+
+      report("ForwardList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::forward_list <Spy> l;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // build from a list of values, keeping their order
+   void test_construct_initializerList()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::forward_list <Spy> l{ Spy(11), Spy(26), Spy(31) };
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [11][26][31] into nodes
+      assertStandardFixture(l);
+   }  // teardown
+
+   // copy the standard fixture
+   void test_construct_copy()
+   {  // setup
+      custom::forward_list <Spy> lSrc;
+      setupStandardFixture(lSrc);
+      Spy::reset();
+      // exercise
+      custom::forward_list <Spy> lDes(lSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [11][26][31]
+      assertUnit(lDes.pHead != lSrc.pHead);
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // steal the nodes of the standard fixture
+   void test_construct_move()
+   {  // setup
+      custom::forward_list <Spy> lSrc;
+      setupStandardFixture(lSrc);
+      ForwardNode <Spy> * pHead = lSrc.pHead;
+      Spy::reset();
+      // exercise
+      custom::forward_list <Spy> lDes(std::move(lSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(lDes.pHead == pHead);
+      assertEmptyFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign over a shorter list, reusing its node
+   void test_assign_copy()
+   {  // setup
+      custom::forward_list <Spy> lSrc;
+      setupStandardFixture(lSrc);
+      custom::forward_list <Spy> lDes;
+      lDes.push_front(Spy(99));
+      ForwardNode <Spy> * pFirst = lDes.pHead;
+      Spy::reset();
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(Spy::numAssign() == 1);    // [99] = [11]
+      assertUnit(Spy::numCopy() == 2);      // copy [26][31]
+      assertUnit(lDes.pHead == pFirst);
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto an empty list
+   void test_pushFront_empty()
+   {  // setup
+      custom::forward_list <Spy> l;
+      Spy::reset();
+      // exercise
+      l.push_front(Spy(99));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);  // move [99] into the node
+      assertUnit(l.size() == 1);
+      assertUnit(l.front() == Spy(99));
+   }  // teardown
+
+   // insert 20 after 11
+   void test_insertAfter_middle()
+   {  // setup
+      custom::forward_list <Spy> l;
+      setupStandardFixture(l);
+      // exercise
+      auto it = l.insert_after(l.begin(), Spy(20));
+      // verify
+      assertUnit(*it == Spy(20));
+      assertUnit(l.size() == 4);
+      int expected[] = { 11, 20, 26, 31 };
+      int i = 0;
+      for (auto itCheck = l.begin(); itCheck != l.end(); ++itCheck, i++)
+         assertUnit(i < 4 && *itCheck == Spy(expected[i]));
+      assertUnit(i == 4);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop 11 off the front
+   void test_popFront_standard()
+   {  // setup
+      custom::forward_list <Spy> l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      l.pop_front();
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [11]
+      assertUnit(l.size() == 2);
+      assertUnit(l.front() == Spy(26));
+   }  // teardown
+
+   // erase 26
+   void test_eraseAfter_middle()
+   {  // setup
+      custom::forward_list <Spy> l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      auto it = l.erase_after(l.begin());
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [26]
+      assertUnit(it != l.end() && *it == Spy(31));
+      assertUnit(l.size() == 2);
+   }  // teardown
+
+   // free everything
+   void test_clear_standard()
+   {  // setup
+      custom::forward_list <Spy> l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3); // destroy [11][26][31]
+      assertEmptyFixture(l);
+   }  // teardown
+
+   /***************************************
+    * REORDER
+    ***************************************/
+
+   // reverse twice to get back where we started
+   void test_reverse_standard()
+   {  // setup
+      custom::forward_list <Spy> l;
+      setupStandardFixture(l);
+      // exercise
+      l.reverse();
+      // verify
+      assertUnit(l.front() == Spy(31));
+      assertUnit(l.size() == 3);
+      l.reverse();
+      assertStandardFixture(l);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void setupStandardFixture(custom::forward_list <Spy>& l)
+   {
+      l.push_front(Spy(31));
+      l.push_front(Spy(26));
+      l.push_front(Spy(11));
+   }
+
+   /*************************************************************
+    * VERIFY EMPTY FIXTURE
+    *************************************************************/
+   void assertEmptyFixtureParameters(const custom::forward_list <Spy>& l, int line, const char* function)
+   {
+      assertIndirect(l.pHead == nullptr);
+      assertIndirect(l.numElements == 0);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::forward_list <Spy>& l, int line, const char* function)
+   {
+      assertIndirect(l.numElements == 3);
+      const ForwardNode <Spy> * p = l.pHead;
+      for (int value : { 11, 26, 31 })
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->data == Spy(value));
+         p = p->pNext;
+      }
+      assertIndirect(p == nullptr);
+   }
+};
+
+#endif // DEBUG
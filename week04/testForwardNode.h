@@ -0,0 +1,400 @@
+/***********************************************************************
+ * Header:
+ *    TEST FORWARD NODE
+ * Summary:
+ *    Unit tests for forward node
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "forwardNode.h"
+#include "node.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+
+class TestForwardNode : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_create_value();
+      test_size_smaller();
+      test_size_heapBytes();
+      test_copy_nullptr();
+      test_copy_standard();
+
+      // Assign
+      test_assign_standardToEmpty();
+      test_assign_smallToBig();
+      test_assign_bigToSmall();
+
+      // Insert
+      test_insertAfter_empty();
+      test_insertAfter_middle();
+      test_insertAfter_back();
+
+      // Remove
+      test_eraseAfter_middle();
+      test_eraseAfter_back();
+      test_clear_standard();
+
+      // Reorder
+      test_reverse_empty();
+      test_reverse_standard();
+
+      report("ForwardNode");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // create a node holding a value
+   void test_create_value()
+   {  // setup
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      ForwardNode <Spy> n(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(n.data == Spy(99));
+      assertUnit(n.pNext == nullptr);
+   }  // teardown
+
+   // one less pointer than Node
+   void test_size_smaller()
+   {  // verify
+      assertUnit(sizeof(ForwardNode <int>) + sizeof(int *) == sizeof(Node <int>));
+   }
+
+   // the heap is asked for no more than the nodes, alone or in a run
+   void test_size_heapBytes()
+   {  // setup
+      const size_t NUM = 100;
+      ForwardNode <int> * pHead = nullptr;
+      size_t numBefore = custom::node_block <ForwardNode <int> >::numBytes();
+      // exercise
+      for (size_t i = 0; i < NUM; i++)
+      {
+         ForwardNode <int> * pNew = new ForwardNode <int>((int)i);
+         pNew->pNext = pHead;
+         pHead = pNew;
+      }
+      size_t numAlone = custom::node_block <ForwardNode <int> >::numBytes() - numBefore;
+      ForwardNode <int> * pCopy = copy(pHead);
+      size_t numRun = custom::node_block <ForwardNode <int> >::numBytes() - numBefore - numAlone;
+      // verify
+      assertUnit(numAlone == NUM * sizeof(ForwardNode <int>));
+      assertUnit(numAlone < NUM * sizeof(Node <int>));
+      assertUnit(numRun <= NUM * sizeof(ForwardNode <int>) + 2 * sizeof(void *));
+      // teardown
+      clear(pHead);
+      clear(pCopy);
+   }
+
+   // copy an empty list
+   void test_copy_nullptr()
+   {  // setup
+      ForwardNode <Spy> * pSrc = nullptr;
+      Spy::reset();
+      // exercise
+      ForwardNode <Spy> * pDes = copy(pSrc);
+      // verify
+      assertUnit(pDes == nullptr);
+      assertUnit(Spy::numCopy() == 0);
+   }  // teardown
+
+   // copy the standard fixture into one block
+   //    +----+   +----+   +----+
+   //    | 11 | > | 26 | > | 31 |
+   //    +----+   +----+   +----+
+   void test_copy_standard()
+   {  // setup
+      ForwardNode <Spy> * pSrc = setupStandardFixture();
+      Spy::reset();
+      // exercise
+      ForwardNode <Spy> * pDes = copy(pSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [11][26][31]
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(pDes != pSrc);
+      assertStandardFixture(pSrc);
+      assertStandardFixture(pDes);
+      if (pDes && pDes->pNext)
+      {
+         assertUnit(pDes->pNext == custom::node_block <ForwardNode <Spy> >::next(pDes));
+         assertUnit(pDes->pNext->pNext == custom::node_block <ForwardNode <Spy> >::next(pDes->pNext));
+      }
+      // teardown
+      clear(pSrc);
+      clear(pDes);
+   }
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign the standard fixture to an empty list
+   void test_assign_standardToEmpty()
+   {  // setup
+      ForwardNode <Spy> * pSrc = setupStandardFixture();
+      ForwardNode <Spy> * pDes = nullptr;
+      Spy::reset();
+      // exercise
+      assign(pDes, pSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [11][26][31]
+      assertUnit(Spy::numAssign() == 0);
+      assertStandardFixture(pSrc);
+      assertStandardFixture(pDes);
+      // teardown
+      clear(pSrc);
+      clear(pDes);
+   }
+
+   // assign the standard fixture over a single node
+   //    +----+           +----+   +----+   +----+
+   //    | 99 |    -->    | 11 | > | 26 | > | 31 |
+   //    +----+           +----+   +----+   +----+
+   void test_assign_smallToBig()
+   {  // setup
+      ForwardNode <Spy> * pSrc = setupStandardFixture();
+      ForwardNode <Spy> * pDes = new ForwardNode <Spy>(Spy(99));
+      ForwardNode <Spy> * pFirst = pDes;
+      Spy::reset();
+      // exercise
+      assign(pDes, pSrc);
+      // verify
+      assertUnit(Spy::numAssign() == 1);    // [99] = [11]
+      assertUnit(Spy::numCopy() == 2);      // copy [26][31]
+      assertUnit(pDes == pFirst);
+      assertStandardFixture(pDes);
+      // teardown
+      clear(pSrc);
+      clear(pDes);
+   }
+
+   // assign a single node over the standard fixture
+   //    +----+   +----+   +----+           +----+
+   //    | 11 | > | 26 | > | 31 |    -->    | 99 |
+   //    +----+   +----+   +----+           +----+
+   void test_assign_bigToSmall()
+   {  // setup
+      ForwardNode <Spy> * pSrc = new ForwardNode <Spy>(Spy(99));
+      ForwardNode <Spy> * pDes = setupStandardFixture();
+      Spy::reset();
+      // exercise
+      assign(pDes, pSrc);
+      // verify
+      assertUnit(Spy::numAssign() == 1);     // [11] = [99]
+      assertUnit(Spy::numDestructor() == 2); // destroy [26][31]
+      assertUnit(pDes != nullptr);
+      if (pDes)
+      {
+         assertUnit(pDes->data == Spy(99));
+         assertUnit(pDes->pNext == nullptr);
+      }
+      // teardown
+      clear(pSrc);
+      clear(pDes);
+   }
+
+   /***************************************
+    * INSERT AFTER
+    ***************************************/
+
+   // with nothing to insert after, the node stands alone
+   void test_insertAfter_empty()
+   {  // setup
+      ForwardNode <Spy> * pHead = nullptr;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      pHead = insert_after(pHead, s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(pHead != nullptr);
+      if (pHead)
+      {
+         assertUnit(pHead->data == Spy(99));
+         assertUnit(pHead->pNext == nullptr);
+      }
+      // teardown
+      clear(pHead);
+   }
+
+   // insert 20 after 11
+   //    +----+   +----+   +----+   +----+
+   //    | 11 | > | 20 | > | 26 | > | 31 |
+   //    +----+   +----+   +----+   +----+
+   void test_insertAfter_middle()
+   {  // setup
+      ForwardNode <Spy> * pHead = setupStandardFixture();
+      ForwardNode <Spy> * p26 = pHead->pNext;
+      Spy::reset();
+      // exercise
+      ForwardNode <Spy> * pNew = insert_after(pHead, Spy(20));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);   // move [20] into the node
+      assertUnit(pHead->pNext == pNew);
+      assertUnit(pNew->data == Spy(20));
+      assertUnit(pNew->pNext == p26);
+      assertUnit(size(pHead) == 4);
+      // teardown
+      clear(pHead);
+   }
+
+   // insert 99 after 31
+   //    +----+   +----+   +----+   +----+
+   //    | 11 | > | 26 | > | 31 | > | 99 |
+   //    +----+   +----+   +----+   +----+
+   void test_insertAfter_back()
+   {  // setup
+      ForwardNode <Spy> * pHead = setupStandardFixture();
+      ForwardNode <Spy> * p31 = pHead->pNext->pNext;
+      // exercise
+      ForwardNode <Spy> * pNew = insert_after(p31, Spy(99));
+      // verify
+      assertUnit(p31->pNext == pNew);
+      assertUnit(pNew->pNext == nullptr);
+      assertUnit(size(pHead) == 4);
+      // teardown
+      clear(pHead);
+   }
+
+   /***************************************
+    * ERASE AFTER
+    ***************************************/
+
+   // erase 26
+   //    +----+   +----+
+   //    | 11 | > | 31 |
+   //    +----+   +----+
+   void test_eraseAfter_middle()
+   {  // setup
+      ForwardNode <Spy> * pHead = setupStandardFixture();
+      ForwardNode <Spy> * p31 = pHead->pNext->pNext;
+      Spy::reset();
+      // exercise
+      ForwardNode <Spy> * pReturn = erase_after(pHead);
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [26]
+      assertUnit(pReturn == p31);
+      assertUnit(pHead->pNext == p31);
+      assertUnit(size(pHead) == 2);
+      // teardown
+      clear(pHead);
+   }
+
+   // nothing after the last node
+   void test_eraseAfter_back()
+   {  // setup
+      ForwardNode <Spy> * pHead = setupStandardFixture();
+      Spy::reset();
+      // exercise
+      ForwardNode <Spy> * pReturn = erase_after(pHead->pNext->pNext);
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(pReturn == nullptr);
+      assertStandardFixture(pHead);
+      // teardown
+      clear(pHead);
+   }
+
+   // free the whole list
+   void test_clear_standard()
+   {  // setup
+      ForwardNode <Spy> * pHead = setupStandardFixture();
+      Spy::reset();
+      // exercise
+      clear(pHead);
+      // verify
+      assertUnit(Spy::numDestructor() == 3); // destroy [11][26][31]
+      assertUnit(pHead == nullptr);
+   }  // teardown
+
+   /***************************************
+    * REVERSE
+    ***************************************/
+
+   // an empty list stays empty
+   void test_reverse_empty()
+   {  // setup
+      ForwardNode <Spy> * pHead = nullptr;
+      // exercise
+      reverse(pHead);
+      // verify
+      assertUnit(pHead == nullptr);
+   }  // teardown
+
+   // turn the standard fixture around without touching the values
+   //    +----+   +----+   +----+
+   //    | 31 | > | 26 | > | 11 |
+   //    +----+   +----+   +----+
+   void test_reverse_standard()
+   {  // setup
+      ForwardNode <Spy> * pHead = setupStandardFixture();
+      ForwardNode <Spy> * p11 = pHead;
+      ForwardNode <Spy> * p26 = pHead->pNext;
+      ForwardNode <Spy> * p31 = pHead->pNext->pNext;
+      Spy::reset();
+      // exercise
+      reverse(pHead);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(pHead == p31);
+      assertUnit(p31->pNext == p26);
+      assertUnit(p26->pNext == p11);
+      assertUnit(p11->pNext == nullptr);
+      // teardown
+      clear(pHead);
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+   +----+   +----+
+    *    | 11 | > | 26 | > | 31 |
+    *    +----+   +----+   +----+
+    *************************************************************/
+   ForwardNode <Spy> * setupStandardFixture()
+   {
+      ForwardNode <Spy> * p31 = new ForwardNode <Spy>(Spy(31));
+      ForwardNode <Spy> * p26 = new ForwardNode <Spy>(Spy(26));
+      ForwardNode <Spy> * p11 = new ForwardNode <Spy>(Spy(11));
+      p11->pNext = p26;
+      p26->pNext = p31;
+      return p11;
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    +----+   +----+   +----+
+    *    | 11 | > | 26 | > | 31 |
+    *    +----+   +----+   +----+
+    *************************************************************/
+   void assertStandardFixtureParameters(const ForwardNode <Spy> * p, int line, const char* function)
+   {
+      for (int value : { 11, 26, 31 })
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->data == Spy(value));
+         p = p->pNext;
+      }
+      assertIndirect(p == nullptr);
+   }
+};
+
+#endif // DEBUG
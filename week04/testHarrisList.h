@@ -0,0 +1,378 @@
+/***********************************************************************
+ * Header:
+ *    TEST HARRIS LIST
+ * Summary:
+ *    Unit tests for lock_free_ordered_list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "harrisList.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestHarrisList : public UnitTest
+{
+   typedef custom::lock_free_ordered_list <Spy> SpyList;
+   typedef custom::lock_free_ordered_list <int> IntList;
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_marked();
+
+      // Insert
+      test_insert_standard();
+      test_insert_duplicate();
+      test_insert_unlinksMarked();
+
+      // Access
+      test_contains_standard();
+      test_contains_marked();
+
+      // Remove
+      test_remove_middle();
+      test_remove_missing();
+
+      // Threads
+      test_threads_mixed();
+      test_threads_sameKeys();
+
+      report("HarrisList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      SpyList l;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(l.head.load() == 0);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // a marked node that nobody got around to unlinking is still freed
+   void test_destructor_marked()
+   {  // setup
+      {
+         SpyList l;
+         setupStandardFixture(l);
+         markNode(l, 26);
+         Spy::reset();
+      // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // inserting out of order still leaves the list sorted
+   //     +----+   +----+   +----+
+   //     | 11 | - | 26 | - | 31 |
+   //     +----+   +----+   +----+
+   void test_insert_standard()
+   {  // setup
+      SpyList l;
+      Spy::reset();
+      // exercise
+      setupStandardFixture(l);
+      // verify
+      assertUnit(Spy::numCopy() == 3);         // copy [11][26][31] into nodes
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a value already in the list is not added again
+   void test_insert_duplicate()
+   {  // setup
+      SpyList l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      bool added = l.insert(Spy(26));
+      // verify
+      assertUnit(!added);
+      assertUnit(Spy::numCopyMove() == 1);         // into the node we then throw away
+      assertUnit(Spy::numDestructor() == 2);   // the argument and that node
+      assertStandardFixture(l);
+   }  // teardown
+
+   // walking past a logically deleted node unlinks it
+   //     +----+   +----+   +----+           +----+   +----+
+   //     | 11 | - |*26*| - | 31 |    -->    | 11 | - | 31 |
+   //     +----+   +----+   +----+           +----+   +----+
+   void test_insert_unlinksMarked()
+   {  // setup
+      SpyList l;
+      setupStandardFixture(l);
+      markNode(l, 26);
+      // exercise
+      bool added = l.insert(Spy(99));
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(added);
+      assertUnit(l.size() == 3);
+      SpyList::ListNode * p = SpyList::address(l.head.load());
+      assertUnit(p != nullptr);
+      if (p)
+      {
+         assertUnit(p->data == Spy(11));
+         p = SpyList::address(p->pNext.load());
+         assertUnit(p != nullptr && p->data == Spy(31));
+      }
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // look for values in and out of the list
+   void test_contains_standard()
+   {  // setup
+      SpyList l;
+      setupStandardFixture(l);
+      // exercise
+      bool has11 = l.contains(Spy(11));
+      bool has31 = l.contains(Spy(31));
+      bool has20 = l.contains(Spy(20));
+      bool has99 = l.contains(Spy(99));
+      // verify
+      assertUnit(has11 && has31);
+      assertUnit(!has20 && !has99);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a marked node is already gone even though it is still linked
+   void test_contains_marked()
+   {  // setup
+      SpyList l;
+      setupStandardFixture(l);
+      markNode(l, 26);
+      // exercise
+      bool has26 = l.contains(Spy(26));
+      // verify
+      assertUnit(!has26);
+      assertUnit(isMarkedNode(l, 26));          // contains() does not unlink
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // remove the middle value; the node is freed through EBR
+   void test_remove_middle()
+   {  // setup
+      SpyList l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      bool removed = l.remove(Spy(26));
+      custom::ebr::synchronize();
+      // verify
+      assertUnit(removed);
+      assertUnit(Spy::numDestructor() == 2);   // the argument and the node
+      assertUnit(l.size() == 2);
+      assertUnit(!l.contains(Spy(26)));
+      assertUnit(l.contains(Spy(11)) && l.contains(Spy(31)));
+   }  // teardown
+
+   // removing something that is not there changes nothing
+   void test_remove_missing()
+   {  // setup
+      SpyList l;
+      setupStandardFixture(l);
+      // exercise
+      bool removed20 = l.remove(Spy(20));
+      bool removed99 = l.remove(Spy(99));
+      // verify
+      assertUnit(!removed20 && !removed99);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // each thread owns its own keys so it knows what should be there
+   void test_threads_mixed()
+   {  // setup
+      const int NUM_THREADS = 4;
+      const int NUM_KEYS = 256;
+      const int NUM_OPERATIONS = 4000;
+      IntList l;
+      std::vector <std::thread> threads;
+      std::vector <char> isValid(NUM_THREADS, 1);
+      std::vector <std::vector <char>> isPresent(NUM_THREADS, std::vector <char>(NUM_KEYS, 0));
+      // exercise
+      for (int id = 0; id < NUM_THREADS; id++)
+         threads.push_back(std::thread([&, id]()
+         {
+            unsigned int seed = 31 + id;
+            for (int i = 0; i < NUM_OPERATIONS; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               int key = (int)((seed >> 8) % NUM_KEYS) / NUM_THREADS * NUM_THREADS + id;
+               int slot = key / NUM_THREADS;
+               int choice = (seed >> 20) % 100;
+               if (choice < 80)
+                  l.contains((key + 1) % NUM_KEYS);            // someone else's key
+               else if (choice < 90)
+               {
+                  if (l.insert(key) == (bool)isPresent[id][slot])
+                     isValid[id] = 0;
+                  isPresent[id][slot] = 1;
+               }
+               else
+               {
+                  if (l.remove(key) != (bool)isPresent[id][slot])
+                     isValid[id] = 0;
+                  isPresent[id][slot] = 0;
+               }
+            }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      custom::ebr::synchronize();
+      // verify
+      size_t numPresent = 0;
+      for (int id = 0; id < NUM_THREADS; id++)
+      {
+         assertUnit(isValid[id]);
+         for (int slot = 0; slot < NUM_KEYS / NUM_THREADS; slot++)
+         {
+            assertUnit(l.contains(slot * NUM_THREADS + id) == (bool)isPresent[id][slot]);
+            numPresent += isPresent[id][slot];
+         }
+      }
+      assertUnit(numPresent == l.size());
+      assertUnit(isSorted(l));
+   }  // teardown
+
+   // every thread fights over the same few keys; each successful
+   // insert is matched by at most one successful remove
+   void test_threads_sameKeys()
+   {  // setup
+      const int NUM_THREADS = 4;
+      const int NUM_KEYS = 8;
+      IntList l;
+      std::vector <std::thread> threads;
+      std::vector <long> net(NUM_THREADS, 0);
+      // exercise
+      for (int id = 0; id < NUM_THREADS; id++)
+         threads.push_back(std::thread([&, id]()
+         {
+            for (int i = 0; i < 2000; i++)
+            {
+               int key = (i * 7 + id) % NUM_KEYS;
+               if (l.insert(key))
+                  net[id]++;
+               if (l.remove((key + 3) % NUM_KEYS))
+                  net[id]--;
+            }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      custom::ebr::synchronize();
+      // verify
+      long total = 0;
+      for (long n : net)
+         total += n;
+      assertUnit(total == (long)l.size());
+      assertUnit(isSorted(l));
+   }  // teardown
+
+   /*************************************************************
+    * MARK NODE
+    * Logically delete the node holding value without
+    * unlinking it, as if its remover were interrupted
+    *************************************************************/
+   void markNode(SpyList& l, int value)
+   {
+      for (auto p = SpyList::address(l.head.load()); p; p = SpyList::address(p->pNext.load()))
+         if (p->data == Spy(value))
+         {
+            p->pNext.fetch_or(SpyList::MARK);
+            l.numElements--;
+         }
+   }
+
+   bool isMarkedNode(SpyList& l, int value)
+   {
+      for (auto p = SpyList::address(l.head.load()); p; p = SpyList::address(p->pNext.load()))
+         if (p->data == Spy(value))
+            return SpyList::isMarked(p->pNext.load());
+      return false;
+   }
+
+   /*************************************************************
+    * IS SORTED
+    * Strictly increasing with no marked nodes left behind
+    *************************************************************/
+   bool isSorted(IntList& l)
+   {
+      size_t num = 0;
+      for (auto p = IntList::address(l.head.load()); p; p = IntList::address(p->pNext.load()), num++)
+      {
+         auto pNext = IntList::address(p->pNext.load());
+         if (IntList::isMarked(p->pNext.load()) || (pNext && !(p->data < pNext->data)))
+            return false;
+      }
+      return num == l.size();
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void setupStandardFixture(SpyList& l)
+   {
+      Spy s26(26);
+      Spy s31(31);
+      Spy s11(11);
+      l.insert(s26);
+      l.insert(s31);
+      l.insert(s11);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void assertStandardFixtureParameters(SpyList& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      auto p = SpyList::address(l.head.load());
+      for (int value : { 11, 26, 31 })
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->data == Spy(value));
+         assertIndirect(!SpyList::isMarked(p->pNext.load()));
+         p = SpyList::address(p->pNext.load());
+      }
+      assertIndirect(p == nullptr);
+   }
+};
+
+#endif // DEBUG
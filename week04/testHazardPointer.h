@@ -0,0 +1,134 @@
+/***********************************************************************
+ * Header:
+ *    TEST HAZARD POINTER
+ * Summary:
+ *    Unit tests for hazard_pointer and retire
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "hazardPointer.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+
+class TestHazardPointer : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_slots();
+
+      // Protect
+      test_protect_standard();
+
+      // Retire
+      test_retire_unprotected();
+      test_retire_protected();
+
+      report("HazardPointer");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // each live hazard pointer takes a different slot
+   void test_construct_slots()
+   {  // setup
+      custom::hazard::ThreadState& state = custom::hazard::threadState();
+      unsigned int slotsBefore = state.slotsUsed;
+      int slot0 = -1;
+      int slot1 = -1;
+      // exercise
+      {
+         custom::hazard_pointer hp0;
+         custom::hazard_pointer hp1;
+         slot0 = hp0.slot;
+         slot1 = hp1.slot;
+      }
+      // verify
+      assertUnit(slot0 != slot1);
+      assertUnit(slot0 >= 0 && slot0 < custom::hazard::MAX_HAZARDS);
+      assertUnit(slot1 >= 0 && slot1 < custom::hazard::MAX_HAZARDS);
+      assertUnit(state.slotsUsed == slotsBefore);
+   }  // teardown
+
+   /***************************************
+    * PROTECT
+    ***************************************/
+
+   // protect publishes the pointer until reset
+   void test_protect_standard()
+   {  // setup
+      int value = 26;
+      std::atomic <int*> pShared(&value);
+      custom::hazard_pointer hp;
+      // exercise
+      int* p = hp.protect(pShared);
+      // verify
+      assertUnit(p == &value);
+      assertUnit(hp.pSlot->load() == &value);
+      assertUnit(isHazard(&value));
+      hp.reset();
+      assertUnit(!isHazard(&value));
+   }  // teardown
+
+   /***************************************
+    * RETIRE
+    ***************************************/
+
+   // nothing protects the node, so reclaim frees it
+   void test_retire_unprotected()
+   {  // setup
+      Spy* pSpy = new Spy(26);
+      Spy::reset();
+      // exercise
+      custom::retire(pSpy);
+      custom::reclaim();
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numDelete() == 1);
+   }  // teardown
+
+   // a protected node survives reclaim until the hazard is cleared
+   void test_retire_protected()
+   {  // setup
+      Spy* pSpy = new Spy(26);
+      std::atomic <Spy*> pShared(pSpy);
+      custom::hazard_pointer hp;
+      hp.protect(pShared);
+      pShared.store(nullptr);
+      Spy::reset();
+      // exercise
+      custom::retire(pSpy);
+      custom::reclaim();
+      int numBefore = Spy::numDestructor();
+      hp.reset();
+      custom::reclaim();
+      // verify
+      assertUnit(numBefore == 0);
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numDelete() == 1);
+   }  // teardown
+
+   /*************************************************************
+    * IS HAZARD
+    * Is p published by any thread?
+    *************************************************************/
+   bool isHazard(void* p)
+   {
+      std::vector <void*> hazards = custom::hazard::Domain::instance().hazards();
+      return std::binary_search(hazards.begin(), hazards.end(), p);
+   }
+};
+
+#endif // DEBUG
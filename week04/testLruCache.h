@@ -0,0 +1,347 @@
+/***********************************************************************
+ * Header:
+ *    TEST LRU CACHE
+ * Summary:
+ *    Unit tests for lru_cache and sharded_lru_cache
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "lruCache.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestLruCache : public UnitTest
+{
+   typedef custom::lru_cache <int, Spy> SpyCache;
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_capacity();
+
+      // Access
+      test_get_missing();
+      test_get_hit();
+      test_get_refreshes();
+
+      // Insert
+      test_put_update();
+      test_put_evictOldest();
+      test_put_reusesEntry();
+      test_put_collisions();
+
+      // Remove
+      test_erase_middle();
+      test_clear_standard();
+
+      // Sharded
+      test_sharded_capacity();
+      test_sharded_threads();
+
+      report("LruCache");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // an empty cache with enough buckets for its capacity
+   void test_construct_capacity()
+   {  // setup
+      Spy::reset();
+      // exercise
+      SpyCache c(5);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(c.capacity() == 5);
+      assertUnit(c.buckets.size() == 8);
+      assertEmptyFixture(c);
+   }  // teardown
+
+   /***************************************
+    * GET
+    ***************************************/
+
+   // a miss leaves the value alone and counts
+   void test_get_missing()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      bool found = c.get(42, s);
+      // verify
+      assertUnit(!found);
+      assertUnit(s == Spy(99));
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(c.misses() == 1);
+      assertUnit(c.hits() == 0);
+      assertStandardFixture(c);
+   }  // teardown
+
+   // a hit on the most recent entry copies the value out
+   void test_get_hit()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      Spy s;
+      Spy::reset();
+      // exercise
+      bool found = c.get(31, s);
+      // verify
+      assertUnit(found);
+      assertUnit(s == Spy(310));
+      assertUnit(Spy::numAssign() == 1);     // copy [310] out
+      assertUnit(c.hits() == 1);
+      assertUnit(c.hitRate() == 1.0);
+      assertStandardFixture(c);
+   }  // teardown
+
+   // a hit on the oldest entry moves it to the front
+   //    [31] - [26] - [11]    -->    [11] - [31] - [26]
+   void test_get_refreshes()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      Spy s;
+      // exercise
+      bool found = c.get(11, s);
+      // verify
+      assertUnit(found);
+      assertUnit(recency(c) == std::vector <int>({ 11, 31, 26 }));
+      assertUnit(c.pTail->data.first == 26);
+   }  // teardown
+
+   /***************************************
+    * PUT
+    ***************************************/
+
+   // put an existing key: new value, moved to the front
+   void test_put_update()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      Spy::reset();
+      // exercise
+      c.put(26, Spy(99));
+      // verify
+      assertUnit(Spy::numAssign() == 1);     // [260] = [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(c.size() == 3);
+      assertUnit(recency(c) == std::vector <int>({ 26, 31, 11 }));
+      assertUnit(c.pHead->data.second == Spy(99));
+   }  // teardown
+
+   // a new key in a full cache pushes out the oldest
+   //    [31] - [26] - [11]    -->    [42] - [31] - [26]
+   void test_put_evictOldest()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      // exercise
+      c.put(42, Spy(420));
+      // verify
+      assertUnit(c.size() == 3);
+      assertUnit(!c.contains(11));
+      assertUnit(c.contains(42));
+      assertUnit(recency(c) == std::vector <int>({ 42, 31, 26 }));
+   }  // teardown
+
+   // the evicted entry becomes the new one: no allocation
+   void test_put_reusesEntry()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      SpyCache::Entry * pOldest = c.pTail;
+      size_t numAllocations = custom::node_block <SpyCache::Entry>::numAllocations();
+      Spy::reset();
+      // exercise
+      c.put(42, Spy(420));
+      // verify
+      assertUnit(c.pHead == pOldest);
+      assertUnit(custom::node_block <SpyCache::Entry>::numAllocations() == numAllocations);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 1);     // [110] = [420]
+      assertUnit(Spy::numDestructor() == 1); // the argument only
+   }  // teardown
+
+   // keys that all land in the same bucket are kept apart
+   void test_put_collisions()
+   {  // setup
+      struct Collide { size_t operator()(int) const { return 7; } };
+      custom::lru_cache <int, Spy, Collide> c(4);
+      // exercise
+      c.put(1, Spy(10));
+      c.put(5, Spy(50));
+      c.put(9, Spy(90));
+      c.erase(5);
+      // verify
+      Spy s;
+      assertUnit(c.get(1, s) && s == Spy(10));
+      assertUnit(!c.get(5, s));
+      assertUnit(c.get(9, s) && s == Spy(90));
+      assertUnit(c.size() == 2);
+      assertUnit(c.buckets[7 & 3] != nullptr && c.buckets[7 & 3]->pBucketNext != nullptr);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase the middle entry, freeing it
+   //    [31] - [26] - [11]    -->    [31] - [11]
+   void test_erase_middle()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      Spy::reset();
+      // exercise
+      bool erased26 = c.erase(26);
+      bool erased99 = c.erase(99);
+      // verify
+      assertUnit(erased26 && !erased99);
+      assertUnit(Spy::numDestructor() == 1); // destroy [260]
+      assertUnit(c.size() == 2);
+      assertUnit(recency(c) == std::vector <int>({ 31, 11 }));
+      assertUnit(!c.contains(26));
+   }  // teardown
+
+   // clear frees everything but keeps the statistics
+   void test_clear_standard()
+   {  // setup
+      SpyCache c(3);
+      setupStandardFixture(c);
+      Spy s;
+      c.get(11, s);
+      Spy::reset();
+      // exercise
+      c.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3); // destroy [110][260][310]
+      assertUnit(c.hits() == 1);
+      assertEmptyFixture(c);
+   }  // teardown
+
+   /***************************************
+    * SHARDED
+    ***************************************/
+
+   // the capacity is split over the shards with nothing lost
+   void test_sharded_capacity()
+   {  // setup
+      custom::sharded_lru_cache <int, int> c(10, 4);
+      // exercise
+      for (int i = 0; i < 100; i++)
+         c.put(i, i * 10);
+      // verify
+      assertUnit(c.shards.size() == 4);
+      assertUnit(c.capacity() == 10);
+      assertUnit(c.size() <= 10);
+      int value = 0;
+      assertUnit(c.get(99, value) && value == 990);   // just put, never evicted
+   }  // teardown
+
+   // many threads sharing a cache; every hit sees the right value
+   void test_sharded_threads()
+   {  // setup
+      const int NUM_THREADS = 4;
+      const int NUM_KEYS = 512;
+      custom::sharded_lru_cache <int, int> c(256, 8);
+      std::vector <std::thread> threads;
+      std::vector <char> isValid(NUM_THREADS, 1);
+      // exercise
+      for (int id = 0; id < NUM_THREADS; id++)
+         threads.push_back(std::thread([&, id]()
+         {
+            unsigned int seed = 11 + id;
+            for (int i = 0; i < 5000; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               int key = (int)((seed >> 8) % NUM_KEYS);
+               int value;
+               if (c.get(key, value))
+               {
+                  if (value != key * 3)
+                     isValid[id] = 0;
+               }
+               else
+                  c.put(key, key * 3);
+            }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      for (int id = 0; id < NUM_THREADS; id++)
+         assertUnit(isValid[id]);
+      assertUnit(c.size() <= 256);
+      assertUnit(c.hits() + c.misses() == NUM_THREADS * 5000);
+      assertUnit(c.hitRate() > 0.0);
+   }  // teardown
+
+   /*************************************************************
+    * RECENCY
+    * The keys from most to least recently used
+    *************************************************************/
+   std::vector <int> recency(const SpyCache& c)
+   {
+      std::vector <int> keys;
+      for (SpyCache::Entry * p = c.pHead; p; p = p->next())
+         keys.push_back(p->data.first);
+      return keys;
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    [31] - [26] - [11]
+    *    most recent     least recent
+    *************************************************************/
+   void setupStandardFixture(SpyCache& c)
+   {
+      c.put(11, Spy(110));
+      c.put(26, Spy(260));
+      c.put(31, Spy(310));
+   }
+
+   /*************************************************************
+    * VERIFY EMPTY FIXTURE
+    *************************************************************/
+   void assertEmptyFixtureParameters(const SpyCache& c, int line, const char* function)
+   {
+      assertIndirect(c.pHead == nullptr);
+      assertIndirect(c.pTail == nullptr);
+      assertIndirect(c.numElements == 0);
+      bool isEmpty = true;
+      for (auto pBucket : c.buckets)
+         isEmpty = isEmpty && pBucket == nullptr;
+      assertIndirect(isEmpty);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    [31] - [26] - [11]
+    *************************************************************/
+   void assertStandardFixtureParameters(const SpyCache& c, int line, const char* function)
+   {
+      assertIndirect(c.numElements == 3);
+      assertIndirect(recency(c) == std::vector <int>({ 31, 26, 11 }));
+      assertIndirect(c.pHead != nullptr && c.pHead->data.second == Spy(310));
+      assertIndirect(c.pTail != nullptr && c.pTail->data.second == Spy(110));
+      assertIndirect(c.pHead == nullptr || c.pHead->pPrev == nullptr);
+      assertIndirect(c.pTail == nullptr || c.pTail->pNext == nullptr);
+   }
+};
+
+#endif // DEBUG
@@ -12,8 +12,23 @@
 #endif
 //#undef DEBUG  // Remove this comment to disable unit tests
 
-#include "testSpy.h"        // for the spy unit tests
-#include "testNode.h"       // for the unit tests
+#include "testSpy.h"                   // for the spy unit tests
+#include "testNode.h"                  // for the unit tests
+#include "testForwardNode.h"           // for the forward node unit tests
+#include "testForwardList.h"           // for the forward list unit tests
+#include "testNodeVector.h"            // for the list to vector unit tests
+#include "testViews.h"                 // for the lazy view unit tests
+#include "testLruCache.h"              // for the LRU cache unit tests
+#include "testPersistentList.h"        // for the memory-mapped list unit tests
+#include "testSkipList.h"              // for the skip list unit tests
+#include "testHazardPointer.h"         // for the hazard pointer unit tests
+#include "testConcurrentStack.h"       // for the lock-free stack unit tests
+#include "testConcurrentQueue.h"       // for the lock-free queue unit tests
+#include "testConcurrentOrderedList.h" // for the fine-grained locking list unit tests
+#include "testHarrisList.h"            // for the lock-free ordered list unit tests
+#include "testWsDeque.h"               // for the work-stealing deque unit tests
+#include "testTaskPool.h"              // for the task pool unit tests
+#include "testEbr.h"                   // for the epoch-based reclamation unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -26,6 +41,21 @@ int main()
    // unit tests
    TestSpy().run();
    TestNode().run();
+   TestForwardNode().run();
+   TestForwardList().run();
+   TestNodeVector().run();
+   TestViews().run();
+   TestSkipList().run();
+   TestLruCache().run();
+   TestPersistentList().run();
+   TestHazardPointer().run();
+   TestConcurrentStack().run();
+   TestConcurrentQueue().run();
+   TestEbr().run();
+   TestConcurrentOrderedList().run();
+   TestHarrisList().run();
+   TestWsDeque().run();
+   TestTaskPool().run();
 #endif // DEBUG
   
    return 0;
@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <memory>
+#include <vector>
 
 class TestNode : public UnitTest
 {
@@ -30,6 +31,9 @@ public:
       test_copy_nullptr();
       test_copy_one();
       test_copy_standard();
+      test_copy_oneAllocation();
+      test_copy_heapBytes();
+      test_copy_removeFromBlock();
       
       // Assign
       test_assign_emptyToEmpty();
@@ -37,6 +41,7 @@ public:
       test_assign_emptyToStandard();
       test_assign_smallToBig();
       test_assign_bigToSmall();
+      test_assign_oneAllocation();
       test_swap_emptyEmpty();
       test_swap_emptyStandard();
       test_swap_standardEmpty();
@@ -60,11 +65,43 @@ public:
       test_clear_nullptr();
       test_clear_one();
       test_clear_standard();
+      test_clearBatched_nullptr();
+      test_clearBatched_partial();
+      test_clearBatched_all();
+      test_clearAsync_nullptr();
+      test_clearAsync_standard();
 
       // Status
       test_size_empty();
       test_size_standard();
       test_size_standardMiddle();
+
+      // Traverse
+      test_forEach_empty();
+      test_forEach_standard();
+      test_forEach_long();
+      test_find_empty();
+      test_find_standard();
+      test_find_missing();
+      test_find_long();
+      test_accumulate_empty();
+      test_accumulate_long();
+
+      // Compact
+      test_fragmentation_empty();
+      test_fragmentation_reverse();
+      test_compact_nullptr();
+      test_compact_reverse();
+      test_compactIfFragmented_contiguous();
+
+      // Sort
+      test_merge_emptyStandard();
+      test_merge_interleaved();
+      test_sort_empty();
+      test_sort_standard();
+      test_sort_reverse();
+      test_sort_compare();
+      test_sort_many();
       
       report("Node");
    }
@@ -447,6 +484,118 @@ public:
       teardownStandardFixture(p67);
    }
 
+   // the copy of the standard fixture is one contiguous allocation
+   void test_copy_oneAllocation()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pDes = nullptr;
+      size_t numBefore = custom::node_block <Node <Spy>>::numAllocations();
+      Spy::reset();
+      // exercise
+      pDes = copy(p11);
+      // verify
+      assertUnit(custom::node_block <Node <Spy>>::numAllocations() == numBefore + 1);
+      assertUnit(Spy::numCopy() == 3);        // copy [11][26][31]
+      assertUnit(Spy::numAlloc() == 3);
+      assertUnit(pDes != nullptr);
+      if (pDes && pDes->pNext)
+      {
+         assertUnit(pDes->pNext == slot(pDes, 1));
+         assertUnit(pDes->pNext->pNext == slot(pDes, 2));
+      }
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      teardownStandardFixture(pDes);
+   }
+
+   // no node pays for more than its own size, alone or in a run
+   void test_copy_heapBytes()
+   {  // setup
+      const size_t NUM = 100;
+      Node <int>* pHead = nullptr;
+      size_t numBefore = custom::node_block <Node <int>>::numBytes();
+      for (size_t i = 0; i < NUM; i++)
+      {
+         Node <int>* pNew = new Node <int>((int)i);
+         pNew->pNext = pHead;
+         if (pHead)
+            pHead->pPrev = pNew;
+         pHead = pNew;
+      }
+      size_t numAlone = custom::node_block <Node <int>>::numBytes() - numBefore;
+      // exercise
+      Node <int>* pCopy = copy(pHead);
+      size_t numRun = custom::node_block <Node <int>>::numBytes() - numBefore - numAlone;
+      // verify
+      assertUnit(numAlone == NUM * sizeof(Node <int>));
+      assertUnit(numRun <= NUM * sizeof(Node <int>) + 2 * sizeof(void *));
+      // teardown
+      clear(pHead);
+      clear(pCopy);
+   }
+
+   // a node from a copied block can be removed on its own
+   void test_copy_removeFromBlock()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pDes = copy(p11);
+      Spy::reset();
+      // exercise
+      Node <Spy>* pReturn = remove(pDes->pNext);
+      // verify
+      assertUnit(Spy::numDestructor() == 1);  // destroy [26]
+      assertUnit(Spy::numDelete() == 1);
+      assertUnit(pReturn == pDes);
+      assertUnit(pDes->pNext == slot(pDes, 2));
+      assertUnit(pDes->pNext->pPrev == pDes);
+      assertUnit(pDes->pNext->data == Spy(31));
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pDes);
+   }
+
+   // the nodes assign adds to the end come from one allocation
+   void test_assign_oneAllocation()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      //     p67
+      //    +----+
+      //    | 67 |
+      //    +----+
+      Node <Spy>* p67 = new Node <Spy>(Spy(67));
+      size_t numBefore = custom::node_block <Node <Spy>>::numAllocations();
+      Spy::reset();
+      // exercise
+      assign(p67, p11);
+      // verify
+      assertUnit(custom::node_block <Node <Spy>>::numAllocations() == numBefore + 1);
+      assertUnit(Spy::numAssign() == 1);      // assign [11] onto [67]
+      assertUnit(Spy::numCopy() == 2);        // copy-create [26][31]
+      assertUnit(Spy::numDelete() == 0);
+      if (p67 && p67->pNext)
+         assertUnit(p67->pNext->pNext == slot(p67->pNext, 1));
+      assertStandardFixture(p67);
+      // teardown
+      teardownStandardFixture(p11);
+      teardownStandardFixture(p67);
+   }
+
    /***************************************
     * SWAP
     ***************************************/
@@ -1372,6 +1521,575 @@ public:
    }  // teardown
 
 
+   // free part of an empty list
+   void test_clearBatched_nullptr()
+   {  // setup
+      Node <Spy>* pList = nullptr;
+      Spy::reset();
+      // exercise
+      size_t num = clear_batched(pList, 2);
+      // verify
+      assertUnit(num == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(pList == nullptr);
+   }  // teardown
+
+   // free the first two nodes of the standard fixture
+   void test_clearBatched_partial()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pHead = p11;
+      Spy::reset();
+      // exercise
+      size_t num = clear_batched(pHead, 2);
+      // verify
+      assertUnit(num == 2);
+      assertUnit(Spy::numDestructor() == 2);   // destroy [11][26]
+      assertUnit(Spy::numDelete() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      //     p31
+      //    +----+
+      //    | 31 |
+      //    +----+
+      assertUnit(pHead == p31);
+      assertUnit(p31->pPrev == nullptr);
+      assertUnit(p31->pNext == nullptr);
+      assertUnit(p31->data == Spy(31));
+      // teardown
+      delete p31;
+   }
+
+   // a budget bigger than the list frees everything
+   void test_clearBatched_all()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pHead = p11;
+      Spy::reset();
+      // exercise
+      size_t num = clear_batched(pHead, 10);
+      // verify
+      assertUnit(num == 3);
+      assertUnit(Spy::numDestructor() == 3);   // destroy [11][26][31]
+      assertUnit(Spy::numDelete() == 3);
+      assertUnit(pHead == nullptr);
+   }  // teardown
+
+   // hand an empty list to the reclaimer
+   void test_clearAsync_nullptr()
+   {  // setup
+      Node <Spy>* pList = nullptr;
+      Spy::reset();
+      // exercise
+      clear_async(pList);
+      custom::reclaimer::instance().flush();
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(pList == nullptr);
+   }  // teardown
+
+   // hand the standard fixture to the reclaimer
+   void test_clearAsync_standard()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pHead = p11;
+      Spy::reset();
+      // exercise
+      clear_async(pHead);
+      bool detached = (pHead == nullptr);
+      custom::reclaimer::instance().flush();
+      // verify
+      assertUnit(detached);
+      assertUnit(Spy::numDestructor() == 3);   // destroy [11][26][31]
+      assertUnit(Spy::numDelete() == 3);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+   }  // teardown
+
+   /***************************************
+    * TRAVERSE
+    ***************************************/
+
+   // visit nothing in an empty list
+   void test_forEach_empty()
+   {  // setup
+      Node <Spy>* pHead = nullptr;
+      int count = 0;
+      // exercise
+      for_each(pHead, [&count](Spy&) { count++; });
+      // verify
+      assertUnit(count == 0);
+   }  // teardown
+
+   // visit each node of the standard fixture in order, by reference
+   void test_forEach_standard()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      std::vector <int> values;
+      Spy::reset();
+      // exercise
+      for_each(p11, [&values](Spy& s) { values.push_back(s.get()); });
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(values.size() == 3);
+      if (values.size() == 3)
+      {
+         assertUnit(values[0] == 11);
+         assertUnit(values[1] == 26);
+         assertUnit(values[2] == 31);
+      }
+      assertStandardFixture(p11);
+      // teardown
+      teardownStandardFixture(p11);
+   }
+
+   // a list much longer than the lookahead; change every value
+   void test_forEach_long()
+   {  // setup
+      Node <int>* pHead = setupCountingFixture(100);
+      // exercise
+      for_each(pHead, [](int& value) { value *= 2; });
+      // verify
+      bool inOrder = true;
+      int expected = 0;
+      for (Node <int>* p = pHead; p; p = p->pNext, expected += 2)
+         inOrder = inOrder && p->data == expected;
+      assertUnit(inOrder);
+      assertUnit(expected == 200);
+      // teardown
+      clear(pHead);
+   }
+
+   // look in an empty list
+   void test_find_empty()
+   {  // setup
+      const Node <Spy>* pHead = nullptr;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      const Node <Spy>* pFound = find(pHead, s26);
+      // verify
+      assertUnit(pFound == nullptr);
+      assertUnit(Spy::numEquals() == 0);
+   }  // teardown
+
+   // find the middle of the standard fixture
+   void test_find_standard()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      Node <Spy>* pFound = find(p11, s26);
+      // verify
+      assertUnit(pFound == p26);
+      assertUnit(Spy::numEquals() == 2);       // compare [11][26]
+      assertUnit(Spy::numCopy() == 0);
+      assertStandardFixture(p11);
+      // teardown
+      teardownStandardFixture(p11);
+   }
+
+   // look for a value that is not there
+   void test_find_missing()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Spy s99(99);
+      Spy::reset();
+      // exercise
+      Node <Spy>* pFound = find(p11, s99);
+      // verify
+      assertUnit(pFound == nullptr);
+      assertUnit(Spy::numEquals() == 3);       // compare [11][26][31]
+      assertStandardFixture(p11);
+      // teardown
+      teardownStandardFixture(p11);
+   }
+
+   // find values all along a long list
+   void test_find_long()
+   {  // setup
+      Node <int>* pHead = setupCountingFixture(100);
+      // exercise
+      Node <int>* pFirst = find(pHead, 0);
+      Node <int>* pMiddle = find(pHead, 57);
+      Node <int>* pLast = find(pHead, 99);
+      Node <int>* pMissing = find(pHead, 100);
+      // verify
+      assertUnit(pFirst == pHead);
+      assertUnit(pMiddle != nullptr && pMiddle->data == 57);
+      assertUnit(pLast != nullptr && pLast->data == 99 && pLast->pNext == nullptr);
+      assertUnit(pMissing == nullptr);
+      // teardown
+      clear(pHead);
+   }
+
+   // the total of an empty list is the starting value
+   void test_accumulate_empty()
+   {  // setup
+      const Node <int>* pHead = nullptr;
+      // exercise
+      int total = accumulate(pHead, 26);
+      // verify
+      assertUnit(total == 26);
+   }  // teardown
+
+   // add up and multiply along a long list
+   void test_accumulate_long()
+   {  // setup
+      Node <int>* pHead = setupCountingFixture(100);
+      const Node <int>* pConst = pHead;
+      // exercise
+      long long total = accumulate(pConst, 0LL);
+      int count = accumulate(pConst, 0, [](int count, int) { return count + 1; });
+      // verify
+      assertUnit(total == 4950);
+      assertUnit(count == 100);
+      // teardown
+      clear(pHead);
+   }
+
+   /***************************************
+    * COMPACT
+    ***************************************/
+
+   // an empty list is not fragmented
+   void test_fragmentation_empty()
+   {  // setup
+      Node <Spy>* pHead = nullptr;
+      // exercise
+      double fragmented = fragmentation(pHead);
+      // verify
+      assertUnit(fragmented == 0.0);
+   }  // teardown
+
+   // every link of a list laid out backwards jumps
+   void test_fragmentation_reverse()
+   {  // setup
+      //     p31      p26      p11
+      //    +----+   +----+   +----+
+      //    | 31 | - | 26 | - | 11 |
+      //    +----+   +----+   +----+
+      Node <Spy>* pHead = setupReverseFixture();
+      Spy::reset();
+      // exercise
+      double fragmented = fragmentation(pHead);
+      // verify
+      assertUnit(fragmented == 1.0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numEquals() == 0);
+      // teardown
+      clear(pHead);
+   }
+
+   // compact an empty list
+   void test_compact_nullptr()
+   {  // setup
+      Node <Spy>* pHead = nullptr;
+      Spy::reset();
+      // exercise
+      compact(pHead);
+      // verify
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(pHead == nullptr);
+   }  // teardown
+
+   // compact a list laid out backwards, moving the values
+   void test_compact_reverse()
+   {  // setup
+      //     p31      p26      p11
+      //    +----+   +----+   +----+
+      //    | 31 | - | 26 | - | 11 |
+      //    +----+   +----+   +----+
+      Node <Spy>* pHead = setupReverseFixture();
+      Node <Spy>* pOld = pHead;
+      Spy::reset();
+      // exercise
+      compact(pHead);
+      // verify
+      assertUnit(Spy::numCopyMove() == 3);     // move [31][26][11]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);       // the moved-from values are empty
+      assertUnit(Spy::numDestructor() == 3);   // destroy the old nodes
+      assertUnit(pHead != pOld);
+      assertUnit(fragmentation(pHead) == 0.0);
+      assertUnit(pHead != nullptr);
+      if (pHead && pHead->pNext && pHead->pNext->pNext)
+      {
+         assertUnit(pHead->data == Spy(31));
+         assertUnit(pHead->pPrev == nullptr);
+         assertUnit(pHead->pNext == slot(pHead, 1));
+         assertUnit(pHead->pNext->data == Spy(26));
+         assertUnit(pHead->pNext->pPrev == pHead);
+         assertUnit(pHead->pNext->pNext == slot(pHead, 2));
+         assertUnit(pHead->pNext->pNext->data == Spy(11));
+         assertUnit(pHead->pNext->pNext->pPrev == slot(pHead, 1));
+         assertUnit(pHead->pNext->pNext->pNext == nullptr);
+      }
+      // teardown
+      clear(pHead);
+   }
+
+   // a list that is already contiguous is left alone
+   void test_compactIfFragmented_contiguous()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pHead = copy(p11);
+      Node <Spy>* pBefore = pHead;
+      Node <Spy>* pReverse = setupReverseFixture();
+      Spy::reset();
+      // exercise
+      bool compactedContiguous = compact_if_fragmented(pHead);
+      bool compactedReverse = compact_if_fragmented(pReverse);
+      // verify
+      assertUnit(!compactedContiguous);
+      assertUnit(compactedReverse);
+      assertUnit(pHead == pBefore);
+      assertUnit(Spy::numCopyMove() == 3);     // only the reversed list moved
+      assertStandardFixture(pHead);
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pHead);
+      clear(pReverse);
+   }
+
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // merge an empty list with the standard fixture
+   void test_merge_emptyStandard()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pEmpty = nullptr;
+      Node <Spy>* pHead = nullptr;
+      Spy::reset();
+      // exercise
+      pHead = merge(pEmpty, p11);
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(pHead == p11);
+      assertStandardFixture(pHead);
+      // teardown
+      teardownStandardFixture(pHead);
+   }
+
+   // merge [11][31] with [26] to get [11][26][31]
+   void test_merge_interleaved()
+   {  // setup
+      //     p11      p31          p26
+      //    +----+   +----+       +----+
+      //    | 11 | - | 31 |       | 26 |
+      //    +----+   +----+       +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      p11->pNext = p31;
+      p31->pPrev = p11;
+      p26->pNext = p26->pPrev = nullptr;
+      Node <Spy>* pHead = nullptr;
+      Spy::reset();
+      // exercise
+      pHead = merge(p11, p26);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertUnit(pHead == p11);
+      assertUnit(p11->pNext == p26);
+      assertUnit(p26->pNext == p31);
+      assertStandardFixture(pHead);
+      // teardown
+      teardownStandardFixture(pHead);
+   }
+
+   // sort an empty list
+   void test_sort_empty()
+   {  // setup
+      Node <Spy>* pHead = nullptr;
+      Spy::reset();
+      // exercise
+      sort(pHead);
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(pHead == nullptr);
+   }  // teardown
+
+   // sort a list that is already sorted
+   void test_sort_standard()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pHead = p11;
+      Spy::reset();
+      // exercise
+      sort(pHead);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(pHead == p11);
+      assertStandardFixture(pHead);
+      // teardown
+      teardownStandardFixture(pHead);
+   }
+
+   // sort [31][26][11] by relinking the nodes
+   void test_sort_reverse()
+   {  // setup
+      //     p31      p26      p11
+      //    +----+   +----+   +----+
+      //    | 31 | - | 26 | - | 11 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      p31->pNext = p26;
+      p26->pNext = p11;
+      p11->pNext = nullptr;
+      p31->pPrev = nullptr;
+      p26->pPrev = p31;
+      p11->pPrev = p26;
+      Node <Spy>* pHead = p31;
+      Spy::reset();
+      // exercise
+      sort(pHead);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertUnit(pHead == p11);
+      assertUnit(p11->pNext == p26);
+      assertUnit(p26->pNext == p31);
+      assertStandardFixture(pHead);
+      // teardown
+      teardownStandardFixture(pHead);
+   }
+
+   // sort the standard fixture in descending order
+   void test_sort_compare()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <int>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <int>* pHead = p11;
+      // exercise
+      sort(pHead, [](int lhs, int rhs) { return lhs > rhs; });
+      // verify
+      //     p31      p26      p11
+      //    +----+   +----+   +----+
+      //    | 31 | - | 26 | - | 11 |
+      //    +----+   +----+   +----+
+      assertUnit(pHead == p31);
+      assertUnit(p31->pPrev == nullptr);
+      assertUnit(p31->pNext == p26);
+      assertUnit(p26->pPrev == p31);
+      assertUnit(p26->pNext == p11);
+      assertUnit(p11->pPrev == p26);
+      assertUnit(p11->pNext == nullptr);
+      // teardown
+      clear(pHead);
+   }
+
+   // sort a list long enough to need several passes and an odd tail
+   void test_sort_many()
+   {  // setup
+      Node <int>* pHead = nullptr;
+      for (int i = 0; i < 1000; i++)
+         pHead = insert(pHead, (i * 7919) % 1009);
+      // exercise
+      sort(pHead);
+      // verify
+      assertUnit(size(pHead) == 1000);
+      bool isSorted = true;
+      bool isLinked = (pHead != nullptr && pHead->pPrev == nullptr);
+      for (const Node <int>* p = pHead; p != nullptr && p->pNext != nullptr; p = p->pNext)
+      {
+         isSorted = isSorted && !(p->pNext->data < p->data);
+         isLinked = isLinked && p->pNext->pPrev == p;
+      }
+      assertUnit(isSorted);
+      assertUnit(isLinked);
+      // teardown
+      clear(pHead);
+   }
+
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *    +----+   +----+   +----+
@@ -1416,6 +2134,46 @@ public:
       p31->pPrev = p26;
    }
 
+   /*************************************************************
+    * SETUP COUNTING FIXTURE
+    *    +----+   +----+         +-----+
+    *    |  0 | - |  1 | - ... - | n-1 |
+    *    +----+   +----+         +-----+
+    *************************************************************/
+   Node <int>* setupCountingFixture(int num)
+   {
+      Node <int>* pHead = nullptr;
+      for (int i = num - 1; i >= 0; i--)
+         pHead = insert(pHead, i);
+      return pHead;
+   }
+
+   /*************************************************************
+    * SETUP REVERSE FIXTURE
+    * The same values as the standard fixture in one block,
+    * but linked so each node comes before its neighbor
+    *    +----+   +----+   +----+
+    *    | 31 | - | 26 | - | 11 |
+    *    +----+   +----+   +----+
+    *************************************************************/
+   Node <Spy>* setupReverseFixture()
+   {
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pBlock = copy(p11);
+      teardownStandardFixture(p11);
+      p11 = pBlock;
+      p26 = slot(pBlock, 1);
+      p31 = slot(pBlock, 2);
+      p31->pNext = p26;
+      p26->pNext = p11;
+      p11->pNext = nullptr;
+      p31->pPrev = nullptr;
+      p26->pPrev = p31;
+      p11->pPrev = p26;
+      return p31;
+   }
+
    /*************************************************************
     * VERIFY EMPTY FIXTURE
     *************************************************************/
@@ -1542,6 +2300,16 @@ public:
       }
    }
 
+   /*************************************************************
+    * SLOT
+    * The node i slots after p in the run it was allocated in
+    *************************************************************/
+   static Node <Spy>* slot(Node <Spy>* p, size_t i)
+   {
+      for (; i > 0; i--)
+         p = custom::node_block <Node <Spy>>::next(p);
+      return p;
+   }
 };
 
 #endif // DEBUG
@@ -0,0 +1,227 @@
+/***********************************************************************
+ * Header:
+ *    TEST NODE VECTOR
+ * Summary:
+ *    Unit tests for moving between a Node list and a vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "nodeVector.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+
+class TestNodeVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // To vector
+      test_toVector_empty();
+      test_toVector_standard();
+      test_moveToVector_standard();
+
+      // From vector
+      test_fromVector_empty();
+      test_fromVector_standard();
+      test_fromVector_roundTrip();
+
+      report("NodeVector");
+   }
+
+   /***************************************
+    * TO VECTOR
+    ***************************************/
+
+   // an empty list gives an empty vector
+   void test_toVector_empty()
+   {  // setup
+      const Node <Spy> * pHead = nullptr;
+      Spy::reset();
+      // exercise
+      custom::vector <Spy> v = to_vector(pHead);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 0);
+   }  // teardown
+
+   // copy a list into a vector sized to fit
+   void test_toVector_standard()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy> * pHead = setupStandardFixture();
+      Spy::reset();
+      // exercise
+      custom::vector <Spy> v = to_vector((const Node <Spy> *)pHead);
+      // verify
+      assertUnit(Spy::numCopy() == 3);       // copy [11][26][31] once each
+      assertUnit(Spy::numCopyMove() == 0);   // never grew, so never moved
+      assertUnit(Spy::numDestructor() == 0);
+      //      0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      assertUnit(v.size() == 3);
+      assertUnit(v.capacity() == 3);
+      assertUnit(v[0] == Spy(11));
+      assertUnit(v[1] == Spy(26));
+      assertUnit(v[2] == Spy(31));
+      assertStandardFixture(pHead);
+      // teardown
+      clear(pHead);
+   }
+
+   // move a list into a vector and free the list
+   void test_moveToVector_standard()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy> * pHead = setupStandardFixture();
+      Spy::reset();
+      // exercise
+      custom::vector <Spy> v = move_to_vector(pHead);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 3);   // move [11][26][31] once each
+      assertUnit(Spy::numAlloc() == 0);      // the values kept their buffers
+      assertUnit(Spy::numDestructor() == 3); // the moved-from shells in the list
+      assertUnit(pHead == nullptr);
+      //      0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      assertUnit(v.size() == 3);
+      assertUnit(v.capacity() == 3);
+      assertUnit(v[0] == Spy(11));
+      assertUnit(v[1] == Spy(26));
+      assertUnit(v[2] == Spy(31));
+   }  // teardown
+
+   /***************************************
+    * FROM VECTOR
+    ***************************************/
+
+   // an empty vector gives an empty list
+   void test_fromVector_empty()
+   {  // setup
+      custom::vector <Spy> v;
+      Spy::reset();
+      // exercise
+      Node <Spy> * pHead = from_vector(std::move(v));
+      // verify
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pHead == nullptr);
+   }  // teardown
+
+   // move a vector into one block of nodes
+   void test_fromVector_standard()
+   {  // setup
+      //      0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      custom::vector <Spy> v { Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      Node <Spy> * pHead = from_vector(std::move(v));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 3);   // move [11][26][31] once each
+      assertUnit(Spy::numAlloc() == 0);      // the values kept their buffers
+      assertUnit(Spy::numDestructor() == 3); // the moved-from shells in the vector
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(pHead);
+      if (pHead && pHead->pNext)
+      {
+         assertUnit(pHead->pNext == custom::node_block <Node <Spy> >::next(pHead));
+         assertUnit(pHead->pNext->pNext == custom::node_block <Node <Spy> >::next(pHead->pNext));
+      }
+      assertUnit(fragmentation(pHead) == 0.0);
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 3);        // the vector keeps its buffer
+      // teardown
+      clear(pHead);
+   }
+
+   // a list survives the trip to a vector and back
+   void test_fromVector_roundTrip()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy> * pHead = setupStandardFixture();
+      // exercise
+      custom::vector <Spy> v = move_to_vector(pHead);
+      pHead = from_vector(std::move(v));
+      // verify
+      assertStandardFixture(pHead);
+      assertUnit(v.empty());
+      // teardown
+      clear(pHead);
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+   +----+   +----+
+    *    | 11 | - | 26 | - | 31 |
+    *    +----+   +----+   +----+
+    *************************************************************/
+   Node <Spy> * setupStandardFixture()
+   {
+      Node <Spy> * p11 = new Node <Spy>(Spy(11));
+      Node <Spy> * p26 = new Node <Spy>(Spy(26));
+      Node <Spy> * p31 = new Node <Spy>(Spy(31));
+      p11->pNext = p26;
+      p26->pNext = p31;
+      p26->pPrev = p11;
+      p31->pPrev = p26;
+      return p11;
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    +----+   +----+   +----+
+    *    | 11 | - | 26 | - | 31 |
+    *    +----+   +----+   +----+
+    *************************************************************/
+   void assertStandardFixtureParameters(const Node <Spy> * p, int line, const char * function)
+   {
+      assertIndirect(p != nullptr);
+      if (p)
+      {
+         assertIndirect(p->data == Spy(11));
+         assertIndirect(p->pPrev == nullptr);
+         assertIndirect(p->pNext != nullptr);
+         if (p->pNext)
+         {
+            assertIndirect(p->pNext->data == Spy(26));
+            assertIndirect(p->pNext->pPrev == p);
+            assertIndirect(p->pNext->pNext != nullptr);
+            if (p->pNext->pNext)
+            {
+               assertIndirect(p->pNext->pNext->data == Spy(31));
+               assertIndirect(p->pNext->pNext->pPrev == p->pNext);
+               assertIndirect(p->pNext->pNext->pNext == nullptr);
+            }
+         }
+      }
+   }
+};
+
+#endif // DEBUG
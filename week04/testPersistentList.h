@@ -0,0 +1,331 @@
+/***********************************************************************
+ * Header:
+ *    TEST PERSISTENT LIST
+ * Summary:
+ *    Unit tests for persistent_list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "persistentList.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+class TestPersistentList : public UnitTest
+{
+   typedef custom::persistent_list <int> IntList;
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_new();
+      test_construct_reopen();
+      test_construct_wrongType();
+
+      // Insert
+      test_pushBack_standard();
+      test_pushFront_standard();
+      test_pushBack_full();
+
+      // Remove
+      test_popFront_reuseSlot();
+      test_popBack_standard();
+
+      // Recover
+      test_recover_staleTail();
+      test_recover_leakedSlot();
+
+      report("PersistentList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new file is an empty list
+   void test_construct_new()
+   {  // setup
+      std::remove(PATH);
+      {
+         // exercise
+         IntList l(PATH, 10);
+         // verify
+         assertUnit(l.empty());
+         assertUnit(l.capacity() == 10);
+         assertUnit(!l.recovered());
+         assertUnit(l.pHeader->offHead == 0);
+         assertUnit(l.pHeader->offUnused == IntList::firstSlot());
+         assertUnit(l.pHeader->clean == 0);   // open until we close it
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   // close the standard fixture and open it again: nothing to rebuild
+   void test_construct_reopen()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 10);
+         setupStandardFixture(l);
+      }
+      {
+         // exercise
+         IntList l(PATH, 99);
+         // verify
+         assertUnit(!l.recovered());
+         assertUnit(l.capacity() == 10);      // the file keeps its own
+         assertStandardFixture(l);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   // a file holding a different type is refused
+   void test_construct_wrongType()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 10);
+      }
+      bool isThrown = false;
+      // exercise
+      try
+      {
+         custom::persistent_list <double> l(PATH, 10);
+      }
+      catch (const std::runtime_error &)
+      {
+         isThrown = true;
+      }
+      // verify
+      assertUnit(isThrown);
+      // teardown
+      std::remove(PATH);
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto the back, linking both ways by offset
+   void test_pushBack_standard()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 10);
+         // exercise
+         setupStandardFixture(l);
+         // verify
+         assertStandardFixture(l);
+         assertUnit(l.front() == 11);
+         assertUnit(l.back() == 31);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   // push onto the front
+   void test_pushFront_standard()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 10);
+         // exercise
+         l.push_front(31);
+         l.push_front(26);
+         l.push_front(11);
+         // verify
+         assertStandardFixture(l);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   // there is no room past the capacity
+   void test_pushBack_full()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 3);
+         setupStandardFixture(l);
+         bool isThrown = false;
+         // exercise
+         try
+         {
+            l.push_back(99);
+         }
+         catch (const std::bad_alloc &)
+         {
+            isThrown = true;
+         }
+         // verify
+         assertUnit(isThrown);
+         assertStandardFixture(l);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop 11 and its slot is the next one used
+   void test_popFront_reuseSlot()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 3);
+         setupStandardFixture(l);
+         uint64_t off11 = l.pHeader->offHead;
+         // exercise
+         l.pop_front();
+         l.push_back(99);
+         // verify
+         assertUnit(values(l) == std::vector <int>({ 26, 31, 99 }));
+         assertUnit(l.pHeader->offTail == off11);
+         assertUnit(l.pHeader->offFree == 0);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   // pop 31 off the back, then everything else
+   void test_popBack_standard()
+   {  // setup
+      std::remove(PATH);
+      {
+         IntList l(PATH, 10);
+         setupStandardFixture(l);
+         // exercise
+         l.pop_back();
+         // verify
+         assertUnit(values(l) == std::vector <int>({ 11, 26 }));
+         assertUnit(l.back() == 26);
+         l.clear();
+         assertUnit(l.empty());
+         assertUnit(l.pHeader->offHead == 0 && l.pHeader->offTail == 0);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   /***************************************
+    * RECOVER
+    ***************************************/
+
+   // died after linking 31 but before updating the tail and count
+   void test_recover_staleTail()
+   {  // setup
+      std::remove(PATH);
+      IntList::Header header;
+      {
+         IntList l(PATH, 10);
+         setupStandardFixture(l);
+         header = *l.pHeader;
+      }
+      header.offTail = header.offHead;
+      header.numElements = 2;
+      header.clean = 0;
+      writeHeader(header);
+      {
+         // exercise
+         IntList l(PATH, 10);
+         // verify
+         assertUnit(l.recovered());
+         assertStandardFixture(l);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   // died after allocating a slot but before linking it
+   void test_recover_leakedSlot()
+   {  // setup
+      std::remove(PATH);
+      IntList::Header header;
+      {
+         IntList l(PATH, 10);
+         setupStandardFixture(l);
+         header = *l.pHeader;
+      }
+      uint64_t offLeaked = header.offUnused;
+      header.offUnused += sizeof(IntList::ListNode);
+      header.clean = 0;
+      writeHeader(header);
+      {
+         // exercise
+         IntList l(PATH, 10);
+         // verify
+         assertUnit(l.recovered());
+         assertUnit(l.pHeader->offFree == offLeaked);
+         assertStandardFixture(l);
+      }
+      // teardown
+      std::remove(PATH);
+   }
+
+   static constexpr const char * PATH = "testPersistentList.dat";
+
+   /*************************************************************
+    * VALUES
+    * What the list holds, front to back
+    *************************************************************/
+   std::vector <int> values(IntList& l)
+   {
+      std::vector <int> v;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /*************************************************************
+    * WRITE HEADER
+    * Overwrite the header of a closed file, as if the
+    * program had died with it in that state
+    *************************************************************/
+   void writeHeader(const IntList::Header& header)
+   {
+      std::fstream file(PATH, std::ios::in | std::ios::out | std::ios::binary);
+      file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void setupStandardFixture(IntList& l)
+   {
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    {11, 26, 31}, linked both ways
+    *************************************************************/
+   void assertStandardFixtureParameters(IntList& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      assertIndirect(values(l) == std::vector <int>({ 11, 26, 31 }));
+
+      std::vector <int> backward;
+      for (uint64_t off = l.pHeader->offTail; off != 0; off = l.node(off)->offPrev)
+         backward.push_back(l.node(off)->data);
+      assertIndirect(backward == std::vector <int>({ 31, 26, 11 }));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,369 @@
+/***********************************************************************
+ * Header:
+ *    TEST SKIP LIST
+ * Summary:
+ *    Unit tests for skip_list
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "skipList.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+
+class TestSkipList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sortedChain();
+      test_construct_sortedChainDuplicates();
+      test_constructCopy_standard();
+
+      // Insert
+      test_insert_empty();
+      test_insert_duplicate();
+      test_insert_many();
+
+      // Access
+      test_find_standard();
+      test_lowerBound_standard();
+
+      // Remove
+      test_erase_missing();
+      test_erase_standard();
+      test_erase_all();
+
+      report("SkipList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::skip_list <Spy> s;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertEmptyFixture(s);
+   }  // teardown
+
+   // build from the sorted chain [11][26][31]
+   void test_construct_sortedChain()
+   {  // setup
+      Node <Spy>* pSrc = buildChain({ 11, 26, 31 });
+      Spy::reset();
+      // exercise
+      custom::skip_list <Spy> s(pSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [11][26][31]
+      assertUnit(Spy::numAlloc() == 3);
+      assertStandardFixture(s);
+      // teardown
+      clear(pSrc);
+   }
+
+   // build from a sorted chain with duplicates, which are dropped
+   void test_construct_sortedChainDuplicates()
+   {  // setup
+      Node <Spy>* pSrc = buildChain({ 11, 11, 26, 31, 31 });
+      // exercise
+      custom::skip_list <Spy> s(pSrc);
+      // verify
+      assertStandardFixture(s);
+      // teardown
+      clear(pSrc);
+   }
+
+   // copy the standard fixture
+   void test_constructCopy_standard()
+   {  // setup
+      custom::skip_list <Spy> sSrc;
+      setupStandardFixture(sSrc);
+      Spy::reset();
+      // exercise
+      custom::skip_list <Spy> sDes(sSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);      // copy [11][26][31]
+      assertUnit(Spy::numAlloc() == 3);
+      assertStandardFixture(sSrc);
+      assertStandardFixture(sDes);
+      assertUnit(sSrc.chain() != sDes.chain());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert into an empty skip list
+   void test_insert_empty()
+   {  // setup
+      custom::skip_list <Spy> s;
+      Spy::reset();
+      // exercise
+      auto result = s.insert(Spy(26));
+      // verify
+      assertUnit(Spy::numCopy() == 1);      // copy [26] into the node
+      assertUnit(result.second == true);
+      assertUnit(result.first != s.end());
+      assertUnit(s.size() == 1);
+      assertUnit(s.pHeads[0] != nullptr);
+      if (s.pHeads[0])
+      {
+         assertUnit(s.pHeads[0]->data == Spy(26));
+         assertUnit(s.pHeads[0]->pNext == nullptr);
+         assertUnit(s.pHeads[0]->pPrev == nullptr);
+      }
+      assertUnit(s.pTail == s.pHeads[0]);
+   }  // teardown
+
+   // insert a value that is already there
+   void test_insert_duplicate()
+   {  // setup
+      custom::skip_list <Spy> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      auto result = s.insert(Spy(26));
+      // verify
+      assertUnit(Spy::numCopy() == 0);      // nothing new was created
+      assertUnit(result.second == false);
+      assertUnit(result.first != s.end());
+      if (result.first != s.end())
+         assertUnit(*result.first == Spy(26));
+      assertStandardFixture(s);
+   }  // teardown
+
+   // insert enough values in scrambled order to build several levels
+   void test_insert_many()
+   {  // setup
+      custom::skip_list <int> s;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert((i * 7919) % 1009);
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(s.numLevels > 1);
+      assertUnit(size(s.chain()) == 1000);
+      assertUnit(isValid(s));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // find values in and out of the standard fixture
+   void test_find_standard()
+   {  // setup
+      custom::skip_list <Spy> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      auto it26 = s.find(Spy(26));
+      auto it99 = s.find(Spy(99));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 2);     // Spy(26) and Spy(99)
+      assertUnit(it26 != s.end());
+      if (it26 != s.end())
+         assertUnit(*it26 == Spy(26));
+      assertUnit(it99 == s.end());
+      assertStandardFixture(s);
+   }  // teardown
+
+   // iterate the range [20, 31)
+   void test_lowerBound_standard()
+   {  // setup
+      custom::skip_list <int> s;
+      s.insert(31);
+      s.insert(11);
+      s.insert(26);
+      // exercise
+      int total = 0;
+      int count = 0;
+      for (auto it = s.lower_bound(20); it != s.lower_bound(31); ++it)
+      {
+         total += *it;
+         count++;
+      }
+      // verify
+      assertUnit(count == 1);
+      assertUnit(total == 26);
+      assertUnit(s.lower_bound(99) == s.end());
+      assertUnit(*s.lower_bound(0) == 11);
+      assertUnit(*s.upper_bound(26) == 31);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase a value that is not there
+   void test_erase_missing()
+   {  // setup
+      custom::skip_list <Spy> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      size_t num = s.erase(Spy(99));
+      // verify
+      assertUnit(num == 0);
+      assertUnit(Spy::numDestructor() == 1); // only the Spy(99) argument
+      assertStandardFixture(s);
+   }  // teardown
+
+   // erase the middle of [11][26][31]
+   void test_erase_standard()
+   {  // setup
+      custom::skip_list <Spy> s;
+      setupStandardFixture(s);
+      Spy::reset();
+      // exercise
+      size_t num = s.erase(Spy(26));
+      // verify
+      assertUnit(num == 1);
+      assertUnit(Spy::numDestructor() == 2); // [26] and the argument
+      assertUnit(s.size() == 2);
+      assertUnit(s.pHeads[0] != nullptr);
+      if (s.pHeads[0] && s.pHeads[0]->pNext)
+      {
+         assertUnit(s.pHeads[0]->data == Spy(11));
+         assertUnit(s.pHeads[0]->pNext->data == Spy(31));
+         assertUnit(s.pHeads[0]->pNext->pPrev == s.pHeads[0]);
+         assertUnit(s.pTail == s.pHeads[0]->pNext);
+      }
+      assertUnit(isValid(s));
+   }  // teardown
+
+   // erase everything, one at a time
+   void test_erase_all()
+   {  // setup
+      custom::skip_list <int> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      for (int i = 99; i >= 0; i -= 2)
+         s.erase(i);
+      bool isHalfValid = isValid(s) && s.size() == 50;
+      for (int i = 0; i < 100; i += 2)
+         s.erase(i);
+      // verify
+      assertUnit(isHalfValid);
+      assertUnit(s.empty());
+      assertUnit(s.pTail == nullptr);
+      assertUnit(s.numLevels == 1);
+      for (int level = 0; level < s.MAX_LEVEL; level++)
+         assertUnit(s.pHeads[level] == nullptr);
+   }  // teardown
+
+   /*************************************************************
+    * BUILD CHAIN
+    * Create a Node chain with the values in order
+    *************************************************************/
+   Node <Spy>* buildChain(std::initializer_list<int> values)
+   {
+      Node <Spy>* pHead = nullptr;
+      Node <Spy>* pTail = nullptr;
+      for (int value : values)
+         pTail = insert(pTail, Spy(value), true);
+      for (pHead = pTail; pHead && pHead->pPrev; pHead = pHead->pPrev)
+         ;
+      return pHead;
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void setupStandardFixture(custom::skip_list <Spy>& s)
+   {
+      s.insert(Spy(26));
+      s.insert(Spy(11));
+      s.insert(Spy(31));
+   }
+
+   /*************************************************************
+    * IS VALID
+    * Every level is sorted, every level is a subset of
+    * the level below, and level 0 is doubly linked.
+    *************************************************************/
+   template <class T>
+   bool isValid(const custom::skip_list <T>& s)
+   {
+      typedef typename custom::skip_list <T>::SkipNode SkipNode;
+      const Node <T>* pPrev = nullptr;
+      size_t num = 0;
+      for (const Node <T>* p = s.pHeads[0]; p; p = p->pNext, num++)
+      {
+         if (p->pPrev != pPrev || (pPrev && !(pPrev->data < p->data)))
+            return false;
+         pPrev = p;
+      }
+      if (pPrev != s.pTail || num != s.size())
+         return false;
+
+      for (int level = 1; level < s.numLevels; level++)
+      {
+         SkipNode* pBelow = s.pHeads[level - 1];
+         for (SkipNode* p = s.pHeads[level]; p; p = p->next(level))
+         {
+            while (pBelow && pBelow != p)
+               pBelow = pBelow->next(level - 1);
+            if (pBelow == nullptr || p->height <= level)
+               return false;
+         }
+      }
+      return true;
+   }
+
+   /*************************************************************
+    * VERIFY EMPTY FIXTURE
+    *************************************************************/
+   void assertEmptyFixtureParameters(const custom::skip_list <Spy>& s, int line, const char* function)
+   {
+      assertIndirect(s.numElements == 0);
+      assertIndirect(s.numLevels == 1);
+      assertIndirect(s.pTail == nullptr);
+      assertIndirect(s.pHeads[0] == nullptr);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    {11, 26, 31}
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::skip_list <Spy>& s, int line, const char* function)
+   {
+      assertIndirect(s.numElements == 3);
+      const Node <Spy>* p = s.chain();
+      assertIndirect(p != nullptr);
+      if (p && p->pNext && p->pNext->pNext)
+      {
+         assertIndirect(p->data == Spy(11));
+         assertIndirect(p->pPrev == nullptr);
+         assertIndirect(p->pNext->data == Spy(26));
+         assertIndirect(p->pNext->pPrev == p);
+         assertIndirect(p->pNext->pNext->data == Spy(31));
+         assertIndirect(p->pNext->pNext->pPrev == p->pNext);
+         assertIndirect(p->pNext->pNext->pNext == nullptr);
+         assertIndirect(s.pTail == p->pNext->pNext);
+      }
+   }
+};
+
+#endif // DEBUG
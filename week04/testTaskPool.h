@@ -0,0 +1,267 @@
+/***********************************************************************
+ * Header:
+ *    TEST TASK POOL
+ * Summary:
+ *    Unit tests for task_pool
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "taskPool.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class TestTaskPool : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_threads();
+
+      // Fork and join
+      test_wait_nothing();
+      test_spawn_outside();
+      test_spawn_throws();
+      test_spawn_wakesSleeper();
+
+      // Recursive
+      test_fib();
+      test_quicksort();
+      test_reduce_tree();
+
+      report("TaskPool");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // one deque per thread, nothing queued
+   void test_construct_threads()
+   {  // exercise
+      custom::task_pool pool(3);
+      // verify
+      assertUnit(pool.size() == 3);
+      assertUnit(pool.workers.size() == 3);
+      assertUnit(pool.numQueued.load() == 0);
+      assertUnit(pool.shared.empty());
+   }  // teardown
+
+   /***************************************
+    * FORK AND JOIN
+    ***************************************/
+
+   // waiting on an empty group returns at once
+   void test_wait_nothing()
+   {  // setup
+      custom::task_pool pool(2);
+      custom::task_pool::group g;
+      // exercise
+      pool.wait(g);
+      // verify
+      assertUnit(g.done());
+   }  // teardown
+
+   // tasks spawned from outside the pool all run
+   void test_spawn_outside()
+   {  // setup
+      custom::task_pool pool(4);
+      custom::task_pool::group g;
+      std::atomic <int> count(0);
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         pool.spawn(g, [&count]() { count++; });
+      pool.wait(g);
+      // verify
+      assertUnit(count.load() == 1000);
+      assertUnit(g.done());
+      assertUnit(pool.numQueued.load() == 0);
+   }  // teardown
+
+   // an exception in a task comes out of wait
+   void test_spawn_throws()
+   {  // setup
+      custom::task_pool pool(2);
+      custom::task_pool::group g;
+      std::atomic <int> count(0);
+      bool caught = false;
+      // exercise
+      for (int i = 0; i < 10; i++)
+         pool.spawn(g, [&count, i]()
+         {
+            count++;
+            if (i == 5)
+               throw std::runtime_error("task 5");
+         });
+      try
+      {
+         pool.wait(g);
+      }
+      catch (const std::runtime_error &)
+      {
+         caught = true;
+      }
+      // verify
+      assertUnit(caught);
+      assertUnit(count.load() == 10);   // the rest still ran
+      assertUnit(g.done());
+   }  // teardown
+
+   // a task spawned while every worker is asleep still gets run by one
+   void test_spawn_wakesSleeper()
+   {  // setup
+      custom::task_pool pool(2);
+      custom::task_pool::group g;
+      std::atomic <bool> ran(false);
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (pool.numSleeping.load() != 2 && std::chrono::steady_clock::now() < deadline)
+         std::this_thread::yield();
+      size_t numSleeping = pool.numSleeping.load();
+      // exercise
+      pool.spawn(g, [&ran]() { ran = true; });
+      while (!ran.load() && std::chrono::steady_clock::now() < deadline)
+         std::this_thread::yield();
+      // verify
+      assertUnit(numSleeping == 2);
+      assertUnit(ran.load());          // a worker woke up, not wait() below
+      pool.wait(g);
+      assertUnit(g.done());
+   }  // teardown
+
+   /***************************************
+    * RECURSIVE
+    ***************************************/
+
+   // fib(n) by spawning fib(n - 1) and computing fib(n - 2)
+   void test_fib()
+   {  // setup
+      custom::task_pool pool(4);
+      // exercise
+      long long result = fib(pool, 22);
+      // verify
+      assertUnit(result == 17711);
+   }  // teardown
+
+   // sort by spawning one half of each partition
+   void test_quicksort()
+   {  // setup
+      custom::task_pool pool(4);
+      std::vector <int> v(20000);
+      unsigned int seed = 12345;
+      for (int & value : v)
+      {
+         seed = seed * 1103515245u + 12345u;
+         value = (int)(seed >> 8) % 100000;
+      }
+      // exercise
+      quicksort(pool, v.data(), 0, (int)v.size() - 1);
+      // verify
+      bool sorted = true;
+      for (size_t i = 1; i < v.size(); i++)
+         if (v[i - 1] > v[i])
+            sorted = false;
+      assertUnit(sorted);
+   }  // teardown
+
+   // sum an array by splitting it in half until the pieces are small
+   void test_reduce_tree()
+   {  // setup
+      custom::task_pool pool(4);
+      std::vector <int> v(100000);
+      for (size_t i = 0; i < v.size(); i++)
+         v[i] = (int)i;
+      // exercise
+      long long sum = reduce(pool, v.data(), v.size());
+      // verify
+      assertUnit(sum == (long long)v.size() * ((long long)v.size() - 1) / 2);
+   }  // teardown
+
+   /*************************************************************
+    * FIB
+    *************************************************************/
+   static long long fib(custom::task_pool & pool, int n)
+   {
+      if (n < 2)
+         return n;
+      if (n < 12)
+         return fib(pool, n - 1) + fib(pool, n - 2);
+
+      long long a = 0;
+      custom::task_pool::group g;
+      pool.spawn(g, [&pool, &a, n]() { a = fib(pool, n - 1); });
+      long long b = fib(pool, n - 2);
+      pool.wait(g);
+      return a + b;
+   }
+
+   /*************************************************************
+    * QUICKSORT
+    *************************************************************/
+   static void quicksort(custom::task_pool & pool, int * rg, int iBegin, int iEnd)
+   {
+      while (iBegin < iEnd)
+      {
+         int pivot = rg[(iBegin + iEnd) / 2];
+         int i = iBegin;
+         int j = iEnd;
+         while (i <= j)
+         {
+            while (rg[i] < pivot)
+               i++;
+            while (rg[j] > pivot)
+               j--;
+            if (i <= j)
+               std::swap(rg[i++], rg[j--]);
+         }
+
+         if (j - iBegin < 500)
+            quicksort(pool, rg, iBegin, j);
+         else
+         {
+            custom::task_pool::group g;
+            pool.spawn(g, [&pool, rg, iBegin, j]() { quicksort(pool, rg, iBegin, j); });
+            quicksort(pool, rg, i, iEnd);
+            pool.wait(g);
+            return;
+         }
+         iBegin = i;
+      }
+   }
+
+   /*************************************************************
+    * REDUCE
+    *************************************************************/
+   static long long reduce(custom::task_pool & pool, const int * rg, size_t num)
+   {
+      if (num <= 1000)
+      {
+         long long sum = 0;
+         for (size_t i = 0; i < num; i++)
+            sum += rg[i];
+         return sum;
+      }
+
+      long long left = 0;
+      custom::task_pool::group g;
+      pool.spawn(g, [&pool, &left, rg, num]() { left = reduce(pool, rg, num / 2); });
+      long long right = reduce(pool, rg + num / 2, num - num / 2);
+      pool.wait(g);
+      return left + right;
+   }
+};
+
+#endif // DEBUG
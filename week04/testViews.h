@@ -0,0 +1,394 @@
+/***********************************************************************
+ * Header:
+ *    TEST VIEWS
+ * Summary:
+ *    Unit tests for the lazy views and the generator
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "views.h"
+#include "node.h"
+#include "forwardList.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+class TestViews : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Sources
+      test_chain_node();
+      test_chain_constNode();
+      test_chain_forwardNode();
+      test_all_container();
+      test_all_iterators();
+
+      // Adaptors
+      test_filter_writeThrough();
+      test_filter_none();
+      test_transform_standard();
+      test_take_short();
+      test_take_long();
+      test_zip_uneven();
+      test_chunk_uneven();
+
+      // Pipelines
+      test_pipeline_noCopies();
+      test_pipeline_lazy();
+      test_pipeline_lazyFilter();
+      test_pipeline_pipe();
+
+#ifdef CUSTOM_HAS_GENERATOR
+      // Generator
+      test_generator_finite();
+      test_generator_endless();
+#endif
+
+      report("Views");
+   }
+
+   /***************************************
+    * SOURCES
+    ***************************************/
+
+   // walk a Node chain front to back
+   void test_chain_node()
+   {  // setup
+      Node <int> * pHead = setupChain(5);
+      // exercise
+      std::vector <int> values = collect(custom::chain(pHead));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 2, 3, 4, 5 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // a const chain hands back const values
+   void test_chain_constNode()
+   {  // setup
+      Node <int> * pHead = setupChain(3);
+      const Node <int> * pConst = pHead;
+      // exercise
+      auto view = custom::chain(pConst);
+      int sum = 0;
+      for (const int & value : view)
+         sum += value;
+      // verify
+      assertUnit(sum == 6);
+      assertUnit(view.begin().p == pConst);
+      // teardown
+      clear(pHead);
+   }
+
+   // ForwardNode chains work the same way
+   void test_chain_forwardNode()
+   {  // setup
+      ForwardNode <int> * pHead = nullptr;
+      for (int i = 3; i > 0; i--)
+      {
+         ForwardNode <int> * pNew = insert_after((ForwardNode <int> *)nullptr, i);
+         pNew->pNext = pHead;
+         pHead = pNew;
+      }
+      // exercise
+      std::vector <int> values = collect(custom::chain(pHead));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 2, 3 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // anything with begin() and end()
+   void test_all_container()
+   {  // setup
+      custom::forward_list <int> l{ 11, 26, 31 };
+      // exercise
+      std::vector <int> values = collect(custom::all(l));
+      // verify
+      assertUnit(values == std::vector <int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // a pair of pointers into an array
+   void test_all_iterators()
+   {  // setup
+      int array[] = { 11, 26, 31 };
+      // exercise
+      std::vector <int> values = collect(custom::all(array + 1, array + 3));
+      // verify
+      assertUnit(values == std::vector <int>({ 26, 31 }));
+   }  // teardown
+
+   /***************************************
+    * ADAPTORS
+    ***************************************/
+
+   // filter hands back references, so we can change the source
+   void test_filter_writeThrough()
+   {  // setup
+      Node <int> * pHead = setupChain(6);
+      // exercise
+      for (int & value : custom::filter(custom::chain(pHead), isEven))
+         value = 0;
+      // verify
+      std::vector <int> values = collect(custom::chain(pHead));
+      assertUnit(values == std::vector <int>({ 1, 0, 3, 0, 5, 0 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // nothing passes the filter
+   void test_filter_none()
+   {  // setup
+      Node <int> * pHead = setupChain(3);
+      // exercise
+      std::vector <int> values = collect(custom::filter(custom::chain(pHead),
+                                                        [](int value) { return value > 99; }));
+      // verify
+      assertUnit(values.empty());
+      // teardown
+      clear(pHead);
+   }
+
+   // square everything
+   void test_transform_standard()
+   {  // setup
+      Node <int> * pHead = setupChain(4);
+      // exercise
+      std::vector <int> values = collect(custom::transform(custom::chain(pHead), square));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 4, 9, 16 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // take fewer than there are
+   void test_take_short()
+   {  // setup
+      Node <int> * pHead = setupChain(5);
+      // exercise
+      std::vector <int> values = collect(custom::take(custom::chain(pHead), 2));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 2 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // take more than there are
+   void test_take_long()
+   {  // setup
+      Node <int> * pHead = setupChain(3);
+      // exercise
+      std::vector <int> values = collect(custom::take(custom::chain(pHead), 10));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 2, 3 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // zip stops at the shorter range
+   void test_zip_uneven()
+   {  // setup
+      Node <int> * pHead = setupChain(5);
+      char letters[] = { 'a', 'b', 'c' };
+      // exercise
+      std::vector <int> numbers;
+      std::string text;
+      for (auto pair : custom::zip(custom::chain(pHead), custom::all(letters, letters + 3)))
+      {
+         numbers.push_back(pair.first);
+         text += pair.second;
+         pair.first *= 10;                  // the pair holds references
+      }
+      // verify
+      assertUnit(numbers == std::vector <int>({ 1, 2, 3 }));
+      assertUnit(text == "abc");
+      assertUnit(collect(custom::chain(pHead)) == std::vector <int>({ 10, 20, 30, 4, 5 }));
+      // teardown
+      clear(pHead);
+   }
+
+   // seven values in chunks of three
+   void test_chunk_uneven()
+   {  // setup
+      Node <int> * pHead = setupChain(7);
+      // exercise
+      std::vector <std::vector <int> > chunks;
+      for (auto c : custom::chunk(custom::chain(pHead), 3))
+         chunks.push_back(collect(c));
+      // verify
+      assertUnit(chunks.size() == 3);
+      if (chunks.size() == 3)
+      {
+         assertUnit(chunks[0] == std::vector <int>({ 1, 2, 3 }));
+         assertUnit(chunks[1] == std::vector <int>({ 4, 5, 6 }));
+         assertUnit(chunks[2] == std::vector <int>({ 7 }));
+      }
+      // teardown
+      clear(pHead);
+   }
+
+   /***************************************
+    * PIPELINES
+    ***************************************/
+
+   // filter then take over Spy values: nothing is copied
+   void test_pipeline_noCopies()
+   {  // setup
+      Node <Spy> * pHead = nullptr;
+      Node <Spy> * pTail = nullptr;
+      for (int i = 1; i <= 6; i++)
+      {
+         pTail = insert(pTail, Spy(i), true);
+         if (!pHead)
+            pHead = pTail;
+      }
+      Spy::reset();
+      // exercise
+      int sum = 0;
+      for (const Spy & s : custom::take(custom::filter(custom::chain(pHead),
+                                                       [](const Spy & s) { return s.get() % 2 == 1; }), 2))
+         sum += s.get();
+      // verify
+      assertUnit(sum == 4);                  // 1 + 3
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      // teardown
+      clear(pHead);
+   }
+
+   // once take has enough, no more of the source is read
+   void test_pipeline_lazy()
+   {  // setup
+      Node <int> * pHead = setupChain(100);
+      int numCalls = 0;
+      auto counting = [&numCalls](int value) { numCalls++; return value * value; };
+      // exercise
+      std::vector <int> values = collect(custom::take(custom::transform(custom::chain(pHead), counting), 3));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 4, 9 }));
+      assertUnit(numCalls == 3);
+      // teardown
+      clear(pHead);
+   }
+
+   // once take has enough, filter does not look for the next match
+   void test_pipeline_lazyFilter()
+   {  // setup
+      Node <int> * pHead = setupChain(100);
+      int numCalls = 0;
+      auto counting = [&numCalls](int value) { numCalls++; return value % 2 == 1; };
+      // exercise
+      std::vector <int> values = collect(custom::take(custom::filter(custom::chain(pHead), counting), 2));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 3 }));
+      assertUnit(numCalls == 3);             // 1, 2, 3 and no further
+      // teardown
+      clear(pHead);
+   }
+
+   // the same pipeline with pipes
+   void test_pipeline_pipe()
+   {  // setup
+      Node <int> * pHead = setupChain(10);
+      // exercise
+      std::vector <int> values = collect(custom::chain(pHead)
+                                         | custom::filter(isEven)
+                                         | custom::transform(square)
+                                         | custom::take(3));
+      // verify
+      assertUnit(values == std::vector <int>({ 4, 16, 36 }));
+      // teardown
+      clear(pHead);
+   }
+
+#ifdef CUSTOM_HAS_GENERATOR
+   /***************************************
+    * GENERATOR
+    ***************************************/
+
+   static custom::generator <int> countTo(int num)
+   {
+      for (int i = 1; i <= num; i++)
+         co_yield i;
+   }
+
+   static custom::generator <int> naturals()
+   {
+      for (int i = 1; ; i++)
+         co_yield i;
+   }
+
+   // a generator that finishes on its own
+   void test_generator_finite()
+   {  // setup
+      custom::generator <int> g = countTo(4);
+      // exercise
+      std::vector <int> values = collect(custom::all(g));
+      // verify
+      assertUnit(values == std::vector <int>({ 1, 2, 3, 4 }));
+   }  // teardown
+
+   // an endless generator is fine as long as something stops it
+   void test_generator_endless()
+   {  // setup
+      custom::generator <int> g = naturals();
+      // exercise
+      std::vector <int> values = collect(custom::all(g)
+                                         | custom::filter(isEven)
+                                         | custom::take(3));
+      // verify
+      assertUnit(values == std::vector <int>({ 2, 4, 6 }));
+   }  // teardown
+#endif
+
+   static bool isEven(int value) { return value % 2 == 0; }
+   static int  square(int value) { return value * value;  }
+
+   /*************************************************************
+    * COLLECT
+    * Copy whatever a view produces into a std::vector
+    *************************************************************/
+   template <class Range>
+   std::vector <int> collect(Range view)
+   {
+      std::vector <int> values;
+      for (auto it = view.begin(); it != view.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   /*************************************************************
+    * SETUP CHAIN
+    *    +---+   +---+       +-----+
+    *    | 1 | - | 2 | - ... | num |
+    *    +---+   +---+       +-----+
+    *************************************************************/
+   Node <int> * setupChain(int num)
+   {
+      Node <int> * pHead = nullptr;
+      Node <int> * pTail = nullptr;
+      for (int i = 1; i <= num; i++)
+      {
+         pTail = insert(pTail, i, true);
+         if (!pHead)
+            pHead = pTail;
+      }
+      return pHead;
+   }
+};
+
+#endif // DEBUG
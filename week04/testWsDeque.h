@@ -0,0 +1,256 @@
+/***********************************************************************
+ * Header:
+ *    TEST WORK-STEALING DEQUE
+ * Summary:
+ *    Unit tests for ws_deque
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "wsDeque.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestWsDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_roundUp();
+
+      // Owner
+      test_pop_empty();
+      test_pushPop_lifo();
+      test_push_grow();
+
+      // Thief
+      test_steal_empty();
+      test_steal_fifo();
+      test_steal_afterGrow();
+      test_popSteal_lastOne();
+
+      // Threads
+      test_threads_ownerAndThieves();
+
+      report("WsDeque");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // an empty deque with room for 64
+   void test_construct_default()
+   {  // exercise
+      custom::ws_deque <int> d;
+      // verify
+      assertUnit(d.top.load() == 0);
+      assertUnit(d.bottom.load() == 0);
+      assertUnit(d.capacity() == 64);
+      assertUnit(d.size() == 0);
+      assertUnit(d.empty());
+   }  // teardown
+
+   // the capacity is always a power of two
+   void test_construct_roundUp()
+   {  // exercise
+      custom::ws_deque <int> d(100);
+      // verify
+      assertUnit(d.capacity() == 128);
+      assertUnit(d.pArray.load()->mask == 127);
+   }  // teardown
+
+   /***************************************
+    * OWNER
+    ***************************************/
+
+   // pop from an empty deque leaves it alone
+   void test_pop_empty()
+   {  // setup
+      custom::ws_deque <int> d;
+      int value = 99;
+      // exercise
+      bool popped = d.pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(value == 99);
+      assertUnit(d.top.load() == 0);
+      assertUnit(d.bottom.load() == 0);
+   }  // teardown
+
+   // the owner gets the newest first
+   void test_pushPop_lifo()
+   {  // setup
+      custom::ws_deque <int> d;
+      int v1 = 0, v2 = 0, v3 = 0, v4 = 0;
+      // exercise
+      d.push(11);
+      d.push(26);
+      d.push(31);
+      bool p1 = d.pop(v1);
+      bool p2 = d.pop(v2);
+      bool p3 = d.pop(v3);
+      bool p4 = d.pop(v4);
+      // verify
+      assertUnit(p1 && p2 && p3 && !p4);
+      assertUnit(v1 == 31);
+      assertUnit(v2 == 26);
+      assertUnit(v3 == 11);
+      assertUnit(d.empty());
+   }  // teardown
+
+   // filling the array doubles it and keeps the order
+   void test_push_grow()
+   {  // setup
+      custom::ws_deque <int> d(2);
+      // exercise
+      for (int i = 1; i <= 5; i++)
+         d.push(i);
+      // verify
+      assertUnit(d.capacity() == 8);
+      assertUnit(d.size() == 5);
+      for (int i = 5; i >= 1; i--)
+      {
+         int value = 0;
+         assertUnit(d.pop(value));
+         assertUnit(value == i);
+      }
+      assertUnit(d.empty());
+   }  // teardown
+
+   /***************************************
+    * THIEF
+    ***************************************/
+
+   // nothing to steal from an empty deque
+   void test_steal_empty()
+   {  // setup
+      custom::ws_deque <int> d;
+      int value = 99;
+      // exercise
+      bool stolen = d.steal(value);
+      // verify
+      assertUnit(!stolen);
+      assertUnit(value == 99);
+      assertUnit(d.top.load() == 0);
+   }  // teardown
+
+   // a thief gets the oldest first
+   void test_steal_fifo()
+   {  // setup
+      custom::ws_deque <int> d;
+      d.push(11);
+      d.push(26);
+      d.push(31);
+      int v1 = 0, v2 = 0;
+      // exercise
+      bool s1 = d.steal(v1);
+      bool s2 = d.steal(v2);
+      // verify
+      assertUnit(s1 && s2);
+      assertUnit(v1 == 11);
+      assertUnit(v2 == 26);
+      assertUnit(d.top.load() == 2);
+      assertUnit(d.size() == 1);
+   }  // teardown
+
+   // growing after some steals copies only what is left
+   void test_steal_afterGrow()
+   {  // setup
+      custom::ws_deque <int> d(4);
+      int value = 0;
+      for (int i = 1; i <= 4; i++)
+         d.push(i);
+      d.steal(value);
+      d.steal(value);
+      // exercise
+      for (int i = 5; i <= 7; i++)
+         d.push(i);
+      // verify
+      assertUnit(d.capacity() == 8);
+      for (int i = 3; i <= 7; i++)
+      {
+         assertUnit(d.steal(value));
+         assertUnit(value == i);
+      }
+      assertUnit(d.empty());
+   }  // teardown
+
+   // taking the last one leaves the counters equal
+   void test_popSteal_lastOne()
+   {  // setup
+      custom::ws_deque <int> d;
+      d.push(11);
+      d.push(26);
+      int v1 = 0, v2 = 0, v3 = 0;
+      // exercise
+      bool s1 = d.steal(v1);
+      bool p2 = d.pop(v2);
+      bool s3 = d.steal(v3);
+      // verify
+      assertUnit(s1 && p2 && !s3);
+      assertUnit(v1 == 11);
+      assertUnit(v2 == 26);
+      assertUnit(d.top.load() == d.bottom.load());
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // the owner pushes and pops while thieves steal;
+   // every value is taken exactly once
+   void test_threads_ownerAndThieves()
+   {  // setup
+      const int NUM_THIEVES = 3;
+      const int NUM_VALUES = 20000;
+      custom::ws_deque <int> d(4);
+      std::vector <std::atomic <int> > seen(NUM_VALUES);
+      for (auto & count : seen)
+         count.store(0);
+      std::atomic <bool> done(false);
+      std::vector <std::thread> thieves;
+      // exercise
+      for (int i = 0; i < NUM_THIEVES; i++)
+         thieves.push_back(std::thread([&d, &seen, &done]()
+         {
+            int value;
+            while (!done.load() || !d.empty())
+               if (d.steal(value))
+                  seen[value]++;
+         }));
+      int value;
+      for (int i = 0; i < NUM_VALUES; i++)
+      {
+         d.push(i);
+         if (i % 3 == 0 && d.pop(value))
+            seen[value]++;
+      }
+      while (d.pop(value))
+         seen[value]++;
+      done.store(true);
+      for (auto & thread : thieves)
+         thread.join();
+      // verify
+      int numWrong = 0;
+      for (auto & count : seen)
+         if (count.load() != 1)
+            numWrong++;
+      assertUnit(numWrong == 0);
+      assertUnit(d.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
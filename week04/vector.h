@@ -0,0 +1,588 @@
+/***********************************************************************
+ * Header:
+ *    VECTOR
+ * Summary:
+ *    Our custom implementation of std::vector
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    The buffer is raw storage and only the first numElements
+ *    slots hold live objects, so growing never default-constructs
+ *    anything and elements are moved, not copied, into a bigger buffer.
+ *
+ *    This will contain the class definition of:
+ *        vector                 : A class that represents a Vector
+ *        vector::iterator       : An interator through Vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>           // because I am paranoid
+#include <cstddef>           // for size_t
+#include <initializer_list>  // for std::initializer_list
+#include <iterator>          // for std::bidirectional_iterator_tag
+#include <new>               // std::bad_alloc
+#include <memory>            // for std::allocator
+#include <utility>           // for std::move
+
+class TestVector; // forward declaration for unit tests
+class TestStack;
+class TestPQueue;
+class TestHash;
+
+namespace custom
+{
+
+/*****************************************
+ * VECTOR
+ * Just like the std :: vector <T> class
+ ****************************************/
+template <typename T>
+class vector
+{
+   friend class ::TestVector; // give unit tests access to the privates
+   friend class ::TestStack;
+   friend class ::TestPQueue;
+   friend class ::TestHash;
+public:
+
+   //
+   // Construct
+   //
+
+   vector();
+   vector(size_t numElements                );
+   vector(size_t numElements, const T & t   );
+   vector(const std::initializer_list<T>& l );
+   vector(const vector &  rhs);
+   vector(      vector && rhs);
+   ~vector();
+
+   //
+   // Assign
+   //
+
+   void swap(vector& rhs)
+   {
+      std::swap(data,        rhs.data);
+      std::swap(numCapacity, rhs.numCapacity);
+      std::swap(numElements, rhs.numElements);
+   }
+   vector & operator = (const vector & rhs);
+   vector & operator = (vector&& rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator       begin() { return iterator(data);               }
+   iterator       end()   { return iterator(data + numElements); }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index);
+   const T& operator [] (size_t index) const;
+         T& front();
+   const T& front() const;
+         T& back();
+   const T& back() const;
+
+   //
+   // Insert
+   //
+
+   void push_back(const T& t) { emplace_back(t);            }
+   void push_back(T&& t)      { emplace_back(std::move(t)); }
+   template <class ... Args>
+   void emplace_back(Args && ... args);
+   void reserve(size_t newCapacity);
+   void resize(size_t newElements);
+   void resize(size_t newElements, const T& t);
+
+   //
+   // Remove
+   //
+
+   void clear()
+   {
+      destroy(0, numElements);
+      numElements = 0;
+   }
+   void pop_back()
+   {
+      if (numElements > 0)
+         data[--numElements].~T();
+   }
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements;       }
+   size_t  capacity()      const { return numCapacity;       }
+   bool empty()            const { return numElements == 0;  }
+
+private:
+
+   // raw storage from operator new[], so a buffer made by new T[]
+   // for a trivial T can be handed to us and freed here
+   static T *  allocate(size_t num)          { return num == 0 ? nullptr : static_cast<T *>(::operator new[](num * sizeof(T))); }
+   static void deallocate(T * p, size_t)     { ::operator delete[](static_cast<void *>(p));                                  }
+   void        destroy(size_t iBegin, size_t iEnd)
+   {
+      for (size_t i = iBegin; i < iEnd; i++)
+         data[i].~T();
+   }
+
+   T *  data;                 // user data, a dynamically-allocated array
+   size_t  numCapacity;       // the capacity of the array
+   size_t  numElements;       // the number of items currently used
+};
+
+/**************************************************
+ * VECTOR ITERATOR
+ * An iterator through vector.  You only need to
+ * support the following:
+ *   1. Constructors (default and copy)
+ *   2. Not equals operator
+ *   3. Increment (prefix and postfix)
+ *   4. Dereference
+ * This particular iterator is a bi-directional meaning
+ * that ++ and -- both work.  Not all iterators are that way.
+ *************************************************/
+template <typename T>
+class vector <T> ::iterator
+{
+   friend class ::TestVector; // give unit tests access to the privates
+   friend class ::TestStack;
+   friend class ::TestPQueue;
+   friend class ::TestHash;
+public:
+   typedef std::bidirectional_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef T *                             pointer;
+   typedef T &                             reference;
+
+   // constructors, destructors, and assignment operator
+   iterator()                           : p(nullptr)        {}
+   iterator(T* p)                       : p(p)              {}
+   iterator(const iterator& rhs)        : p(rhs.p)          {}
+   iterator(size_t index, vector<T>& v) : p(v.data + index) {}
+   iterator& operator = (const iterator& rhs)
+   {
+      this->p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals operator
+   bool operator != (const iterator& rhs) const { return rhs.p != p; }
+   bool operator == (const iterator& rhs) const { return rhs.p == p; }
+
+   // dereference operator
+   T& operator * ()
+   {
+      return *p;
+   }
+
+   // prefix increment
+   iterator& operator ++ ()
+   {
+      p++;
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int postfix)
+   {
+      iterator itReturn(*this);
+      p++;
+      return itReturn;
+   }
+
+   // prefix decrement
+   iterator& operator -- ()
+   {
+      p--;
+      return *this;
+   }
+
+   // postfix decrement
+   iterator operator -- (int postfix)
+   {
+      iterator itReturn(*this);
+      p--;
+      return itReturn;
+   }
+
+private:
+   T* p;
+};
+
+/*****************************************
+ * VECTOR :: DEFAULT constructors
+ * Default constructor: allocates no memory
+ ****************************************/
+template <typename T>
+vector <T> :: vector() : data(nullptr), numCapacity(0), numElements(0)
+{
+}
+
+/*****************************************
+ * VECTOR :: NON-DEFAULT constructors
+ * non-default constructor: set the number of elements,
+ * construct each element, and copy the values over
+ ****************************************/
+template <typename T>
+vector <T> :: vector(size_t num, const T & t) :
+   data(allocate(num)), numCapacity(num), numElements(0)
+{
+   for (; numElements < num; numElements++)
+      new ((void *)(data + numElements)) T(t);
+}
+
+/*****************************************
+ * VECTOR :: INITIALIZATION LIST constructors
+ * Create a vector with an initialization list.
+ ****************************************/
+template <typename T>
+vector <T> :: vector(const std::initializer_list<T> & l) :
+   data(allocate(l.size())), numCapacity(l.size()), numElements(0)
+{
+   for (const T * p = l.begin(); p != l.end(); p++)
+      new ((void *)(data + numElements++)) T(*p);
+}
+
+/*****************************************
+ * VECTOR :: NON-DEFAULT constructors
+ * non-default constructor: set the number of elements,
+ * construct each element with its default constructor
+ ****************************************/
+template <typename T>
+vector <T> :: vector(size_t num) :
+   data(allocate(num)), numCapacity(num), numElements(0)
+{
+   for (; numElements < num; numElements++)
+      new ((void *)(data + numElements)) T();
+}
+
+/*****************************************
+ * VECTOR :: COPY CONSTRUCTOR
+ * Allocate the space for numElements and
+ * call the copy constructor on each element
+ ****************************************/
+template <typename T>
+vector <T> :: vector (const vector & rhs) :
+   data(allocate(rhs.numElements)), numCapacity(rhs.numElements), numElements(0)
+{
+   for (; numElements < rhs.numElements; numElements++)
+      new ((void *)(data + numElements)) T(rhs.data[numElements]);
+}
+
+/*****************************************
+ * VECTOR :: MOVE CONSTRUCTOR
+ * Steal the values from the RHS and set it to zero.
+ ****************************************/
+template <typename T>
+vector <T> :: vector (vector && rhs) :
+   data(rhs.data), numCapacity(rhs.numCapacity), numElements(rhs.numElements)
+{
+   rhs.data = nullptr;
+   rhs.numCapacity = 0;
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * VECTOR :: DESTRUCTOR
+ * Call the destructor for each element from 0..numElements
+ * and then free the memory
+ ****************************************/
+template <typename T>
+vector <T> :: ~vector()
+{
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+}
+
+/***************************************
+ * VECTOR :: RESIZE
+ * This method will adjust the size to newElements.
+ * This will either grow or shrink newElements.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T>
+void vector <T> :: resize(size_t newElements)
+{
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         new ((void *)(data + i)) T();
+   }
+   numElements = newElements;
+}
+
+template <typename T>
+void vector <T> :: resize(size_t newElements, const T & t)
+{
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         new ((void *)(data + i)) T(t);
+   }
+   numElements = newElements;
+}
+
+/***************************************
+ * VECTOR :: RESERVE
+ * This method will grow the current buffer
+ * to newCapacity.  It will also move all
+ * the data from the old buffer into the new
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T>
+void vector <T> :: reserve(size_t newCapacity)
+{
+   if (newCapacity <= numCapacity)
+      return;
+
+   T * dataNew = allocate(newCapacity);
+   for (size_t i = 0; i < numElements; i++)
+      new ((void *)(dataNew + i)) T(std::move(data[i]));
+
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = newCapacity;
+}
+
+/***************************************
+ * VECTOR :: SHRINK TO FIT
+ * Get rid of any extra capacity
+ *     INPUT  :
+ *     OUTPUT :
+ **************************************/
+template <typename T>
+void vector <T> :: shrink_to_fit()
+{
+   if (numElements == numCapacity)
+      return;
+
+   T * dataNew = allocate(numElements);
+   for (size_t i = 0; i < numElements; i++)
+      new ((void *)(dataNew + i)) T(std::move(data[i]));
+
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = numElements;
+}
+
+/*****************************************
+ * VECTOR :: SUBSCRIPT
+ * Read-Write access
+ ****************************************/
+template <typename T>
+T & vector <T> :: operator [] (size_t index)
+{
+   assert(index < numElements);
+   return data[index];
+}
+
+/******************************************
+ * VECTOR :: SUBSCRIPT
+ * Read-Write access
+ *****************************************/
+template <typename T>
+const T & vector <T> :: operator [] (size_t index) const
+{
+   assert(index < numElements);
+   return data[index];
+}
+
+/*****************************************
+ * VECTOR :: FRONT
+ * Read-Write access
+ ****************************************/
+template <typename T>
+T & vector <T> :: front ()
+{
+   assert(numElements > 0);
+   return data[0];
+}
+
+/******************************************
+ * VECTOR :: FRONT
+ * Read-Write access
+ *****************************************/
+template <typename T>
+const T & vector <T> :: front () const
+{
+   assert(numElements > 0);
+   return data[0];
+}
+
+/*****************************************
+ * VECTOR :: BACK
+ * Read-Write access
+ ****************************************/
+template <typename T>
+T & vector <T> :: back()
+{
+   assert(numElements > 0);
+   return data[numElements - 1];
+}
+
+/******************************************
+ * VECTOR :: BACK
+ * Read-Write access
+ *****************************************/
+template <typename T>
+const T & vector <T> :: back() const
+{
+   assert(numElements > 0);
+   return data[numElements - 1];
+}
+
+/***************************************
+ * VECTOR :: EMPLACE BACK
+ * This method will construct a new element at the
+ * end of the current buffer from args.  It will also
+ * double the buffer as needed to accomodate it.
+ * push_back is an emplace_back of a T.
+ *     INPUT  : args for the constructor of T
+ *     OUTPUT : *this
+ **************************************/
+template <typename T>
+template <class ... Args>
+void vector <T> :: emplace_back(Args && ... args)
+{
+   if (numElements < numCapacity)
+   {
+      new ((void *)(data + numElements)) T(std::forward<Args>(args)...);
+      numElements++;
+      return;
+   }
+
+   // build the new element before moving the old ones:
+   // args may refer to something in the old buffer
+   size_t newCapacity = (numCapacity == 0 ? 1 : numCapacity * 2);
+   T * dataNew = allocate(newCapacity);
+   try
+   {
+      new ((void *)(dataNew + numElements)) T(std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      deallocate(dataNew, newCapacity);
+      throw;
+   }
+
+   for (size_t i = 0; i < numElements; i++)
+      new ((void *)(dataNew + i)) T(std::move(data[i]));
+   destroy(0, numElements);
+   deallocate(data, numCapacity);
+   data = dataNew;
+   numCapacity = newCapacity;
+   numElements++;
+}
+
+/***************************************
+ * VECTOR :: ASSIGNMENT
+ * This operator will copy the contents of the
+ * rhs onto *this, growing the buffer as needed.
+ * Elements we already have are assigned over.
+ *     INPUT  : rhs the vector to copy from
+ *     OUTPUT : *this
+ **************************************/
+template <typename T>
+vector <T> & vector <T> :: operator = (const vector & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   // not enough room: start over with a buffer of exactly the right size
+   if (rhs.numElements > numCapacity)
+   {
+      T * dataNew = allocate(rhs.numElements);
+      for (size_t i = 0; i < rhs.numElements; i++)
+         new ((void *)(dataNew + i)) T(rhs.data[i]);
+
+      destroy(0, numElements);
+      deallocate(data, numCapacity);
+      data = dataNew;
+      numCapacity = rhs.numElements;
+      numElements = rhs.numElements;
+      return *this;
+   }
+
+   // enough room: assign over what we have, construct or destroy the rest
+   size_t numCommon = rhs.numElements < numElements ? rhs.numElements : numElements;
+   for (size_t i = 0; i < numCommon; i++)
+      data[i] = rhs.data[i];
+   for (size_t i = numCommon; i < rhs.numElements; i++)
+      new ((void *)(data + i)) T(rhs.data[i]);
+   destroy(rhs.numElements, numElements);
+   numElements = rhs.numElements;
+   return *this;
+}
+
+/***************************************
+ * VECTOR :: MOVE ASSIGNMENT
+ * Move the elements of rhs onto *this the same way
+ * the copy assignment copies them, then empty rhs.
+ * Both vectors keep their buffers.
+ *     INPUT  : rhs the vector to move from
+ *     OUTPUT : *this
+ **************************************/
+template <typename T>
+vector <T>& vector <T> :: operator = (vector&& rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   if (rhs.numElements > numCapacity)
+   {
+      T * dataNew = allocate(rhs.numElements);
+      for (size_t i = 0; i < rhs.numElements; i++)
+         new ((void *)(dataNew + i)) T(std::move(rhs.data[i]));
+
+      destroy(0, numElements);
+      deallocate(data, numCapacity);
+      data = dataNew;
+      numCapacity = rhs.numElements;
+      numElements = rhs.numElements;
+      rhs.clear();
+      return *this;
+   }
+
+   size_t numCommon = rhs.numElements < numElements ? rhs.numElements : numElements;
+   for (size_t i = 0; i < numCommon; i++)
+      data[i] = std::move(rhs.data[i]);
+   for (size_t i = numCommon; i < rhs.numElements; i++)
+      new ((void *)(data + i)) T(std::move(rhs.data[i]));
+   destroy(rhs.numElements, numElements);
+   numElements = rhs.numElements;
+   rhs.clear();
+   return *this;
+}
+
+} // namespace custom
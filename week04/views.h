@@ -0,0 +1,583 @@
+/***********************************************************************
+ * Header:
+ *    VIEWS
+ * Summary:
+ *    Lazy ranges over Node chains, custom::vector, or anything else with
+ *    begin() and end().  A view holds a pair of iterators and does its
+ *    work one element at a time as it is walked, so a pipeline such as
+ *
+ *       for (auto && x : take(transform(filter(all(v), isOdd), square), 3))
+ *
+ *    is one pass over v with no intermediate containers.  Every adaptor
+ *    can also be written with a pipe:
+ *
+ *       for (auto && x : all(v) | filter(isOdd) | transform(square) | take(3))
+ *
+ *    The iterators only need *, prefix ++, and !=, which is what our own
+ *    iterators provide.  A view refers to the elements of its source, so
+ *    the source must outlive it.  A generator can only be walked once, so
+ *    give the views all(g) rather than g itself.
+ *
+ *    With a C++20 compiler this also has generator, a coroutine that
+ *    produces a sequence one co_yield at a time and can feed any view.
+ *
+ *    This will contain the class definition of:
+ *        range                  : A pair of iterators
+ *        node_iterator          : An iterator through a Node chain
+ *        filter, transform, take, zip, chunk : the lazy views
+ *        generator              : A coroutine that yields values (C++20)
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <utility>     // for std::declval, std::pair
+
+#if defined(__has_include)
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#define CUSTOM_HAS_GENERATOR
+#include <coroutine>   // for std::coroutine_handle
+#include <exception>   // for std::exception_ptr
+#endif
+#endif
+
+class TestViews; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * RANGE
+ * A begin and an end.  Every view is a range whose
+ * iterators do the lazy work.
+ *************************************************/
+template <class Iterator>
+class range
+{
+public:
+   typedef Iterator iterator;
+
+   range(Iterator itBegin, Iterator itEnd) : itBegin(itBegin), itEnd(itEnd) {}
+
+   Iterator begin() const { return itBegin; }
+   Iterator end()   const { return itEnd;   }
+
+private:
+   Iterator itBegin;
+   Iterator itEnd;
+};
+
+/**************************************************
+ * NODE ITERATOR
+ * Walk a Node or ForwardNode chain through pNext.
+ * The end of every chain is nullptr.
+ *************************************************/
+template <class TNode>
+class node_iterator
+{
+   friend class ::TestViews; // give unit tests access to the privates
+public:
+   node_iterator()           : p(nullptr) {}
+   node_iterator(TNode * p)  : p(p)       {}
+
+   bool operator != (const node_iterator & rhs) const { return rhs.p != p; }
+   bool operator == (const node_iterator & rhs) const { return rhs.p == p; }
+
+   decltype((std::declval<TNode &>().data)) operator * () { return p->data; }
+
+   node_iterator & operator ++ ()
+   {
+      p = p->pNext;
+      return *this;
+   }
+
+private:
+   TNode * p;
+};
+
+/***********************************************
+ * ALL
+ * Make a range out of a container, an iterator
+ * pair, or the head of a Node chain
+ **********************************************/
+template <class Container>
+inline auto all(Container & container) -> range <decltype(container.begin())>
+{
+   return range <decltype(container.begin())>(container.begin(), container.end());
+}
+
+template <class Iterator>
+inline range <Iterator> all(Iterator itBegin, Iterator itEnd)
+{
+   return range <Iterator>(itBegin, itEnd);
+}
+
+template <class TNode>
+inline range <node_iterator <TNode> > chain(TNode * pHead)
+{
+   return range <node_iterator <TNode> >(node_iterator <TNode>(pHead),
+                                         node_iterator <TNode>(nullptr));
+}
+
+/**************************************************
+ * FILTER ITERATOR
+ * Skip every element the predicate rejects.  The
+ * predicate lives in the view; we point at it.
+ *************************************************/
+template <class Iterator, class Predicate>
+class filter_iterator
+{
+public:
+   filter_iterator(Iterator it, Iterator itEnd, Predicate * pPred) :
+      it(it), itEnd(itEnd), pPred(pPred)
+   {
+      skip();
+   }
+
+   bool operator != (const filter_iterator & rhs) const { return it != rhs.it; }
+   bool operator == (const filter_iterator & rhs) const { return !(it != rhs.it); }
+
+   decltype(*std::declval<Iterator &>()) operator * () { return *it; }
+
+   filter_iterator & operator ++ ()
+   {
+      ++it;
+      skip();
+      return *this;
+   }
+
+private:
+   void skip()
+   {
+      while (it != itEnd && !(*pPred)(*it))
+         ++it;
+   }
+
+   Iterator    it;
+   Iterator    itEnd;
+   Predicate * pPred;
+};
+
+/**************************************************
+ * TRANSFORM ITERATOR
+ * Hand back f(element) instead of the element
+ *************************************************/
+template <class Iterator, class Function>
+class transform_iterator
+{
+public:
+   transform_iterator(Iterator it, Function * pFunction) : it(it), pFunction(pFunction) {}
+
+   bool operator != (const transform_iterator & rhs) const { return it != rhs.it; }
+   bool operator == (const transform_iterator & rhs) const { return !(it != rhs.it); }
+
+   decltype(std::declval<Function &>()(*std::declval<Iterator &>())) operator * ()
+   {
+      return (*pFunction)(*it);
+   }
+
+   transform_iterator & operator ++ ()
+   {
+      ++it;
+      return *this;
+   }
+
+private:
+   Iterator   it;
+   Function * pFunction;
+};
+
+/**************************************************
+ * TAKE ITERATOR
+ * Count down as we go; we are at the end when the
+ * count runs out or the source does
+ *************************************************/
+template <class Iterator>
+class take_iterator
+{
+public:
+   take_iterator(Iterator it, Iterator itEnd, size_t num) : it(it), itEnd(itEnd), num(num) {}
+
+   bool operator != (const take_iterator & rhs) const { return isDone() != rhs.isDone() || (!isDone() && it != rhs.it); }
+   bool operator == (const take_iterator & rhs) const { return !(*this != rhs); }
+
+   decltype(*std::declval<Iterator &>()) operator * () { return *it; }
+
+   // the source only moves on if we still want more of it, so
+   // nothing past the last element taken is ever read
+   take_iterator & operator ++ ()
+   {
+      if (--num > 0)
+         ++it;
+      return *this;
+   }
+
+private:
+   bool isDone() const { return num == 0 || !(it != itEnd); }
+
+   Iterator it;
+   Iterator itEnd;
+   size_t   num;     // how many elements are left to take
+};
+
+/**************************************************
+ * ZIP ITERATOR
+ * Walk two ranges side by side, handing back a pair
+ * of references.  We stop when either one runs out.
+ *************************************************/
+template <class Iterator1, class Iterator2>
+class zip_iterator
+{
+public:
+   typedef std::pair <decltype(*std::declval<Iterator1 &>()),
+                      decltype(*std::declval<Iterator2 &>())> reference;
+
+   zip_iterator(Iterator1 it1, Iterator1 itEnd1, Iterator2 it2, Iterator2 itEnd2) :
+      it1(it1), itEnd1(itEnd1), it2(it2), itEnd2(itEnd2) {}
+
+   bool operator != (const zip_iterator & rhs) const { return isDone() != rhs.isDone() || (!isDone() && it1 != rhs.it1); }
+   bool operator == (const zip_iterator & rhs) const { return !(*this != rhs); }
+
+   reference operator * () { return reference(*it1, *it2); }
+
+   zip_iterator & operator ++ ()
+   {
+      ++it1;
+      ++it2;
+      return *this;
+   }
+
+private:
+   bool isDone() const { return !(it1 != itEnd1) || !(it2 != itEnd2); }
+
+   Iterator1 it1;
+   Iterator1 itEnd1;
+   Iterator2 it2;
+   Iterator2 itEnd2;
+};
+
+/**************************************************
+ * CHUNK ITERATOR
+ * Each element is itself a view of the next num
+ * elements of the source (fewer for the last one)
+ *************************************************/
+template <class Iterator>
+class chunk_iterator
+{
+public:
+   chunk_iterator(Iterator it, Iterator itEnd, size_t num) : it(it), itEnd(itEnd), num(num) {}
+
+   bool operator != (const chunk_iterator & rhs) const { return it != rhs.it; }
+   bool operator == (const chunk_iterator & rhs) const { return !(it != rhs.it); }
+
+   range <take_iterator <Iterator> > operator * ()
+   {
+      return range <take_iterator <Iterator> >(take_iterator <Iterator>(it,    itEnd, num),
+                                               take_iterator <Iterator>(itEnd, itEnd, 0));
+   }
+
+   chunk_iterator & operator ++ ()
+   {
+      for (size_t i = 0; i < num && it != itEnd; i++)
+         ++it;
+      return *this;
+   }
+
+private:
+   Iterator it;
+   Iterator itEnd;
+   size_t   num;     // how many elements per chunk
+};
+
+/**************************************************
+ * VIEWS
+ * Each view owns its source range and anything else
+ * its iterators need, and makes the iterators when
+ * asked.  The iterators point back into the view, so
+ * the view must outlive them.
+ *************************************************/
+template <class Range, class Predicate>
+class filter_view
+{
+   typedef decltype(std::declval<Range &>().begin()) base_iterator;
+public:
+   typedef filter_iterator <base_iterator, Predicate> iterator;
+
+   filter_view(const Range & base, const Predicate & pred) : base(base), pred(pred) {}
+
+   iterator begin() { return iterator(base.begin(), base.end(), &pred); }
+   iterator end()   { return iterator(base.end(),   base.end(), &pred); }
+
+private:
+   Range     base;
+   Predicate pred;
+};
+
+template <class Range, class Function>
+class transform_view
+{
+   typedef decltype(std::declval<Range &>().begin()) base_iterator;
+public:
+   typedef transform_iterator <base_iterator, Function> iterator;
+
+   transform_view(const Range & base, const Function & function) : base(base), function(function) {}
+
+   iterator begin() { return iterator(base.begin(), &function); }
+   iterator end()   { return iterator(base.end(),   &function); }
+
+private:
+   Range    base;
+   Function function;
+};
+
+template <class Range>
+class take_view
+{
+   typedef decltype(std::declval<Range &>().begin()) base_iterator;
+public:
+   typedef take_iterator <base_iterator> iterator;
+
+   take_view(const Range & base, size_t num) : base(base), num(num) {}
+
+   iterator begin() { return iterator(base.begin(), base.end(), num); }
+   iterator end()   { return iterator(base.end(),   base.end(), 0);   }
+
+private:
+   Range  base;
+   size_t num;
+};
+
+template <class Range1, class Range2>
+class zip_view
+{
+   typedef decltype(std::declval<Range1 &>().begin()) base_iterator1;
+   typedef decltype(std::declval<Range2 &>().begin()) base_iterator2;
+public:
+   typedef zip_iterator <base_iterator1, base_iterator2> iterator;
+
+   zip_view(const Range1 & base1, const Range2 & base2) : base1(base1), base2(base2) {}
+
+   iterator begin() { return iterator(base1.begin(), base1.end(), base2.begin(), base2.end()); }
+   iterator end()   { return iterator(base1.end(),   base1.end(), base2.end(),   base2.end()); }
+
+private:
+   Range1 base1;
+   Range2 base2;
+};
+
+template <class Range>
+class chunk_view
+{
+   typedef decltype(std::declval<Range &>().begin()) base_iterator;
+public:
+   typedef chunk_iterator <base_iterator> iterator;
+
+   chunk_view(const Range & base, size_t num) : base(base), num(num) {}
+
+   iterator begin() { return iterator(base.begin(), base.end(), num); }
+   iterator end()   { return iterator(base.end(),   base.end(), num); }
+
+private:
+   Range  base;
+   size_t num;
+};
+
+/***********************************************
+ * FILTER
+ * Only the elements for which pred is true
+ *   COST   : O(1) to make, the walk does the work
+ **********************************************/
+template <class Range, class Predicate>
+inline filter_view <Range, Predicate> filter(const Range & base, Predicate pred)
+{
+   return filter_view <Range, Predicate>(base, pred);
+}
+
+/***********************************************
+ * TRANSFORM
+ * f applied to every element, computed on demand
+ *   COST   : O(1) to make, the walk does the work
+ **********************************************/
+template <class Range, class Function>
+inline transform_view <Range, Function> transform(const Range & base, Function f)
+{
+   return transform_view <Range, Function>(base, f);
+}
+
+/***********************************************
+ * TAKE
+ * At most the first num elements.  Nothing past
+ * them is ever read, so this works on an endless
+ * generator.
+ *   COST   : O(1)
+ **********************************************/
+template <class Range>
+inline take_view <Range> take(const Range & base, size_t num)
+{
+   return take_view <Range>(base, num);
+}
+
+/***********************************************
+ * ZIP
+ * Pairs of elements from two ranges, as long as
+ * the shorter one
+ *   COST   : O(1)
+ **********************************************/
+template <class Range1, class Range2>
+inline zip_view <Range1, Range2> zip(const Range1 & base1, const Range2 & base2)
+{
+   return zip_view <Range1, Range2>(base1, base2);
+}
+
+/***********************************************
+ * CHUNK
+ * The elements in groups of num
+ *   COST   : O(1)
+ **********************************************/
+template <class Range>
+inline chunk_view <Range> chunk(const Range & base, size_t num)
+{
+   return chunk_view <Range>(base, num);
+}
+
+/**************************************************
+ * ADAPTORS
+ * What filter(pred), transform(f), take(n), and
+ * chunk(n) return so they can follow a pipe
+ *************************************************/
+template <class Predicate> struct filter_adaptor    { Predicate pred;  };
+template <class Function>  struct transform_adaptor { Function  f;     };
+struct take_adaptor                                 { size_t    num;   };
+struct chunk_adaptor                                { size_t    num;   };
+
+template <class Predicate>
+inline filter_adaptor <Predicate>    filter(Predicate pred) { return filter_adaptor <Predicate>{ pred }; }
+template <class Function>
+inline transform_adaptor <Function>  transform(Function f)  { return transform_adaptor <Function>{ f };  }
+inline take_adaptor                  take(size_t num)       { return take_adaptor{ num };                }
+inline chunk_adaptor                 chunk(size_t num)      { return chunk_adaptor{ num };               }
+
+template <class Range, class Predicate>
+inline auto operator | (const Range & base, const filter_adaptor <Predicate> & a)  -> decltype(filter(base, a.pred))
+{
+   return filter(base, a.pred);
+}
+template <class Range, class Function>
+inline auto operator | (const Range & base, const transform_adaptor <Function> & a) -> decltype(transform(base, a.f))
+{
+   return transform(base, a.f);
+}
+template <class Range>
+inline auto operator | (const Range & base, take_adaptor a)  -> decltype(take(base, a.num))
+{
+   return take(base, a.num);
+}
+template <class Range>
+inline auto operator | (const Range & base, chunk_adaptor a) -> decltype(chunk(base, a.num))
+{
+   return chunk(base, a.num);
+}
+
+#ifdef CUSTOM_HAS_GENERATOR
+
+/**************************************************
+ * GENERATOR
+ * A coroutine that produces a sequence of T.  The
+ * body does not run until the first element is asked
+ * for, and each co_yield hands over one element and
+ * waits.  It can only be walked once.
+ *
+ *    generator <int> naturals()
+ *    {
+ *       for (int i = 0; ; i++)
+ *          co_yield i;
+ *    }
+ *************************************************/
+template <class T>
+class generator
+{
+   friend class ::TestViews; // give unit tests access to the privates
+public:
+   struct promise_type
+   {
+      const T *          pValue = nullptr;   // what the body last yielded
+      std::exception_ptr exception;
+
+      generator get_return_object()
+      {
+         return generator(std::coroutine_handle <promise_type>::from_promise(*this));
+      }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend()   noexcept { return {}; }
+      std::suspend_always yield_value(const T & value) noexcept
+      {
+         pValue = &value;
+         return {};
+      }
+      void return_void() {}
+      void unhandled_exception() { exception = std::current_exception(); }
+   };
+
+   class iterator
+   {
+   public:
+      iterator() : handle(nullptr) {}
+      iterator(std::coroutine_handle <promise_type> handle) : handle(handle) {}
+
+      bool operator != (const iterator & rhs) const { return isDone() != rhs.isDone(); }
+      bool operator == (const iterator & rhs) const { return isDone() == rhs.isDone(); }
+
+      const T & operator * () { return *handle.promise().pValue; }
+
+      iterator & operator ++ ()
+      {
+         handle.resume();
+         rethrow();
+         return *this;
+      }
+
+      void rethrow()
+      {
+         if (handle && handle.promise().exception)
+            std::rethrow_exception(handle.promise().exception);
+      }
+
+   private:
+      bool isDone() const { return !handle || handle.done(); }
+
+      std::coroutine_handle <promise_type> handle;
+   };
+
+   generator(const generator & rhs) = delete;
+   generator(generator && rhs) noexcept : handle(rhs.handle) { rhs.handle = nullptr; }
+   generator & operator = (const generator & rhs) = delete;
+   ~generator()
+   {
+      if (handle)
+         handle.destroy();
+   }
+
+   // run the body up to its first co_yield
+   iterator begin()
+   {
+      iterator it(handle);
+      if (handle && !handle.done())
+      {
+         handle.resume();
+         it.rethrow();
+      }
+      return it;
+   }
+   iterator end() { return iterator(); }
+
+private:
+   explicit generator(std::coroutine_handle <promise_type> handle) : handle(handle) {}
+
+   std::coroutine_handle <promise_type> handle;
+};
+
+#endif // CUSTOM_HAS_GENERATOR
+
+} // namespace custom
@@ -0,0 +1,234 @@
+/***********************************************************************
+ * Header:
+ *    WORK-STEALING DEQUE
+ * Summary:
+ *    The Chase-Lev deque.  One thread owns it and pushes and pops at the
+ *    bottom like a stack, so its most recent work stays hot in its cache.
+ *    Any other thread can steal from the top, taking the oldest work,
+ *    which in a fork/join program is usually the biggest piece.  The
+ *    owner only contends with a thief when a single element is left.
+ *
+ *    The elements live in a circular array indexed by two ever-growing
+ *    counters.  When the owner fills it, the owner copies the live range
+ *    into an array twice the size and publishes that.  A thief may still
+ *    be reading the old array, so it is retired through epoch-based
+ *    reclamation rather than deleted.
+ *
+ *    This will contain the class definition of:
+ *        ws_deque               : a single-owner, multi-thief deque
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>       // for std::atomic
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <type_traits>  // for std::is_trivially_copyable
+#include "ebr.h"        // for ebr::guard and ebr::retire
+
+class TestWsDeque; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * WS DEQUE
+ * push and pop from the owning thread only; steal
+ * from anywhere.  T is copied in and out of atomic
+ * slots, so it must be trivially copyable.  A pointer
+ * to the real work is the usual choice.
+ *************************************************/
+template <class T>
+class ws_deque
+{
+   static_assert(std::is_trivially_copyable <T>::value,
+                 "ws_deque holds T in atomic slots");
+   friend class ::TestWsDeque; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   ws_deque(size_t capacity = 64);
+   ws_deque(const ws_deque & rhs) = delete;
+   ws_deque & operator = (const ws_deque & rhs) = delete;
+   ~ws_deque() { delete pArray.load(); }
+
+   //
+   // Owner
+   //
+
+   void push(const T & t);
+   bool pop(T & t);
+
+   //
+   // Thief
+   //
+
+   bool steal(T & t);
+
+   //
+   // Status
+   // Only a snapshot while other threads are at work
+   //
+
+   size_t size() const
+   {
+      int64_t b = bottom.load();
+      int64_t t = top.load();
+      return b > t ? (size_t)(b - t) : 0;
+   }
+   bool   empty()    const { return size() == 0;                 }
+   size_t capacity() const { return pArray.load()->capacity(); }
+
+private:
+
+   /*************************************************
+    * ARRAY
+    * A circular buffer whose size is a power of two
+    * so an index wraps with a mask
+    *************************************************/
+   struct Array
+   {
+      Array(size_t capacity) : mask(capacity - 1), slots(new std::atomic <T> [capacity]) {}
+      ~Array() { delete [] slots; }
+
+      size_t capacity() const            { return mask + 1;                                                }
+      T    get(int64_t i) const          { return slots[(size_t)i & mask].load(std::memory_order_acquire); }
+      void put(int64_t i, const T & t)   { slots[(size_t)i & mask].store(t, std::memory_order_release);    }
+
+      size_t           mask;    // capacity - 1
+      std::atomic <T> * slots;  // the elements
+   };
+
+   Array * grow(Array * pOld, int64_t t, int64_t b);
+
+   alignas(64) std::atomic <int64_t> top;      // where thieves take from
+   alignas(64) std::atomic <int64_t> bottom;   // where the owner pushes and pops
+   std::atomic <Array *>              pArray;   // the current buffer
+};
+
+/*****************************************
+ * WS DEQUE :: CONSTRUCTOR
+ * The capacity is rounded up to a power of two
+ ****************************************/
+template <class T>
+ws_deque <T> :: ws_deque(size_t capacity) : top(0), bottom(0), pArray(nullptr)
+{
+   size_t num = 1;
+   while (num < capacity)
+      num <<= 1;
+   pArray.store(new Array(num));
+}
+
+/*****************************************
+ * WS DEQUE :: GROW
+ * Copy the live range [t, b) into an array twice the
+ * size.  Each element keeps its index, so neither
+ * counter moves.
+ *   OUTPUT : the new array, already published
+ *   COST   : O(n), owner only
+ ****************************************/
+template <class T>
+typename ws_deque <T> :: Array *
+ws_deque <T> :: grow(Array * pOld, int64_t t, int64_t b)
+{
+   Array * pNew = new Array(pOld->capacity() * 2);
+   for (int64_t i = t; i < b; i++)
+      pNew->put(i, pOld->get(i));
+   pArray.store(pNew, std::memory_order_release);
+   ebr::retire(pOld);
+   return pNew;
+}
+
+/*****************************************
+ * WS DEQUE :: PUSH
+ * Add t at the bottom.  Only the owner may call this.
+ *   INPUT  : t - the value to add
+ *   COST   : O(1) amortized, wait-free but for growth
+ ****************************************/
+template <class T>
+void ws_deque <T> :: push(const T & t)
+{
+   int64_t b = bottom.load(std::memory_order_relaxed);
+   int64_t tp = top.load(std::memory_order_acquire);
+   Array * a = pArray.load(std::memory_order_relaxed);
+   if (b - tp >= (int64_t)a->capacity())
+      a = grow(a, tp, b);
+
+   a->put(b, t);
+   bottom.store(b + 1, std::memory_order_release);
+}
+
+/*****************************************
+ * WS DEQUE :: POP
+ * Take the value at the bottom, the one pushed most
+ * recently.  Only the owner may call this.  The bottom
+ * is claimed first; only when that leaves a single
+ * element is there a race with thieves, settled with a
+ * CAS on the top.
+ *   OUTPUT : t - the value taken
+ *            return false if there was nothing to take
+ *   COST   : O(1)
+ ****************************************/
+template <class T>
+bool ws_deque <T> :: pop(T & t)
+{
+   int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+   Array * a = pArray.load(std::memory_order_relaxed);
+   bottom.store(b, std::memory_order_seq_cst);
+   int64_t tp = top.load(std::memory_order_seq_cst);
+
+   // empty: put the bottom back
+   if (tp > b)
+   {
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+   }
+
+   t = a->get(b);
+   if (tp < b)
+      return true;
+
+   // the last one: whoever moves the top first gets it
+   bool won = top.compare_exchange_strong(tp, tp + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed);
+   bottom.store(b + 1, std::memory_order_relaxed);
+   return won;
+}
+
+/*****************************************
+ * WS DEQUE :: STEAL
+ * Take the value at the top, the oldest one.  Any
+ * thread may call this.  The thread stays pinned while
+ * it reads so the array cannot be freed under it.
+ *   OUTPUT : t - the value taken
+ *            return false if there was nothing to take
+ *            or another thread took it first
+ *   COST   : O(1), lock-free
+ ****************************************/
+template <class T>
+bool ws_deque <T> :: steal(T & t)
+{
+   ebr::guard g;
+   int64_t tp = top.load(std::memory_order_seq_cst);
+   int64_t b = bottom.load(std::memory_order_seq_cst);
+   if (tp >= b)
+      return false;
+
+   Array * a = pArray.load(std::memory_order_acquire);
+   T value = a->get(tp);
+   if (!top.compare_exchange_strong(tp, tp + 1,
+                                    std::memory_order_seq_cst,
+                                    std::memory_order_relaxed))
+      return false;
+
+   t = value;
+   return true;
+}
+
+} // namespace custom